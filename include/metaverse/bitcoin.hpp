@@ -130,8 +130,11 @@
 #include <metaverse/bitcoin/utility/reader.hpp>
 #include <metaverse/bitcoin/utility/resource_lock.hpp>
 #include <metaverse/bitcoin/utility/resubscriber.hpp>
+#include <metaverse/bitcoin/utility/scheduler.hpp>
 #include <metaverse/bitcoin/utility/scope_lock.hpp>
 #include <metaverse/bitcoin/utility/serializer.hpp>
+#include <metaverse/bitcoin/utility/span_reader.hpp>
+#include <metaverse/bitcoin/utility/span_writer.hpp>
 #include <metaverse/bitcoin/utility/string.hpp>
 #include <metaverse/bitcoin/utility/subscriber.hpp>
 #include <metaverse/bitcoin/utility/synchronizer.hpp>
@@ -26,6 +26,8 @@
 #include <metaverse/bitcoin/utility/reader.hpp>
 #include <metaverse/bitcoin/utility/writer.hpp>
 #include <metaverse/bitcoin/utility/container_sink.hpp>
+#include <metaverse/bitcoin/utility/span_reader.hpp>
+#include <metaverse/bitcoin/utility/span_writer.hpp>
 
 namespace libbitcoin {
 
@@ -45,6 +47,9 @@ public:
     template<typename... Args>
     static T factory_from_data(reader& source, Args... args);
 
+    template<typename... Args>
+    static T factory_from_data(span_reader& source, Args... args);
+
     template<typename... Args>
     bool from_data(const data_chunk& data, Args... args);
 
@@ -54,11 +59,15 @@ public:
     template<typename... Args>
     bool from_data(reader& source, Args... args);
 
+    template<typename... Args>
+    bool from_data(span_reader& source, Args... args);
+
     data_chunk to_data() const;
 
     template<typename T1_, typename T2_ = typename std::decay<T1_>::type,
     typename std::enable_if< (!std::is_base_of<std::ostream, T2_>::value 
-    && !std::is_base_of<writer, T2_>::value )>::type* = nullptr, typename... Args>
+    && !std::is_base_of<writer, T2_>::value
+    && !std::is_same<span_writer, T2_>::value )>::type* = nullptr, typename... Args>
     data_chunk to_data(T1_&& t , Args... args) const;
 
     template<typename... Args >
@@ -67,6 +76,9 @@ public:
     template<typename... Args>
     void to_data(writer& sink, Args... args) const;
 
+    template<typename... Args>
+    void to_data(span_writer& sink, Args... args) const;
+
 private:
     base_primary(){}
     friend T;
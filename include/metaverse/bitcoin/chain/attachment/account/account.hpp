@@ -78,8 +78,11 @@ public:
     const data_chunk& get_script() const{return script_;};
     void set_script(const data_chunk& script);
 
-    bool from_data(reader& source);
-    void to_data(writer& sink) const;
+    template <typename Reader>
+    bool from_data(Reader& source);
+
+    template <typename Writer>
+    void to_data(Writer& sink) const;
 
     uint64_t serialized_size() const;
     bool operator==(const account_script& other) const;
@@ -126,8 +129,11 @@ public:
 
     std::string get_multisig_script() const;
 
-    bool from_data(reader& source);
-    void to_data(writer& sink) const;
+    template <typename Reader>
+    bool from_data(Reader& source);
+
+    template <typename Writer>
+    void to_data(Writer& sink) const;
 
     uint64_t serialized_size() const;
 
@@ -159,8 +165,10 @@ public:
 
     static uint64_t satoshi_fixed_size();
 
-    bool from_data_t(reader& source);
-    void to_data_t(writer& sink) const;
+    template <typename Reader>
+    bool from_data_t(Reader& source);
+    template <typename Writer>
+    void to_data_t(Writer& sink) const;
 
     bool is_valid() const;
     void reset();
@@ -64,8 +64,10 @@ public:
     asset(uint32_t status, const asset_transfer& detail);
     static uint64_t satoshi_fixed_size();
 
-    bool from_data_t(reader& source);
-    void to_data_t(writer& sink) const;
+    template <typename Reader>
+    bool from_data_t(Reader& source);
+    template <typename Writer>
+    void to_data_t(Writer& sink) const;
     std::string to_string() const;
     bool is_valid_type() const;
     bool is_valid() const;
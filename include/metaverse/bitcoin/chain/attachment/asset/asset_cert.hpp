@@ -156,8 +156,10 @@ public:
     bool is_valid() const;
     bool operator< (const asset_cert& other) const;
 
-    bool from_data_t(reader& source);
-    void to_data_t(writer& sink) const;
+    template <typename Reader>
+    bool from_data_t(Reader& source);
+    template <typename Writer>
+    void to_data_t(Writer& sink) const;
 
     std::string to_string() const;
     uint64_t serialized_size() const;
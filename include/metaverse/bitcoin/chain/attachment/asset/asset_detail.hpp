@@ -64,8 +64,10 @@ public:
         const std::string& address, const std::string& description);
 
     static uint64_t satoshi_fixed_size();
-    bool from_data_t(reader& source);
-    void to_data_t(writer& sink) const;
+    template <typename Reader>
+    bool from_data_t(Reader& source);
+    template <typename Writer>
+    void to_data_t(Writer& sink) const;
 
     bool operator< (const asset_detail& other) const;
     std::string to_string() const;
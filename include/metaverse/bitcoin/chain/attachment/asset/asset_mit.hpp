@@ -82,8 +82,10 @@ public:
     bool is_valid() const;
     bool operator< (const asset_mit& other) const;
 
-    bool from_data_t(reader& source);
-    void to_data_t(writer& sink) const;
+    template <typename Reader>
+    bool from_data_t(Reader& source);
+    template <typename Writer>
+    void to_data_t(Writer& sink) const;
     data_chunk to_short_data() const;
 
     std::string to_string() const;
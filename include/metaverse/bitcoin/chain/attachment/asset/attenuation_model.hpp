@@ -21,6 +21,7 @@
 #define MVS_CHAIN_ATTACHMENT_ASSET_ATTENUATION_MODEL_HPP
 
 #include <cstdint>
+#include <memory>
 #include <metaverse/bitcoin/chain/point.hpp>
 #include <metaverse/bitcoin/chain/script/script.hpp>
 #include <metaverse/bitcoin/define.hpp>
@@ -97,7 +98,12 @@ public:
     static std::string get_key_of_name(const std::string& name);
 private:
     class impl;
-    std::unique_ptr<impl> pimpl;
+
+    // Models with the same param share one parsed, immutable impl.
+    static std::shared_ptr<const impl> compile(const std::string& param,
+        bool is_init);
+
+    std::shared_ptr<const impl> pimpl;
 };
 
 } // namespace chain
@@ -50,8 +50,10 @@ public:
             uint64_t height, uint32_t status, const did_detail& did);
     static uint64_t satoshi_fixed_size();
 
-    bool from_data_t(reader& source);
-    void to_data_t(writer& sink) const;
+    template <typename Reader>
+    bool from_data_t(Reader& source);
+    template <typename Writer>
+    void to_data_t(Writer& sink) const;
 
 #ifdef MVS_DEBUG
     std::string to_string() const;
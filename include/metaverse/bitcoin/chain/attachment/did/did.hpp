@@ -61,8 +61,10 @@ public:
     did(uint32_t status, const did_detail& detail);
     static uint64_t satoshi_fixed_size();
 
-    bool from_data_t(reader& source);
-    void to_data_t(writer& sink) const;
+    template <typename Reader>
+    bool from_data_t(Reader& source);
+    template <typename Writer>
+    void to_data_t(Writer& sink) const;
     std::string to_string() const;
     bool is_valid_type() const;
     bool is_valid() const;
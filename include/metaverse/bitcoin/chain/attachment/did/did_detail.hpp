@@ -57,8 +57,10 @@ public:
 
     static uint64_t satoshi_fixed_size();
     static std::string get_blackhole_did_symbol();
-    bool from_data_t(reader& source);
-    void to_data_t(writer& sink) const;
+    template <typename Reader>
+    bool from_data_t(Reader& source);
+    template <typename Writer>
+    void to_data_t(Writer& sink) const;
 
     bool operator< (const did_detail& other) const;
     std::string to_string() const;
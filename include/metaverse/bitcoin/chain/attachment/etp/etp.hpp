@@ -42,8 +42,10 @@ public:
     etp(uint64_t value);
     static uint64_t satoshi_fixed_size();
 
-    bool from_data_t(reader& source);
-    void to_data_t(writer& sink) const;
+    template <typename Reader>
+    bool from_data_t(Reader& source);
+    template <typename Writer>
+    void to_data_t(Writer& sink) const;
     std::string to_string() const;
     bool is_valid() const;
     void reset();
@@ -27,10 +27,11 @@
 namespace libbitcoin {
 namespace chain {
 
+template <typename Reader>
 class from_data_visitor : public boost::static_visitor<bool>
 {
 public:
-    from_data_visitor(reader& src): source(src)
+    from_data_visitor(Reader& src): source(src)
     {
 
     }
@@ -41,13 +42,14 @@ public:
       return t.from_data(source);
     }
 
-    reader& source;
+    Reader& source;
 };
 
+template <typename Writer>
 class to_data_visitor : public boost::static_visitor<void>
 {
 public:
-    to_data_visitor(writer& dst): sink(dst)
+    to_data_visitor(Writer& dst): sink(dst)
     {
 
     }
@@ -58,7 +60,7 @@ public:
       return t.to_data(sink);
     }
 
-    writer& sink;
+    Writer& sink;
 };
 
 class serialized_size_visitor : public boost::static_visitor<uint64_t>
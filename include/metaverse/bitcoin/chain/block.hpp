@@ -68,8 +68,10 @@ public:
     block& operator=(block&& other);
     void operator=(const block&) = delete;
 
-    bool from_data_t(reader& source, bool with_transaction_count = true);
-    void to_data_t(writer& sink, bool with_transaction_count = true) const;
+    template <typename Reader>
+    bool from_data_t(Reader& source, bool with_transaction_count = true);
+    template <typename Writer>
+    void to_data_t(Writer& sink, bool with_transaction_count = true) const;
     bool is_valid() const;
     void reset();
     uint64_t serialized_size(bool with_transaction_count = true) const;
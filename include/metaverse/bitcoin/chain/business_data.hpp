@@ -87,8 +87,10 @@ public:
 
     static uint64_t satoshi_fixed_size();
 
-    bool from_data_t(reader& source);
-    void to_data_t(writer& sink);
+    template <typename Reader>
+    bool from_data_t(Reader& source);
+    template <typename Writer>
+    void to_data_t(Writer& sink);
 #if MVS_DEBUG
     std::string to_string() ;
 #endif
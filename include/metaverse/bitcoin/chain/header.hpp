@@ -85,8 +85,10 @@ public:
     // TODO: eliminate blockchain transaction copies and then delete this.
     header& operator=(const header& other) /*= delete*/;
 
-    bool from_data_t(reader& source, bool with_transaction_count = true);
-    void to_data_t(writer& sink, bool with_transaction_count = true) const;
+    template <typename Reader>
+    bool from_data_t(Reader& source, bool with_transaction_count = true);
+    template <typename Writer>
+    void to_data_t(Writer& sink, bool with_transaction_count = true) const;
     hash_digest hash() const;
     bool is_valid() const;
     void reset();
@@ -60,8 +60,10 @@ public:
 
     static uint64_t satoshi_fixed_size();
 
-    bool from_data_t(reader& source);
-    void to_data_t(writer& sink) const;
+    template <typename Reader>
+    bool from_data_t(Reader& source);
+    template <typename Writer>
+    void to_data_t(Writer& sink) const;
     std::string to_string(uint32_t flags) const;
     bool is_valid() const;
     bool is_null() const;
@@ -72,8 +72,10 @@ public:
 
     bool is_null() const;
 
-    bool from_data_t(reader& source);
-    void to_data_t(writer& sink) const;
+    template <typename Reader>
+    bool from_data_t(Reader& source);
+    template <typename Writer>
+    void to_data_t(Writer& sink) const;
 
     std::string to_string() const;
     bool is_valid() const;
@@ -30,6 +30,8 @@
 #include <metaverse/bitcoin/utility/data.hpp>
 #include <metaverse/bitcoin/utility/reader.hpp>
 #include <metaverse/bitcoin/utility/writer.hpp>
+#include <metaverse/bitcoin/utility/span_reader.hpp>
+#include <metaverse/bitcoin/utility/span_writer.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -115,6 +117,7 @@ public:
     static operation factory_from_data(const data_chunk& data);
     static operation factory_from_data(std::istream& stream);
     static operation factory_from_data(reader& source);
+    static operation factory_from_data(span_reader& source);
 
     static bool is_push_only(const operation::stack& operations);
 
@@ -164,9 +167,11 @@ public:
     bool from_data(const data_chunk& data);
     bool from_data(std::istream& stream);
     bool from_data(reader& source);
+    bool from_data(span_reader& source);
     data_chunk to_data() const;
     void to_data(std::ostream& stream) const;
     void to_data(writer& sink) const;
+    void to_data(span_writer& sink) const;
     std::string to_string(uint32_t flags) const;
     bool is_valid() const;
     void reset();
@@ -183,8 +188,16 @@ private:
     static bool is_push(const opcode code);
     static uint64_t count_non_push(const operation::stack& operations);
     static bool must_read_data(opcode code);
+
+    template <typename Reader>
     static bool read_opcode_data_size(uint32_t& count, opcode code,
-        uint8_t byte, reader& source);
+        uint8_t byte, Reader& source);
+
+    template <typename Reader>
+    bool from_data_t(Reader& source);
+
+    template <typename Writer>
+    void to_data_t(Writer& sink) const;
 };
 
 } // end chain
@@ -31,6 +31,8 @@
 #include <metaverse/bitcoin/utility/data.hpp>
 #include <metaverse/bitcoin/utility/reader.hpp>
 #include <metaverse/bitcoin/utility/writer.hpp>
+#include <metaverse/bitcoin/utility/span_reader.hpp>
+#include <metaverse/bitcoin/utility/span_writer.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -102,6 +104,8 @@ public:
         parse_mode mode);
     static script factory_from_data(reader& source, bool prefix,
         parse_mode mode);
+    static script factory_from_data(span_reader& source, bool prefix,
+        parse_mode mode);
 
     static bool verify(const script& input_script,
         const script& output_script, const transaction& parent_tx,
@@ -126,9 +130,11 @@ public:
     bool from_data(const data_chunk& data, bool prefix, parse_mode mode);
     bool from_data(std::istream& stream, bool prefix, parse_mode mode);
     bool from_data(reader& source, bool prefix, parse_mode mode);
+    bool from_data(span_reader& source, bool prefix, parse_mode mode);
     data_chunk to_data(bool prefix) const;
     void to_data(std::ostream& stream, bool prefix) const;
     void to_data(writer& sink, bool prefix) const;
+    void to_data(span_writer& sink, bool prefix) const;
 
     bool from_string(const std::string& human_readable);
     std::string to_string(uint32_t flags) const;
@@ -142,6 +148,12 @@ public:
 private:
     bool deserialize(const data_chunk& raw_script, parse_mode mode);
     bool parse(const data_chunk& raw_script);
+
+    template <typename Reader>
+    bool from_data_t(Reader& source, bool prefix, parse_mode mode);
+
+    template <typename Writer>
+    void to_data_t(Writer& sink, bool prefix) const;
 };
 
 } // namespace chain
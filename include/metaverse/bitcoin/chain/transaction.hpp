@@ -72,8 +72,10 @@ public:
     // TODO: eliminate blockchain transaction copies and then delete this.
     transaction& operator=(const transaction& other) /*= delete*/;
 
-    bool from_data_t(reader& source);
-    void to_data_t(writer& sink) const;
+    template <typename Reader>
+    bool from_data_t(Reader& source);
+    template <typename Writer>
+    void to_data_t(Writer& sink) const;
     std::string to_string(uint32_t flags) const;
     bool is_valid() const;
     void reset();
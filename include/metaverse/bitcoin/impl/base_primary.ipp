@@ -64,11 +64,19 @@ T base_primary<T>::factory_from_data(reader& source, Args... args){
     return instance;
 }
 
+template<class T>
+template<typename... Args>
+T base_primary<T>::factory_from_data(span_reader& source, Args... args){
+    T instance;
+    instance.from_data(source, std::forward<Args>(args)...);
+    return instance;
+}
+
 template<class T>
 template<typename... Args>
 bool base_primary<T>::from_data(const data_chunk& data, Args... args){
-    data_source istream(data);
-    return from_data(istream, std::forward<Args>(args)...);
+    span_reader source(data);
+    return from_data(source, std::forward<Args>(args)...);
 }
 
 template<class T>
@@ -84,9 +92,23 @@ bool base_primary<T>::from_data(reader& source, Args... args){
     return Instance().from_data_t(source, std::forward<Args>(args)...);
 }
 
+template<class T>
+template<typename... Args>
+bool base_primary<T>::from_data(span_reader& source, Args... args){
+    return Instance().from_data_t(source, std::forward<Args>(args)...);
+}
+
+// Serialize in place when the size is known, streaming only if it is not.
 template<class T>
 data_chunk base_primary<T>::to_data() const{
-    data_chunk data;
+    data_chunk data(Instance().serialized_size());
+    span_writer sink(data);
+    to_data(sink);
+
+    if (sink && sink.size() == data.size())
+        return data;
+
+    data.clear();
     data_sink ostream(data);
     to_data(ostream);
     ostream.flush();
@@ -96,7 +118,8 @@ data_chunk base_primary<T>::to_data() const{
 template<class T>
 template<typename T1_, typename T2_,
 typename std::enable_if< (!std::is_base_of<std::ostream, T2_>::value 
-&& !std::is_base_of<writer, T2_>::value )>::type*, typename... Args>
+&& !std::is_base_of<writer, T2_>::value
+&& !std::is_same<span_writer, T2_>::value )>::type*, typename... Args>
 data_chunk base_primary<T>::to_data(T1_&& t, Args... args) const{
     data_chunk data;
     data_sink ostream(data);
@@ -119,6 +142,12 @@ void base_primary<T>::to_data(writer& sink, Args... args) const{
     Instance().to_data_t(sink, std::forward<Args>(args)...);
 }
 
+template<class T>
+template< typename... Args>
+void base_primary<T>::to_data(span_writer& sink, Args... args) const{
+    Instance().to_data_t(sink, std::forward<Args>(args)...);
+}
+
 } // namespace libbitcoin
 
 #endif
@@ -23,10 +23,14 @@
 
 #include <functional>
 #include <memory>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <utility>
+#include <vector>
 #include <metaverse/bitcoin/utility/assert.hpp>
 #include <metaverse/bitcoin/utility/dispatcher.hpp>
+#include <metaverse/bitcoin/utility/scheduler.hpp>
 #include <metaverse/bitcoin/utility/thread.hpp>
 #include <metaverse/bitcoin/utility/threadpool.hpp>
 ////#include <metaverse/bitcoin/utility/track.hpp>
@@ -36,7 +40,15 @@ namespace libbitcoin {
 template <typename... Args>
 resubscriber<Args...>::resubscriber(threadpool& pool,
     const std::string& class_name)
-  : stopped_(true), dispatch_(pool, class_name)
+  : stopped_(true), dispatch_(pool, class_name), fanout_(nullptr)
+    /*, track<resubscriber<Args...>>(class_name)*/
+{
+}
+
+template <typename... Args>
+resubscriber<Args...>::resubscriber(threadpool& pool, scheduler& fanout,
+    const std::string& class_name)
+  : stopped_(true), dispatch_(pool, class_name), fanout_(&fanout)
     /*, track<resubscriber<Args...>>(class_name)*/
 {
 }
@@ -130,7 +142,7 @@ void resubscriber<Args...>::relay(Args... args)
 template <typename... Args>
 void resubscriber<Args...>::do_invoke(Args... args)
 {
-    // Critical Section (prevent concurrent handler execution)
+    // Critical Section (prevent concurrent notifications)
     ///////////////////////////////////////////////////////////////////////////
     unique_lock lock(invoke_mutex_);
 
@@ -147,30 +159,54 @@ void resubscriber<Args...>::do_invoke(Args... args)
 
     // Subscriptions may be created while this loop is executing.
     // Invoke subscribers from temporary list and resubscribe as indicated.
-    for (const auto& handler: subscriptions)
+    if (fanout_ == nullptr || subscriptions.size() < 2)
     {
-        if (handler(args...))
+        for (const auto& handler: subscriptions)
+            if (handler(args...))
+                renew(handler);
+
+        return;
+    }
+
+    // Handlers are independent, only notifications must remain ordered, so
+    // fan out and hold the invoke lock until every handler has returned.
+    std::vector<uint8_t> renewals(subscriptions.size(), 0);
+    task_group group(*fanout_);
+
+    for (size_t index = 0; index < subscriptions.size(); ++index)
+        group.run([&, index]()
         {
-            // Critical Section
-            ///////////////////////////////////////////////////////////////////
-            subscribe_mutex_.lock_upgrade();
-
-            if (stopped_)
-            {
-                subscribe_mutex_.unlock_upgrade();
-                //-------------------------------------------------------------
-                continue;
-            }
-
-            subscribe_mutex_.unlock_upgrade_and_lock();
-            //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-            subscriptions_.emplace_back(handler);
-
-            subscribe_mutex_.unlock();
-            ///////////////////////////////////////////////////////////////////
-        }
+            renewals[index] = subscriptions[index](args...) ? 1 : 0;
+        });
+
+    group.wait();
+
+    for (size_t index = 0; index < subscriptions.size(); ++index)
+        if (renewals[index] != 0)
+            renew(subscriptions[index]);
+
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+template <typename... Args>
+void resubscriber<Args...>::renew(const handler& handler)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    subscribe_mutex_.lock_upgrade();
+
+    if (stopped_)
+    {
+        subscribe_mutex_.unlock_upgrade();
+        //---------------------------------------------------------------------
+        return;
     }
 
+    subscribe_mutex_.unlock_upgrade_and_lock();
+    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+    subscriptions_.emplace_back(handler);
+
+    subscribe_mutex_.unlock();
     ///////////////////////////////////////////////////////////////////////////
 }
 
@@ -0,0 +1,259 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MVS_SPAN_READER_IPP
+#define MVS_SPAN_READER_IPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <metaverse/bitcoin/constants.hpp>
+#include <metaverse/bitcoin/utility/assert.hpp>
+#include <metaverse/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+
+inline span_reader::span_reader(data_slice data)
+  : span_reader(data.begin(), data.end())
+{
+}
+
+inline span_reader::span_reader(const uint8_t* begin, const uint8_t* end)
+  : position_(begin), end_(end), valid_(true)
+{
+    BITCOIN_ASSERT(begin <= end);
+}
+
+inline span_reader::operator bool() const
+{
+    return valid_;
+}
+
+inline bool span_reader::operator!() const
+{
+    return !valid_;
+}
+
+inline bool span_reader::is_exhausted() const
+{
+    return valid_ && position_ == end_;
+}
+
+inline size_t span_reader::remaining() const
+{
+    return static_cast<size_t>(end_ - position_);
+}
+
+inline bool span_reader::require(size_t size)
+{
+    if (valid_ && size <= remaining())
+        return true;
+
+    // Consume the remainder so that all subsequent reads also fail.
+    valid_ = false;
+    position_ = end_;
+    return false;
+}
+
+inline uint8_t span_reader::read_byte()
+{
+    return require(1) ? *position_++ : 0;
+}
+
+inline data_chunk span_reader::read_data(size_t size)
+{
+    // Never allocate more than remains, size may be peer-provided.
+    const auto available = std::min(size, remaining());
+    data_chunk out(position_, position_ + available);
+    position_ += available;
+
+    if (available != size)
+        require(size);
+
+    return out;
+}
+
+inline size_t span_reader::read_data(uint8_t* data, size_t size)
+{
+    const auto available = std::min(size, remaining());
+    std::copy_n(position_, available, data);
+    position_ += available;
+
+    if (available != size)
+        require(size);
+
+    return available;
+}
+
+inline data_chunk span_reader::read_data_to_eof()
+{
+    data_chunk out(position_, end_);
+    position_ = end_;
+    return out;
+}
+
+inline hash_digest span_reader::read_hash()
+{
+    return read_bytes<hash_size>();
+}
+
+inline short_hash span_reader::read_short_hash()
+{
+    return read_bytes<short_hash_size>();
+}
+
+inline mini_hash span_reader::read_mini_hash()
+{
+    return read_bytes<mini_hash_size>();
+}
+
+inline uint16_t span_reader::read_2_bytes_little_endian()
+{
+    return read_little_endian<uint16_t>();
+}
+
+inline uint32_t span_reader::read_4_bytes_little_endian()
+{
+    return read_little_endian<uint32_t>();
+}
+
+inline uint64_t span_reader::read_8_bytes_little_endian()
+{
+    return read_little_endian<uint64_t>();
+}
+
+inline uint64_t span_reader::read_variable_uint_little_endian()
+{
+    const auto length = read_byte();
+    if (length < 0xfd)
+        return length;
+    else if (length == 0xfd)
+        return read_2_bytes_little_endian();
+    else if (length == 0xfe)
+        return read_4_bytes_little_endian();
+
+    // length should be 0xff
+    return read_8_bytes_little_endian();
+}
+
+inline uint16_t span_reader::read_2_bytes_big_endian()
+{
+    return read_big_endian<uint16_t>();
+}
+
+inline uint32_t span_reader::read_4_bytes_big_endian()
+{
+    return read_big_endian<uint32_t>();
+}
+
+inline uint64_t span_reader::read_8_bytes_big_endian()
+{
+    return read_big_endian<uint64_t>();
+}
+
+inline uint64_t span_reader::read_variable_uint_big_endian()
+{
+    const auto length = read_byte();
+    if (length < 0xfd)
+        return length;
+    else if (length == 0xfd)
+        return read_2_bytes_big_endian();
+    else if (length == 0xfe)
+        return read_4_bytes_big_endian();
+
+    // length should be 0xff
+    return read_8_bytes_big_endian();
+}
+
+inline std::string span_reader::read_fixed_string(size_t length)
+{
+    const auto available = std::min(length, remaining());
+    const auto begin = reinterpret_cast<const char*>(position_);
+    position_ += available;
+
+    if (available != length)
+        require(length);
+
+    // Removes trailing 0s... Needed for string comparisons
+    return std::string(begin, std::find(begin, begin + available, '\0'));
+}
+
+inline std::string span_reader::read_string()
+{
+    const auto size = read_variable_uint_little_endian();
+    BITCOIN_ASSERT(size <= bc::max_size_t);
+    const auto read_size = static_cast<size_t>(size);
+    return read_fixed_string(read_size);
+}
+
+template <typename T>
+T span_reader::read_big_endian()
+{
+    if (!require(sizeof(T)))
+        return 0;
+
+    const auto value = from_big_endian_unsafe<T>(position_);
+    position_ += sizeof(T);
+    return value;
+}
+
+template <typename T>
+T span_reader::read_little_endian()
+{
+    if (!require(sizeof(T)))
+        return 0;
+
+    const auto value = from_little_endian_unsafe<T>(position_);
+    position_ += sizeof(T);
+    return value;
+}
+
+template <unsigned Size>
+byte_array<Size> span_reader::read_bytes()
+{
+    byte_array<Size> out{ {} };
+
+    if (require(Size))
+    {
+        std::copy_n(position_, Size, out.begin());
+        position_ += Size;
+    }
+
+    return out;
+}
+
+template <unsigned Size>
+byte_array<Size> span_reader::read_bytes_reverse()
+{
+    byte_array<Size> out{ {} };
+
+    if (require(Size))
+    {
+        std::reverse_copy(position_, position_ + Size, out.begin());
+        position_ += Size;
+    }
+
+    return out;
+}
+
+} // namespace libbitcoin
+
+#endif
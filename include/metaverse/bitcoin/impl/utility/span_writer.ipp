@@ -0,0 +1,226 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MVS_SPAN_WRITER_IPP
+#define MVS_SPAN_WRITER_IPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <metaverse/bitcoin/utility/assert.hpp>
+#include <metaverse/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+
+inline span_writer::span_writer(data_chunk& data)
+  : span_writer(data.data(), data.data() + data.size())
+{
+}
+
+inline span_writer::span_writer(uint8_t* begin, uint8_t* end)
+  : begin_(begin), position_(begin), end_(end), valid_(true)
+{
+    BITCOIN_ASSERT(begin <= end);
+}
+
+inline span_writer::operator bool() const
+{
+    return valid_;
+}
+
+inline bool span_writer::operator!() const
+{
+    return !valid_;
+}
+
+inline size_t span_writer::size() const
+{
+    return static_cast<size_t>(position_ - begin_);
+}
+
+inline size_t span_writer::remaining() const
+{
+    return static_cast<size_t>(end_ - position_);
+}
+
+inline bool span_writer::require(size_t size)
+{
+    if (valid_ && size <= remaining())
+        return true;
+
+    valid_ = false;
+    return false;
+}
+
+inline void span_writer::write_byte(uint8_t value)
+{
+    if (require(1))
+        *position_++ = value;
+}
+
+inline void span_writer::write_data(const data_chunk& data)
+{
+    write_data(data.data(), data.size());
+}
+
+inline void span_writer::write_data(const uint8_t* data, size_t size)
+{
+    if (size > 0 && require(size))
+        position_ = std::copy_n(data, size, position_);
+}
+
+inline void span_writer::write_hash(const hash_digest& value)
+{
+    write_bytes<hash_size>(value);
+}
+
+inline void span_writer::write_short_hash(const short_hash& value)
+{
+    write_bytes<short_hash_size>(value);
+}
+
+inline void span_writer::write_mini_hash(const mini_hash& value)
+{
+    write_bytes<mini_hash_size>(value);
+}
+
+inline void span_writer::write_2_bytes_little_endian(uint16_t value)
+{
+    write_little_endian<uint16_t>(value);
+}
+
+inline void span_writer::write_4_bytes_little_endian(uint32_t value)
+{
+    write_little_endian<uint32_t>(value);
+}
+
+inline void span_writer::write_8_bytes_little_endian(uint64_t value)
+{
+    write_little_endian<uint64_t>(value);
+}
+
+inline void span_writer::write_variable_uint_little_endian(uint64_t value)
+{
+    if (value < 0xfd)
+    {
+        write_byte((uint8_t)value);
+    }
+    else if (value <= 0xffff)
+    {
+        write_byte(0xfd);
+        write_2_bytes_little_endian((uint16_t)value);
+    }
+    else if (value <= 0xffffffff)
+    {
+        write_byte(0xfe);
+        write_4_bytes_little_endian((uint32_t)value);
+    }
+    else
+    {
+        write_byte(0xff);
+        write_8_bytes_little_endian(value);
+    }
+}
+
+inline void span_writer::write_2_bytes_big_endian(uint16_t value)
+{
+    write_big_endian<uint16_t>(value);
+}
+
+inline void span_writer::write_4_bytes_big_endian(uint32_t value)
+{
+    write_big_endian<uint32_t>(value);
+}
+
+inline void span_writer::write_8_bytes_big_endian(uint64_t value)
+{
+    write_big_endian<uint64_t>(value);
+}
+
+inline void span_writer::write_variable_uint_big_endian(uint64_t value)
+{
+    if (value < 0xfd)
+    {
+        write_byte((uint8_t)value);
+    }
+    else if (value <= 0xffff)
+    {
+        write_byte(0xfd);
+        write_2_bytes_big_endian((uint16_t)value);
+    }
+    else if (value <= 0xffffffff)
+    {
+        write_byte(0xfe);
+        write_4_bytes_big_endian((uint32_t)value);
+    }
+    else
+    {
+        write_byte(0xff);
+        write_8_bytes_big_endian(value);
+    }
+}
+
+inline void span_writer::write_fixed_string(const std::string& value,
+    size_t size)
+{
+    if (!require(size))
+        return;
+
+    const auto min_size = std::min(size, value.size());
+    position_ = std::copy_n(value.begin(), min_size, position_);
+    position_ = std::fill_n(position_, size - min_size, 0);
+}
+
+inline void span_writer::write_string(const std::string& value)
+{
+    write_variable_uint_little_endian(value.size());
+    write_data(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+}
+
+template <typename T>
+void span_writer::write_big_endian(T value)
+{
+    write_bytes<sizeof(T)>(to_big_endian(value));
+}
+
+template <typename T>
+void span_writer::write_little_endian(T value)
+{
+    write_bytes<sizeof(T)>(to_little_endian(value));
+}
+
+template <unsigned Size>
+void span_writer::write_bytes(const byte_array<Size>& value)
+{
+    if (require(Size))
+        position_ = std::copy_n(value.begin(), Size, position_);
+}
+
+template <unsigned Size>
+void span_writer::write_bytes_reverse(const byte_array<Size>& value)
+{
+    if (require(Size))
+        position_ = std::reverse_copy(value.begin(), value.end(), position_);
+}
+
+} // namespace libbitcoin
+
+#endif
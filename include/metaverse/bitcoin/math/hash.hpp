@@ -190,6 +190,14 @@ BC_API hash_digest bitcoin_hash(data_slice data);
  */
 BC_API short_hash bitcoin_short_hash(data_slice data);
 
+/**
+ * Generate a siphash-2-4 hash keyed by a 128 bit key. This hash function is
+ * used for the short transaction ids of compact blocks (bip152).
+ *
+ * siphash-2-4(key, data)
+ */
+BC_API uint64_t siphash(const half_hash& key, data_slice data);
+
 /**
  * Generate a scrypt hash of specified length.
  *
@@ -23,7 +23,10 @@
 
 #include <istream>
 #include <metaverse/bitcoin/define.hpp>
+#include <metaverse/bitcoin/chain/block.hpp>
 #include <metaverse/bitcoin/chain/header.hpp>
+#include <metaverse/bitcoin/math/elliptic_curve.hpp>
+#include <metaverse/bitcoin/math/hash.hpp>
 #include <metaverse/bitcoin/message/prefilled_transaction.hpp>
 #include <metaverse/bitcoin/utility/data.hpp>
 #include <metaverse/bitcoin/utility/reader.hpp>
@@ -46,6 +49,15 @@ public:
     static compact_block factory_from_data(uint32_t version,
         reader& source);
 
+    /// Build a compact block from a full block, prefilling the coinbase and,
+    /// for pos blocks, the coinstake transaction.
+    static compact_block factory_from_block(const chain::block& block,
+        uint64_t nonce);
+
+    /// The short id of a transaction hash under the given siphash key.
+    static short_id to_short_id(const half_hash& key,
+        const hash_digest& tx_hash);
+
     bool from_data(uint32_t version, const data_chunk& data);
     bool from_data(uint32_t version, std::istream& stream);
     bool from_data(uint32_t version, reader& source);
@@ -56,6 +68,12 @@ public:
     void reset();
     uint64_t serialized_size(uint32_t version) const;
 
+    /// The siphash key derived from the header and nonce of this block.
+    half_hash short_id_key() const;
+
+    /// The total number of transactions in the block.
+    size_t transaction_count() const;
+
     static const std::string command;
     static const uint32_t version_minimum;
     static const uint32_t version_maximum;
@@ -64,6 +82,9 @@ public:
     uint64_t nonce;
     short_id_list short_ids;
     prefilled_transaction::list transactions;
+
+    ec_signature blocksig; // pos/dpos block only
+    ec_compressed public_key; // dpos block only
 };
 
 } // namespace message
@@ -61,6 +61,7 @@ public:
     void to_hashes(hash_list& out) const;
     void to_inventory(inventory_vector::list& out,
         inventory::type_id type) const;
+    bool is_sequential() const;
     bool is_valid() const;
     void reset();
     uint64_t serialized_size(uint32_t version) const;
@@ -77,6 +77,8 @@ public:
     static heading factory_from_data(const data_chunk& data);
     static heading factory_from_data(std::istream& stream);
     static heading factory_from_data(reader& source);
+    static message_type to_type(const std::string& command);
+    static std::string to_command(message_type type);
 
     bool from_data(const data_chunk& data);
     bool from_data(std::istream& stream);
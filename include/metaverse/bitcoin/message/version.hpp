@@ -42,7 +42,8 @@ public:
 
     enum level: uint32_t
     {
-        // This is currently unspecified.
+        // compact_block, send_compact_blocks, get_block_transactions,
+        // block_transactions
         bip152 = 70014,
 
         // fee_filter
@@ -70,7 +71,7 @@ public:
         minimum = 31402,
 
         // We support at most this internally (bound to settings default).
-        maximum = bip130
+        maximum = bip152
     };
 
     static version factory_from_data(uint32_t version, const data_chunk& data);
@@ -102,24 +102,31 @@ namespace libbitcoin {
 namespace message {
 
 /**
-* Serialize a message object to the Bitcoin wire protocol encoding.
+* Serialize the heading of a message with the given serialized payload.
 */
 template <typename Message>
-data_chunk serialize(uint32_t version, const Message& packet,
-    uint32_t magic)
+data_chunk serialize_heading(const data_chunk& payload, uint32_t magic)
 {
-    // Serialize the payload (required for header size).
-    const auto payload = packet.to_data(version);
-
-    // Construct the payload header.
     heading head;
     head.magic = magic;
     head.command = Message::command;
     head.payload_size = static_cast<uint32_t>(payload.size());
     head.checksum = bitcoin_checksum(payload);
+    return head.to_data();
+}
+
+/**
+* Serialize a message object to the Bitcoin wire protocol encoding.
+*/
+template <typename Message>
+data_chunk serialize(uint32_t version, const Message& packet,
+    uint32_t magic)
+{
+    // Serialize the payload (required for header size).
+    const auto payload = packet.to_data(version);
 
     // Serialize header and copy the payload into a single message buffer.
-    auto message = head.to_data();
+    auto message = serialize_heading<Message>(payload, magic);
     extend_data(message, payload);
     return message;
 }
@@ -35,6 +35,9 @@ template <typename T>
 class array_slice
 {
 public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
     template <typename Container>
     array_slice(const Container& container);
 
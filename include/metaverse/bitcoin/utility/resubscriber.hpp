@@ -28,6 +28,7 @@
 #include <metaverse/bitcoin/utility/assert.hpp>
 #include <metaverse/bitcoin/utility/dispatcher.hpp>
 #include <metaverse/bitcoin/utility/enable_shared_from_base.hpp>
+#include <metaverse/bitcoin/utility/scheduler.hpp>
 #include <metaverse/bitcoin/utility/thread.hpp>
 #include <metaverse/bitcoin/utility/threadpool.hpp>
 ////#include <metaverse/bitcoin/utility/track.hpp>
@@ -45,6 +46,12 @@ public:
 
     /// Construct an instance. The class_name is for debugging.
     resubscriber(threadpool& pool, const std::string& class_name);
+
+    /// Construct an instance that runs the handlers of each notification in
+    /// parallel on the scheduler. Notifications remain ordered.
+    resubscriber(threadpool& pool, scheduler& fanout,
+        const std::string& class_name);
+
     ~resubscriber();
 
     /// Enable new subscriptions.
@@ -57,20 +64,22 @@ public:
     /// Return true from the handler to resubscribe to notifications.
     void subscribe(handler handler, Args... stopped_args);
 
-    /// Invoke all handlers sequentially (blocking).
+    /// Invoke all handlers sequentially or fanned out (blocking).
     void invoke(Args... args);
 
-    /// Invoke all handlers sequentially (non-blocking).
+    /// Invoke all handlers sequentially or fanned out (non-blocking).
     void relay(Args... args);
 
 private:
     typedef std::vector<handler> list;
 
     void do_invoke(Args... args);
+    void renew(const handler& handler);
 
     bool stopped_;
     list subscriptions_;
     dispatcher dispatch_;
+    scheduler* fanout_;
     mutable upgrade_mutex invoke_mutex_;
     mutable upgrade_mutex subscribe_mutex_;
 };
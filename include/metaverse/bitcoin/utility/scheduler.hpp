@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MVS_SCHEDULER_HPP
+#define MVS_SCHEDULER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <metaverse/bitcoin/define.hpp>
+#include <metaverse/bitcoin/utility/asio.hpp>
+#include <metaverse/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+
+/// This class is thread safe.
+/// Work-stealing executor for independent tasks. Each thread owns a queue,
+/// runs its own most recent task first and steals the oldest task of another
+/// thread when its queue is empty. Tasks carry no ordering guarantee.
+class BC_API scheduler
+{
+public:
+    typedef std::function<void()> task;
+
+    /// Start the threads, zero threads uses one per hardware thread.
+    scheduler(size_t number_threads=0,
+        thread_priority priority=thread_priority::normal);
+
+    /// Run queued tasks and join the threads.
+    ~scheduler();
+
+    /// This class is not copyable.
+    scheduler(const scheduler&) = delete;
+    void operator=(const scheduler&) = delete;
+
+    /// Queue a task, returns false (without running it) once stopped.
+    bool post(task job);
+
+    /// Run one queued task on the calling thread, false if none was queued.
+    bool run_one();
+
+    /// Refuse new tasks, run those already queued and join the threads.
+    /// Call from a thread that is not owned by this scheduler.
+    void stop();
+
+    /// The number of threads.
+    size_t size() const;
+
+    /// The number of queued tasks.
+    size_t backlog() const;
+
+private:
+    struct queue
+    {
+        std::deque<task> tasks;
+        unique_mutex mutex;
+    };
+
+    typedef std::unique_ptr<queue> queue_ptr;
+
+    void run(size_t index, thread_priority priority);
+    bool pop(size_t index, task& out);
+    bool steal(size_t index, task& out);
+    void wake();
+
+    std::vector<queue_ptr> queues_;
+    std::vector<asio::thread> threads_;
+    std::atomic<size_t> pending_;
+    std::atomic<size_t> sleeping_;
+    std::atomic<size_t> next_;
+    std::atomic<bool> stopped_;
+
+    // Posting is shared, stopping is exclusive.
+    shared_mutex stop_mutex_;
+
+    // Idle threads wait on wake_ under sleep_mutex_.
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+};
+
+/// This class is thread safe.
+/// A set of tasks run on a scheduler, with continuations that are posted
+/// once every task of the group has completed. The group may be destroyed
+/// before its tasks complete.
+class BC_API task_group
+{
+public:
+    task_group(scheduler& scheduler);
+
+    /// This class is not copyable.
+    task_group(const task_group&) = delete;
+    void operator=(const task_group&) = delete;
+
+    /// Run a task on the scheduler, or on the calling thread once stopped.
+    void run(scheduler::task job);
+
+    /// Post the continuation once all tasks complete, now if none remain.
+    void then(scheduler::task continuation);
+
+    /// Block until all tasks complete, running queued tasks of this group
+    /// (and no others) on the calling thread meanwhile.
+    void wait();
+
+private:
+    struct state
+    {
+        size_t pending = 0;
+        std::deque<scheduler::task> queued;
+        std::vector<scheduler::task> continuations;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+
+    typedef std::shared_ptr<state> state_ptr;
+
+    static bool claim(state_ptr group, scheduler::task& out);
+    static void complete(scheduler& scheduler, state_ptr group);
+    static void follow(scheduler& scheduler, scheduler::task continuation);
+
+    scheduler& scheduler_;
+    state_ptr state_;
+};
+
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MVS_SPAN_WRITER_HPP
+#define MVS_SPAN_WRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <metaverse/bitcoin/math/hash.hpp>
+#include <metaverse/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+/**
+ * Bounds-checked writer over a preallocated contiguous byte range.
+ *
+ * This provides the writer interface without virtual dispatch, so that
+ * templated serializers may be instantiated on it directly. Writing beyond
+ * the end invalidates the writer and the excess is discarded. The range must
+ * outlive the writer.
+ */
+class span_writer final
+{
+public:
+    span_writer(data_chunk& data);
+    span_writer(uint8_t* begin, uint8_t* end);
+
+    operator bool() const;
+    bool operator!() const;
+
+    void write_byte(uint8_t value);
+    void write_data(const data_chunk& data);
+    void write_data(const uint8_t* data, size_t size);
+    void write_hash(const hash_digest& value);
+    void write_short_hash(const short_hash& value);
+    void write_mini_hash(const mini_hash& value);
+
+    // These write data in little endian format:
+    void write_2_bytes_little_endian(uint16_t value);
+    void write_4_bytes_little_endian(uint32_t value);
+    void write_8_bytes_little_endian(uint64_t value);
+    void write_variable_uint_little_endian(uint64_t value);
+
+    // These write data in big endian format:
+    void write_2_bytes_big_endian(uint16_t value);
+    void write_4_bytes_big_endian(uint32_t value);
+    void write_8_bytes_big_endian(uint64_t value);
+    void write_variable_uint_big_endian(uint64_t value);
+
+    /**
+     * Write a fixed size string padded with zeroes.
+     */
+    void write_fixed_string(const std::string& value, size_t size);
+
+    /**
+     * Write a variable length string.
+     */
+    void write_string(const std::string& value);
+
+    template <typename T>
+    void write_big_endian(T value);
+
+    template <typename T>
+    void write_little_endian(T value);
+
+    template <unsigned Size>
+    void write_bytes(const byte_array<Size>& value);
+
+    template <unsigned Size>
+    void write_bytes_reverse(const byte_array<Size>& value);
+
+    /**
+     * The number of bytes written.
+     */
+    size_t size() const;
+
+    /**
+     * The number of bytes that may yet be written.
+     */
+    size_t remaining() const;
+
+private:
+    // Invalidate if fewer than size bytes remain, true if still valid.
+    bool require(size_t size);
+
+    uint8_t* const begin_;
+    uint8_t* position_;
+    uint8_t* const end_;
+    bool valid_;
+};
+
+} // namespace libbitcoin
+
+#include <metaverse/bitcoin/impl/utility/span_writer.ipp>
+
+#endif
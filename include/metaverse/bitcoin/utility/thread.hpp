@@ -22,6 +22,8 @@
 #define MVS_THREAD_HPP
 
 #include <memory>
+#include <cstdint>
+#include <vector>
 #include <boost/thread.hpp>
 #include <metaverse/bitcoin/define.hpp>
 
@@ -47,6 +49,9 @@ typedef boost::upgrade_to_unique_lock<shared_mutex> upgrade_to_unique_lock;
 
 BC_API void set_thread_priority(thread_priority priority);
 
+/// Restrict the current thread to the given processors (empty is any).
+BC_API void set_thread_affinity(const std::vector<uint32_t>& processors);
+
 } // namespace libbitcoin
 
 #endif
@@ -21,11 +21,15 @@
 #ifndef MVS_THREADPOOL_HPP
 #define MVS_THREADPOOL_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <functional>
 #include <thread>
+#include <vector>
 #include <metaverse/bitcoin/define.hpp>
 #include <metaverse/bitcoin/utility/asio.hpp>
+#include <metaverse/bitcoin/utility/monitor.hpp>
 #include <metaverse/bitcoin/utility/thread.hpp>
 
 namespace libbitcoin {
@@ -58,6 +62,15 @@ public:
     void spawn(size_t number_threads=1,
         thread_priority priority=thread_priority::normal);
 
+    /**
+     * Add n threads to this threadpool, each restricted to the processors.
+     * @param[in]   number_threads  Number of threads to add.
+     * @param[in]   priority        Priority of threads to add.
+     * @param[in]   processors      Processors to run on, empty for any.
+     */
+    void spawn(size_t number_threads, thread_priority priority,
+        const std::vector<uint32_t>& processors);
+
     /**
      * Abandon outstanding operations without dispatching handlers.
      * Terminate threads once work is complete.
@@ -96,12 +109,29 @@ public:
      */
     const asio::service& service() const;
 
+    /**
+     * Track a work queue counter against this pool (see work).
+     */
+    void attach(monitor::count_ptr counter);
+
+    /**
+     * The number of jobs queued or running on all attached work queues.
+     */
+    size_t backlog() const;
+
 private:
-    void spawn_once(thread_priority priority=thread_priority::normal);
+    typedef std::weak_ptr<monitor::count> count_reference;
+
+    void spawn_once(thread_priority priority=thread_priority::normal,
+        const std::vector<uint32_t>& processors={});
 
     asio::service service_;
     std::vector<asio::thread> threads_;
     std::shared_ptr<asio::service::work> work_;
+
+    // Protected by counters_mutex_.
+    std::vector<count_reference> counters_;
+    mutable shared_mutex counters_mutex_;
 };
 
 } // namespace libbitcoin
@@ -20,11 +20,15 @@
 #include <metaverse/consensus.hpp>
 #endif
 
+#include <metaverse/blockchain/account_cache.hpp>
 #include <metaverse/blockchain/block.hpp>
 #include <metaverse/blockchain/block_chain.hpp>
 #include <metaverse/blockchain/block_chain_impl.hpp>
 #include <metaverse/blockchain/block_detail.hpp>
 #include <metaverse/blockchain/block_fetcher.hpp>
+#include <metaverse/blockchain/block_file.hpp>
+#include <metaverse/blockchain/block_replayer.hpp>
+#include <metaverse/blockchain/chain_work.hpp>
 #include <metaverse/blockchain/define.hpp>
 #include <metaverse/blockchain/organizer.hpp>
 #include <metaverse/blockchain/orphan_pool.hpp>
@@ -32,6 +36,7 @@
 #include <metaverse/blockchain/simple_chain.hpp>
 #include <metaverse/blockchain/transaction_pool.hpp>
 #include <metaverse/blockchain/transaction_pool_index.hpp>
+#include <metaverse/blockchain/transaction_pool_symbols.hpp>
 #include <metaverse/blockchain/validate_block.hpp>
 #include <metaverse/blockchain/validate_block_impl.hpp>
 #include <metaverse/blockchain/validate_transaction.hpp>
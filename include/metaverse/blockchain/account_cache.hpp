@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MVS_BLOCKCHAIN_ACCOUNT_CACHE_HPP
+#define MVS_BLOCKCHAIN_ACCOUNT_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <metaverse/bitcoin.hpp>
+#include <metaverse/bitcoin/chain/attachment/account/account_address.hpp>
+#include <metaverse/blockchain/define.hpp>
+
+namespace libbitcoin {
+namespace blockchain {
+
+/// Owned addresses by account and etp balances by address, so that account
+/// queries do not rescan the history of addresses that have not changed.
+/// Balances are dropped as blocks touch their addresses, and all of them are
+/// dropped when blocks are popped, since maturity is only monotonic as the
+/// chain grows. Balances may be queried for any address, so they are held
+/// to a capacity, evicting the least recently used. This class is thread safe.
+class BCB_API account_cache
+{
+public:
+    typedef std::shared_ptr<chain::account_address::list> address_list_ptr;
+
+    /// Hold at most balance_capacity balances (min 1).
+    account_cache(size_t balance_capacity);
+
+    struct balance
+    {
+        uint64_t total_received;
+        uint64_t confirmed;
+        uint64_t unspent;
+        uint64_t frozen;
+
+        /// The chain top the balance was computed at.
+        uint64_t height;
+    };
+
+    /// Get a copy of the cached addresses of the account, false if absent.
+    bool addresses(const std::string& account, address_list_ptr& out) const;
+
+    /// Cache the addresses of the account read while address_generation()
+    /// returned generation, ignored if addresses were written since or if
+    /// the account has none (it may not exist).
+    void store_addresses(const std::string& account,
+        const chain::account_address::list& addresses, uint64_t generation);
+
+    /// Changes whenever account addresses are written.
+    uint64_t address_generation() const;
+
+    /// Drop the addresses of the account following a write.
+    void drop_addresses(const std::string& account);
+
+    /// Get the balance of the address, false if absent or if it holds
+    /// frozen funds and was computed below the given top.
+    bool get_balance(const std::string& address, uint64_t top,
+        balance& out);
+
+    /// Cache a balance computed while generation() returned generation,
+    /// ignored if blocks have changed the chain since.
+    void store_balance(const std::string& address, const balance& value,
+        uint64_t generation);
+
+    /// Changes whenever balances may have been invalidated.
+    uint64_t generation() const;
+
+    /// Drop the balances of the addresses paid or spent by the block.
+    void connect(const chain::block& block);
+
+    /// Drop all balances.
+    void disconnect();
+
+private:
+    // Most recently used first.
+    typedef std::list<std::string> recency_list;
+
+    struct balance_entry
+    {
+        balance value;
+        recency_list::iterator position;
+    };
+
+    typedef std::unordered_map<std::string, address_list_ptr> address_map;
+    typedef std::unordered_map<std::string, balance_entry> balance_map;
+
+    void erase_balance(balance_map::iterator it);
+
+    const size_t balance_capacity_;
+
+    // These are protected by mutex.
+    address_map addresses_;
+    balance_map balances_;
+    recency_list recency_;
+    uint64_t generation_ = 0;
+    uint64_t address_generation_ = 0;
+    mutable shared_mutex mutex_;
+};
+
+} // namespace blockchain
+} // namespace libbitcoin
+
+#endif
@@ -29,6 +29,8 @@
 #include <metaverse/bitcoin.hpp>
 #include <metaverse/database.hpp>
 #include <metaverse/blockchain/block_chain.hpp>
+#include <metaverse/blockchain/account_cache.hpp>
+#include <metaverse/blockchain/chain_work.hpp>
 #include <metaverse/blockchain/define.hpp>
 #include <metaverse/blockchain/organizer.hpp>
 #include <metaverse/blockchain/settings.hpp>
@@ -66,6 +68,12 @@ public:
         const blockchain::settings& chain_settings,
         const database::settings& database_settings);
 
+    /// Run block organization and transaction pool work on separate pools.
+    /// Stored blocks are organized in order on the block pool.
+    block_chain_impl(threadpool& block_pool, threadpool& transaction_pool,
+        const blockchain::settings& chain_settings,
+        const database::settings& database_settings);
+
     /// The database is closed on destruct, threads must be joined.
     ~block_chain_impl();
 
@@ -79,6 +87,12 @@ public:
     // Get a reference to the transaction pool.
     transaction_pool& pool();
 
+    // Get a reference to the scheduler for fanning out independent work.
+    scheduler& task_scheduler();
+
+    // Get a reference to the cache of account addresses and balances.
+    account_cache& get_account_cache();
+
     // Get a reference to the blockchain configuration settings.
     const settings& chain_settings() const;
 
@@ -132,6 +146,17 @@ public:
     /// Import a block to the blockchain.
     bool import(chain::block::ptr block, uint64_t height) override;
 
+    /// Import a block, leaving the flush to a later synchronize() if !sync.
+    bool import(chain::block::ptr block, uint64_t height, bool sync);
+
+    /// Flush the databases after unsynchronized imports.
+    void synchronize();
+
+    /// Copy the database into a new directory at a block boundary, without
+    /// stopping the node. Block and account writes wait, reads continue.
+    bool snapshot(const boost::filesystem::path& directory,
+        uint64_t& out_height);
+
     /// Append the block to the top of the chain.
     bool push(block_detail::ptr block) override;
 
@@ -525,15 +550,22 @@ private:
     std::atomic<bool> sync_disabled_;
     const settings& settings_;
 
-    // These are thread safe.
+    // These are thread safe, the scheduler outlives its fanout clients.
+    scheduler scheduler_;
     organizer organizer_;
     ////dispatcher read_dispatch_;
-    ////dispatcher write_dispatch_;
+    dispatcher write_dispatch_;
     blockchain::transaction_pool transaction_pool_;
 
     // This is protected by mutex.
     database::data_base database_;
     shared_mutex mutex_;
+
+    // This is thread safe, cumulative work near the top of the chain.
+    mutable chain_work work_;
+
+    // This is thread safe, invalidated as blocks and addresses are written.
+    account_cache account_cache_;
 };
 
 } // namespace blockchain
@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MVS_BLOCKCHAIN_BLOCK_FILE_HPP
+#define MVS_BLOCKCHAIN_BLOCK_FILE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <boost/filesystem.hpp>
+#include <metaverse/bitcoin.hpp>
+#include <metaverse/blockchain/define.hpp>
+#include <metaverse/blockchain/block_replayer.hpp>
+
+namespace libbitcoin {
+namespace blockchain {
+
+/// Exported block files are a four byte magic and a four byte version,
+/// followed by one record per block in ascending height order: the height
+/// (8 bytes), the serialized size (4 bytes) and the serialized block.
+/// All integers are little endian.
+static constexpr uint32_t block_file_magic = 0x4253564d;
+static constexpr uint32_t block_file_version = 1;
+
+/// Writes an exported block file. This class is not thread safe.
+class BCB_API block_file_writer
+{
+public:
+    block_file_writer(const boost::filesystem::path& file);
+
+    /// Create or truncate the file and write the preamble.
+    bool open();
+
+    /// Append a serialized block, heights must ascend.
+    bool write(const data_chunk& block, uint64_t height);
+
+    /// Flush and release the file, false if any write failed.
+    bool close();
+
+private:
+    const boost::filesystem::path file_;
+    std::shared_ptr<bc::ofstream> stream_;
+    uint64_t last_height_;
+};
+
+/// Reads the blocks of an exported block file. This class is not thread safe.
+class BCB_API file_block_source
+  : public block_source
+{
+public:
+    /// Records below start_height are skipped.
+    file_block_source(const boost::filesystem::path& file,
+        uint64_t start_height=1);
+
+    bool open() override;
+    code next(data_chunk& out_block, uint64_t& out_height) override;
+    void close() override;
+
+private:
+    const boost::filesystem::path file_;
+    const uint64_t start_height_;
+    std::shared_ptr<bc::ifstream> stream_;
+    uint64_t size_;
+};
+
+} // namespace blockchain
+} // namespace libbitcoin
+
+#endif
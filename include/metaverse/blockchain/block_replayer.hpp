@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MVS_BLOCKCHAIN_BLOCK_REPLAYER_HPP
+#define MVS_BLOCKCHAIN_BLOCK_REPLAYER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <metaverse/bitcoin.hpp>
+#include <metaverse/database.hpp>
+#include <metaverse/blockchain/define.hpp>
+#include <metaverse/blockchain/block_chain_impl.hpp>
+
+namespace libbitcoin {
+namespace blockchain {
+
+/// A sequence of serialized blocks in ascending height order.
+class BCB_API block_source
+{
+public:
+    typedef std::shared_ptr<block_source> ptr;
+
+    virtual ~block_source() {}
+
+    /// Open the source, false if it cannot be read.
+    virtual bool open() = 0;
+
+    /// Read the next serialized block. Returns error::not_found at the end
+    /// of the source and another error if the source cannot be read.
+    virtual code next(data_chunk& out_block, uint64_t& out_height) = 0;
+
+    /// Release the source.
+    virtual void close() = 0;
+};
+
+/// Reads the blocks of an existing database directory, from start_height to
+/// stop_height or its top. The directory must not be in use by a running node.
+class BCB_API database_block_source
+  : public block_source
+{
+public:
+    database_block_source(const database::settings& settings,
+        uint64_t start_height=1, uint64_t stop_height=max_uint64);
+
+    bool open() override;
+    code next(data_chunk& out_block, uint64_t& out_height) override;
+    void close() override;
+
+private:
+    database::data_base database_;
+    uint64_t height_;
+    uint64_t stop_height_;
+    uint64_t top_;
+    bool opened_;
+};
+
+/// Pushes the blocks of a source through check, accept, connect and store
+/// on top of a chain, with no networking and no orphan pool.
+/// This class is not thread safe.
+class BCB_API block_replayer
+{
+public:
+    typedef asio::microseconds duration;
+
+    /// Accumulated cost of each stage of the replay.
+    struct timings
+    {
+        duration deserialize;
+        duration check;
+        duration accept;
+        duration connect;
+        duration store;
+        duration sync;
+        uint64_t blocks;
+        uint64_t trusted;
+        uint64_t transactions;
+        uint64_t inputs;
+    };
+
+    /// The chain must be started and is written directly, so it must not be
+    /// shared with a running node. Flush every sync_interval blocks (min 1).
+    /// If trust_checkpoints, skip connect (script and spend checks) at or
+    /// below the last checkpoint, as the organizer does during initial sync.
+    block_replayer(block_chain_impl& chain, size_t sync_interval=1,
+        bool trust_checkpoints=false);
+
+    /// Replay the source until it is exhausted, a block fails or stop().
+    code replay(block_source& source);
+
+    /// Signal the replay to stop after the current block.
+    void stop();
+
+    /// Totals of the blocks replayed so far.
+    const timings& totals() const;
+
+private:
+    code replay(const data_chunk& data, uint64_t height);
+    bool stopped() const;
+
+    block_chain_impl& chain_;
+    const bool use_testnet_rules_;
+    const config::checkpoint::list checkpoints_;
+    const size_t sync_interval_;
+    const bool trust_checkpoints_;
+    size_t unsynchronized_;
+    std::atomic<bool> stopped_;
+    timings totals_;
+};
+
+} // namespace blockchain
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MVS_BLOCKCHAIN_CHAIN_WORK_HPP
+#define MVS_BLOCKCHAIN_CHAIN_WORK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <metaverse/bitcoin.hpp>
+#include <metaverse/blockchain/define.hpp>
+
+namespace libbitcoin {
+namespace blockchain {
+
+/// Cumulative work of a trailing window of the block index, so that the work
+/// of the chain above a fork point is a subtraction rather than a walk of the
+/// stored headers. The window slides up as blocks are pushed and is clipped
+/// as they are popped. This class is thread safe.
+class BCB_API chain_work
+{
+public:
+    chain_work(size_t window);
+
+    /// Discard all entries, the next push starts a new window.
+    void clear();
+
+    /// Record the work of the block at height, ignored unless the height
+    /// directly extends the window (or the window is empty).
+    void push(uint64_t height, const u256& work);
+
+    /// Discard entries at and above height.
+    void pop(uint64_t height);
+
+    /// True if the window is non-empty and its top is the given height.
+    bool covers(uint64_t top) const;
+
+    /// The lowest height in the window, undefined if empty.
+    uint64_t base() const;
+
+    /// Sum the work from height through the top of the window, false if
+    /// height is below the window or the window is empty.
+    bool sum(u256& out_work, uint64_t height) const;
+
+private:
+    const size_t window_;
+
+    // These are protected by mutex.
+    uint64_t base_;
+    u256 prior_;
+    std::deque<u256> cumulative_;
+    mutable shared_mutex mutex_;
+};
+
+} // namespace blockchain
+} // namespace libbitcoin
+
+#endif
@@ -51,8 +51,9 @@ public:
     typedef std::function<bool(const code&, uint64_t, const list&, const list&)>
         reorganize_handler;
 
-    /// Construct an instance.
-    organizer(threadpool& pool, block_chain_impl& chain, const settings& settings);
+    /// Construct an instance, reorganization handlers fan out on fanout.
+    organizer(threadpool& pool, scheduler& fanout, block_chain_impl& chain,
+        const settings& settings);
 
     /// This method is NOT thread safe.
     virtual void organize();
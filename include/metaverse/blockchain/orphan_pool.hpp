@@ -22,8 +22,10 @@
 #define MVS_BLOCKCHAIN_orphan_pool_HPP
 
 #include <cstddef>
+#include <cstdint>
+#include <map>
 #include <memory>
-#include <boost/circular_buffer.hpp>
+#include <unordered_map>
 #include <metaverse/bitcoin.hpp>
 #include <metaverse/blockchain/define.hpp>
 #include <metaverse/blockchain/block_detail.hpp>
@@ -32,7 +34,9 @@ namespace libbitcoin {
 namespace blockchain {
 
 /// This class is thread safe.
-/// An unordered memory pool for orphan blocks.
+/// A memory pool for orphan blocks, indexed by hash and by parent hash.
+/// When full the pool evicts among its oldest blocks, preferring blocks with
+/// no children in the pool and then those of least work.
 class BCB_API orphan_pool
 {
 public:
@@ -59,18 +63,29 @@ public:
     block_detail::ptr delete_pending_block(const hash_digest& needed_block);
 
 private:
-//    typedef boost::circular_buffer<block_detail::ptr> buffer;
-    typedef std::vector<block_detail::ptr> buffer;
-    typedef buffer::const_iterator const_iterator;
-    typedef buffer::const_reverse_iterator const_reverse_iterator;
+    struct entry
+    {
+        block_detail::ptr block;
+        uint64_t sequence;
+    };
 
-    bool exists(const hash_digest& hash) const;
-    bool exists(const chain::header& header) const;
-    const_iterator find(buffer::const_iterator begin, const hash_digest& hash) const;
-    const_reverse_iterator rfind(buffer::const_reverse_iterator begin, const hash_digest& hash) const;
+    typedef std::unordered_map<hash_digest, entry> blocks;
+    typedef std::map<uint64_t, hash_digest> arrivals;
+    typedef std::unordered_multimap<hash_digest, hash_digest> children;
 
-    // The buffer is protected by mutex.
-    buffer buffer_;
+    bool exists(const hash_digest& hash) const;
+    bool has_children(const hash_digest& hash) const;
+    void insert(const hash_digest& hash, block_detail::ptr block);
+    void erase(blocks::const_iterator it);
+    void evict();
+
+    const size_t capacity_;
+
+    // These are protected by mutex.
+    uint64_t sequence_;
+    blocks blocks_;
+    arrivals arrivals_;
+    children children_;
     mutable upgrade_mutex mutex_;
 
     std::multimap<hash_digest, block_detail::ptr> pending_blocks_;
@@ -43,6 +43,7 @@ public:
     bool use_testnet_rules;
     bool collect_split_stake;
     bool disable_account_operations;
+    uint32_t scheduler_threads;
     config::checkpoint::list checkpoints;
     config::checkpoint::list basic_checkpoints;
 };
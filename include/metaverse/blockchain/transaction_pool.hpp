@@ -30,6 +30,7 @@
 #include <metaverse/blockchain/block_chain.hpp>
 #include <metaverse/blockchain/settings.hpp>
 #include <metaverse/blockchain/transaction_pool_index.hpp>
+#include <metaverse/blockchain/transaction_pool_symbols.hpp>
 
 namespace libbitcoin {
 namespace blockchain {
@@ -55,8 +56,8 @@ public:
     static bool is_spent_by_tx(const chain::output_point& outpoint,
         const transaction_ptr tx);
 
-    /// Construct a transaction memory pool.
-    transaction_pool(threadpool& pool, block_chain& chain,
+    /// Construct a transaction memory pool, handlers fan out on fanout.
+    transaction_pool(threadpool& pool, scheduler& fanout, block_chain& chain,
         const settings& settings);
 
     /// Clear the pool, threads must be joined.
@@ -135,8 +136,9 @@ protected:
     void delete_package(transaction_ptr tx, const code& ec);
     bool delete_single(const hash_digest& tx_hash, const code& ec);
 
-    // The buffer is protected by non-concurrent dispatch.
+    // The buffer and its symbols are protected by non-concurrent dispatch.
     buffer buffer_;
+    transaction_pool_symbols symbols_;
     std::atomic<bool> stopped_;
 
 private:
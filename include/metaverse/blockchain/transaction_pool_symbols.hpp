@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MVS_BLOCKCHAIN_TRANSACTION_POOL_SYMBOLS_HPP
+#define MVS_BLOCKCHAIN_TRANSACTION_POOL_SYMBOLS_HPP
+
+#include <string>
+#include <unordered_map>
+#include <metaverse/bitcoin.hpp>
+#include <metaverse/blockchain/define.hpp>
+
+namespace libbitcoin {
+namespace blockchain {
+
+/// Memory pool transactions by the asset, cert, MIT and DID symbols (and DID
+/// addresses) their outputs register or reference, so that a new transaction
+/// is checked for conflicts against its own outputs rather than the pool.
+/// This class is NOT thread safe.
+class BCB_API transaction_pool_symbols
+{
+public:
+    /// Index the outputs of a transaction entering the pool.
+    void add(const chain::transaction& tx);
+
+    /// Deindex the outputs of a transaction leaving the pool.
+    void remove(const chain::transaction& tx);
+
+    /// Deindex all transactions.
+    void clear();
+
+    /// Check a transaction's outputs against the pool and each other.
+    code check(const chain::transaction& tx) const;
+
+private:
+    typedef std::unordered_multimap<std::string, hash_digest> symbol_map;
+
+    static void erase(symbol_map& map, const std::string& key,
+        const hash_digest& tx_hash);
+
+    symbol_map assets_;
+    symbol_map certs_;
+    symbol_map mits_;
+    symbol_map dids_;
+    symbol_map did_addresses_;
+    symbol_map did_attachments_;
+};
+
+} // namespace blockchain
+} // namespace libbitcoin
+
+#endif
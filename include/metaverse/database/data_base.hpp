@@ -74,6 +74,7 @@ public:
     {
     public:
         store(const path& prefix);
+        std::vector<path> files() const;
         bool touch_all() const;
         bool touch_dids() const;
         bool dids_exist() const;
@@ -198,6 +199,18 @@ public:
     /// If height is not count + 1 then the count will not equal top height.
     void push(const chain::block& block, uint64_t height);
 
+    /// Commit block at given height, deferring the flush to the caller.
+    /// Bulk writers call synchronize() once the batch has been stored.
+    void push(const chain::block& block, uint64_t height, bool sync);
+
+    /// Flush all block, transaction and index databases.
+    void synchronize();
+
+    /// Copy every store file and the metadata into a new directory, which
+    /// then opens as of the last committed write. Writers must be held off
+    /// by the caller for the duration, readers are not blocked.
+    bool snapshot(const path& directory);
+
     /// Throws if the chain is empty.
     bool pop(chain::block& block);
 
@@ -333,7 +346,8 @@ private:
     static void uninitialize_lock(const path& lock);
     static file_lock initialize_lock(const path& lock);
 
-    void synchronize();
+    void set_policies(const settings& settings);
+
     void synchronize_dids();
     void synchronize_certs();
     void synchronize_witness_certs();
@@ -349,6 +363,7 @@ private:
     void pop_inputs(const inputs& inputs, size_t height);
     void pop_outputs(const outputs& outputs, size_t height);
 
+    const store paths_;
     const path lock_file_path_;
     const size_t history_height_;
     const size_t stealth_height_;
@@ -23,6 +23,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <metaverse/database/define.hpp>
 #include <metaverse/database/memory/memory.hpp>
@@ -32,6 +33,10 @@
 namespace libbitcoin {
 namespace database {
 
+/// Rows are stored in the order written, which is ascending height. An
+/// in-memory index partitions the rows by the leading byte of the prefix,
+/// each partition in height order, so that a scan reads only the rows of the
+/// partitions that can match the filter, from the requested height on.
 class BCD_API stealth_database
 {
 public:
@@ -56,7 +61,7 @@ public:
     /// Call to unload the memory map.
     bool close();
 
-    /// Linearly scan all entries, discarding those after from_height.
+    /// Get the rows matching the filter at or above from_height, by height.
     chain::stealth_compact::list scan(const binary& filter,
         size_t from_height) const;
 
@@ -64,7 +69,7 @@ public:
     void store(uint32_t prefix, uint32_t height,
         const chain::stealth_compact& row);
 
-    /// Delete all rows after and including from_height (no implemented).
+    /// Delete all rows after and including from_height.
     void unlink(size_t from_height);
 
     /// Synchronise storage with disk so things are consistent.
@@ -72,12 +77,21 @@ public:
     void sync();
 
 private:
-    void write_index();
-    array_index read_index(size_t from_height) const;
+    typedef std::vector<array_index> partition;
+
+    static size_t partition_of(uint32_t prefix);
+    uint32_t read_prefix(array_index row) const;
+    uint32_t read_height(array_index row) const;
+    void insert_row(array_index row, uint32_t prefix, uint32_t height);
+    void build_index();
 
     // Row entries containing stealth tx data.
     memory_map rows_file_;
     record_manager rows_manager_;
+
+    // Row indexes by leading prefix byte, protected by mutex.
+    std::vector<partition> partitions_;
+    mutable shared_mutex mutex_;
 };
 
 } // namespace database
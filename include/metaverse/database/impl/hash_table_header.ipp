@@ -85,15 +85,24 @@ bool hash_table_header<IndexType, ValueType>::start()
     if (minimum_file_size > file_.size())
         return false;
 
-    // The accessor must remain in scope until the end of the block.
-    const auto memory = file_.access();
-    const auto buckets_address = REMAP_ADDRESS(memory);
+    IndexType buckets;
+    {
+        // The accessor must remain in scope until the end of the block.
+        const auto memory = file_.access();
+        const auto buckets_address = REMAP_ADDRESS(memory);
 
-    // Does not require atomicity (no concurrency during start).
-    const auto buckets = from_little_endian_unsafe<IndexType>(buckets_address);
+        // Does not require atomicity (no concurrency during start).
+        buckets = from_little_endian_unsafe<IndexType>(buckets_address);
+    }
 
     // If buckets_ == 0 we trust what is read from the file.
-    return buckets_ == 0 || buckets == buckets_;
+    if (buckets_ != 0 && buckets != buckets_)
+        return false;
+
+    // Bucket reads dominate lookups, the file policy may keep them resident.
+    // This locks the map, so the accessor above must be released.
+    file_.lock_header(minimum_file_size);
+    return true;
 }
 
 template <typename IndexType, typename ValueType>
@@ -32,14 +32,14 @@ namespace database {
 
 #ifdef REMAP_SAFETY
 
-/// This class provides shared remap safe access to file-mapped memory.
-/// The memory size is unprotected and unmanaged.
+/// This class provides remap safe access to file-mapped memory.
+/// No lock is held, the map keeps every address it has published valid until
+/// it is closed. The memory size is unprotected and unmanaged.
 class BCD_API accessor
   : public memory
 {
 public:
-    accessor(shared_mutex& mutex, uint8_t*& data);
-    ~accessor();
+    accessor(uint8_t* data);
 
     /// This class is not copyable.
     accessor(const accessor& other) = delete;
@@ -51,7 +51,6 @@ public:
     void increment(size_t value);
 
 private:
-    shared_mutex& mutex_;
     uint8_t* data_;
 };
 
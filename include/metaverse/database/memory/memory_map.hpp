@@ -29,6 +29,8 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <metaverse/bitcoin.hpp>
 #include <metaverse/database/define.hpp>
@@ -38,12 +40,41 @@ namespace libbitcoin {
 namespace database {
 
 /// This class is thread safe, allowing concurent read and write.
-/// A change to the size of the memory map waits on and locks read and write.
+/// Address space is reserved beyond the end of the file, so growth is usually
+/// a file truncation alone. Growth past the reservation maps the file anew and
+/// retires the old mapping until close, so readers never lock or wait.
 class BCD_API memory_map
 {
 public:
     typedef std::shared_ptr<shared_mutex> mutex_ptr;
 
+    /// Kernel hints for a mapping, set per file through database::settings.
+    struct BCD_API policy
+    {
+        enum class access { normal, random, sequential, willneed };
+
+        policy();
+
+        /// The madvise access pattern of the whole mapping.
+        access advice;
+
+        /// Back the mapping with transparent huge pages (MADV_HUGEPAGE).
+        bool huge_pages;
+
+        /// Keep the hash table buckets at the front of the file resident.
+        bool lock_header;
+
+        /// Allocate disk blocks on growth instead of extending sparsely.
+        bool preallocate;
+
+        /// Growth on reserve as a percentage of the requested size (>= 100).
+        size_t expansion;
+    };
+
+    /// Set the policy of the file at the path, applied when it starts.
+    static void set_policy(const boost::filesystem::path& filename,
+        const policy& value);
+
     /// Construct a database (start is currently called, may throw).
     memory_map(const boost::filesystem::path& filename);
     memory_map(const boost::filesystem::path& filename, mutex_ptr mutex);
@@ -73,8 +104,14 @@ public:
     memory_ptr reserve(size_t size);
     memory_ptr reserve(size_t size, size_t growth_ratio);
 
+    /// Lock the first size bytes in memory if the policy asks for it.
+    void lock_header(size_t size);
+
 private:
+    typedef std::vector<std::pair<uint8_t*, size_t>> mappings;
+
     static size_t file_size(int file_handle);
+    static size_t reservation(size_t size);
     static int open_file(const boost::filesystem::path& filename);
     static bool handle_error(const std::string& context,
         const boost::filesystem::path& filename);
@@ -82,10 +119,10 @@ private:
     size_t page();
     bool unmap();
     bool map(size_t size);
-    bool remap(size_t size);
     bool truncate(size_t size);
     bool truncate_mapped(size_t size);
-    bool validate(size_t size);
+    bool advise();
+    bool pin();
 
     void log_mapping();
     void log_resizing(size_t size);
@@ -98,10 +135,16 @@ private:
     const int file_handle_;
     const boost::filesystem::path filename_;
 
+    // Read without locking, written under the internal (upgrade) mutex.
+    std::atomic<uint8_t*> data_;
+    std::atomic<size_t> file_size_;
+    std::atomic<size_t> logical_size_;
+
     // Protected by internal mutex.
-    uint8_t* data_;
-    size_t file_size_;
-    size_t logical_size_;
+    size_t capacity_;
+    size_t locked_size_;
+    mappings retired_;
+    policy policy_;
     std::atomic<bool> closed_;
     std::atomic<bool> stopped_;
     mutable upgrade_mutex mutex_;
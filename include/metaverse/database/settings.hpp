@@ -22,6 +22,8 @@
 #define MVS_DATABASE_SETTINGS_HPP
 
 #include <cstdint>
+#include <string>
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <metaverse/database/define.hpp>
 
@@ -40,6 +42,13 @@ public:
     uint32_t stealth_start_height;
     boost::filesystem::path directory;
     boost::filesystem::path default_directory;
+
+    /// Memory map policy, store files are named as in the directory.
+    std::string file_access;
+    std::vector<std::string> huge_page_files;
+    std::vector<std::string> locked_header_files;
+    bool preallocate_files;
+    uint32_t file_growth_rate;
 };
 
 } // namespace database
@@ -23,6 +23,7 @@
 #include <metaverse/explorer/display.hpp>
 #include <metaverse/explorer/generated.hpp>
 #include <metaverse/explorer/parser.hpp>
+#include <metaverse/explorer/json_emitter.hpp>
 #include <metaverse/explorer/json_helper.hpp>
 #include <metaverse/explorer/utility.hpp>
 #include <metaverse/explorer/commands/fetch-history.hpp>
@@ -21,9 +21,11 @@
 #ifndef BX_DISPATCH_HPP
 #define BX_DISPATCH_HPP
 
+#include <functional>
 #include <iostream>
 #include <metaverse/bitcoin.hpp>
 #include <metaverse/explorer/define.hpp>
+#include <metaverse/explorer/json_emitter.hpp>
 #include <metaverse/server/server_node.hpp>
 
 /* NOTE: don't declare 'using namespace foo' in headers. */
@@ -69,6 +71,20 @@ BCX_API console_result dispatch_command(int argc, const char* argv[],
     Json::Value& jv_output,
     bc::server::server_node& node, uint8_t api_version = 1);
 
+/**
+ * Supplies the emitter for a streamed result, it is called at most once and
+ * only after the command has been validated.
+ */
+typedef std::function<config::json_emitter&()> emitter_source;
+
+/**
+ * As above, but a command that streams its result writes it to the emitter
+ * obtained from begin_stream, leaving jv_output untouched.
+ */
+BCX_API console_result dispatch_command(int argc, const char* argv[],
+    Json::Value& jv_output, const emitter_source& begin_stream,
+    bc::server::server_node& node, uint8_t api_version);
+
 } // namespace explorer
 } // namespace libbitcoin
 
@@ -25,6 +25,7 @@
 #include <metaverse/bitcoin/chain/attachment/account/account_address.hpp>
 #include <metaverse/explorer/define.hpp>
 #include <metaverse/explorer/command.hpp>
+#include <metaverse/explorer/extensions/coin_selection.hpp>
 
 namespace libbitcoin {
 namespace blockchain {
@@ -331,6 +332,8 @@ public:
     static const uint64_t tx_limit{677};
 
     virtual bool get_spendable_output(chain::output&, const chain::history&, uint64_t height) const;
+    address_asset_record add_unspent(const std::string& prikey, const chain::history& row,
+            const chain::output& output, uint64_t asset_amount, uint32_t sequence);
     virtual chain::operation::stack get_script_operations(const receiver_record& record) const;
     virtual void sync_fetchutxo(
             const std::string& prikey, const std::string& addr, filter filter = FILTER_ALL, const chain::history::list& spec_rows={});
@@ -385,6 +388,8 @@ public:
     auto use_specified_rows(bool value) { use_specified_rows_ = value; }
     inline auto use_specified_rows() const { return use_specified_rows_; }
 
+    void set_coin_selection(coin_selection value) { coin_selection_ = value; }
+
 protected:
     bc::blockchain::block_chain_impl& blockchain_;
     tx_type                           tx_; // target transaction
@@ -408,6 +413,7 @@ protected:
     uint32_t                          locktime_;
     uint32_t                          sequence_;
     exclude_range_t                   exclude_etp_range_;
+    coin_selection                    coin_selection_{coin_selection::branch_and_bound};
 };
 
 class BCX_API base_transfer_helper : public base_transfer_common
@@ -436,6 +442,8 @@ public:
     void populate_unspent_list() override;
 
 protected:
+    bool select_etp_unspent(const chain::account_address::list& addresses);
+
     command&                          cmd_;
     std::string                       name_;
     std::string                       passwd_;
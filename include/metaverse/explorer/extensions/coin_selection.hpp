@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2016-2021 mvs developers
+ *
+ * This file is part of metaverse-explorer.
+ *
+ * metaverse-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <metaverse/explorer/define.hpp>
+
+namespace libbitcoin {
+namespace explorer {
+namespace commands {
+
+/// Order in which spendable outputs are chosen to fund a payment.
+enum class coin_selection : uint8_t
+{
+    /// Address history order, the first combination that covers the amount.
+    history,
+
+    /// Largest outputs first, fewest inputs.
+    largest_first,
+
+    /// Oldest confirmed outputs first, unconfirmed outputs last.
+    oldest_first,
+
+    /// Search for inputs that match the amount exactly (no change output),
+    /// otherwise largest first.
+    branch_and_bound
+};
+
+/// Parse a selection name (history, largest, oldest, bnb).
+/// Throws argument_legality_exception for an unknown name.
+BCX_API coin_selection to_coin_selection(const std::string& name);
+
+/// A spendable output as seen by selection, index refers to the caller.
+struct BCX_API coin_candidate
+{
+    typedef std::vector<coin_candidate> list;
+
+    uint64_t amount;
+    uint64_t height;
+    size_t index;
+};
+
+/// This class is thread safe.
+class BCX_API coin_selector
+{
+public:
+    typedef std::vector<size_t> indexes;
+
+    /// Branch and bound accepts up to change_cost above the target.
+    coin_selector(coin_selection strategy, uint64_t change_cost=0);
+
+    /// Candidate indexes that cover the target, empty if none suffice.
+    indexes select(const coin_candidate::list& candidates,
+        uint64_t target) const;
+
+private:
+    indexes accumulate(const coin_candidate::list& candidates,
+        std::vector<size_t>&& order, uint64_t target) const;
+    indexes branch_and_bound(const coin_candidate::list& candidates,
+        uint64_t target) const;
+
+    const coin_selection strategy_;
+    const uint64_t change_cost_;
+};
+
+} // namespace commands
+} // namespace explorer
+} // namespace libbitcoin
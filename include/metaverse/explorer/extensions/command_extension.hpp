@@ -26,6 +26,7 @@
 #include <metaverse/bitcoin.hpp>
 #include <metaverse/explorer/define.hpp>
 #include <metaverse/explorer/command.hpp>
+#include <metaverse/explorer/json_emitter.hpp>
 #include <metaverse/bitcoin/chain/attachment/asset/asset_detail.hpp>  // used for createasset
 #include <metaverse/server/server_node.hpp>
 
@@ -221,6 +222,19 @@ public:
         return console_result::failure;
     }
 
+    // Commands with large results may write them through the emitter as they
+    // are produced, rather than building the whole tree first.
+    virtual bool streams()
+    {
+        return false;
+    }
+
+    virtual console_result invoke(config::json_emitter& out,
+        libbitcoin::server::server_node& node)
+    {
+        return console_result::failure;
+    }
+
 protected:
     struct argument_base
     {
@@ -110,6 +110,14 @@ public:
     console_result invoke (Json::Value& jv_output,
          libbitcoin::server::server_node& node) override;
 
+    bool streams() override
+    {
+        return get_api_version() >= 2;
+    }
+
+    console_result invoke (config::json_emitter& out,
+         libbitcoin::server::server_node& node) override;
+
     struct argument
     {
         std::string address;
@@ -130,6 +138,12 @@ public:
         uint64_t utxo_min_confirm;
     } option_;
 
+private:
+    typedef std::function<void(Json::Value&& asset)> item_handler;
+
+    // Pass each selected asset, certificate or utxo balance to item.
+    void list(libbitcoin::server::server_node& node, const item_handler& item);
+
 };
 
 
@@ -94,6 +94,14 @@ public:
     console_result invoke (Json::Value& jv_output,
          libbitcoin::server::server_node& node) override;
 
+    bool streams() override
+    {
+        return get_api_version() >= 2;
+    }
+
+    console_result invoke (config::json_emitter& out,
+         libbitcoin::server::server_node& node) override;
+
     struct argument
     {
         std::string hash_or_height;
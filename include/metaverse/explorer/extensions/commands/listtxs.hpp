@@ -113,6 +113,14 @@ public:
     console_result invoke (Json::Value& jv_output,
                            libbitcoin::server::server_node& node) override;
 
+    bool streams() override
+    {
+        return get_api_version() >= 2;
+    }
+
+    console_result invoke (config::json_emitter& out,
+                           libbitcoin::server::server_node& node) override;
+
     struct argument
     {
         argument(): address(""), symbol(""), limit(100), index(0)
@@ -130,6 +138,15 @@ public:
         libbitcoin::explorer::commands::colon_delimited2_item<uint64_t, uint64_t> height;
     } option_;
 
+private:
+    typedef std::function<void(uint64_t total_page, uint64_t tx_count)> page_handler;
+    typedef std::function<void(Json::Value&& tx_item)> item_handler;
+
+    // Select the requested page of transactions, passing its summary to page
+    // before each of its transactions is passed to item.
+    void list(libbitcoin::server::server_node& node,
+        const page_handler& page, const item_handler& item);
+
 };
 
 
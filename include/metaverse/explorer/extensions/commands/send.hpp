@@ -114,6 +114,11 @@ public:
             "fee,f",
             value<uint64_t>(&option_.fee)->default_value(10000),
             "Transaction fee. defaults to 10000 etp bits"
+        )
+        (
+            "selection",
+            value<std::string>(&option_.selection)->default_value("bnb"),
+            "Etp utxo selection: bnb (exact amount without change, else largest), largest, oldest or history. defaults to bnb"
         );
 
         return options;
@@ -141,6 +146,7 @@ public:
         std::string change;
         uint32_t locktime;
         colon_delimited2_item<uint64_t, uint64_t> exclude = {0, 0};
+        std::string selection;
     } option_;
 
 };
@@ -115,6 +115,11 @@ public:
             "memo,i",
             value<std::string>(&option_.memo)->default_value(""),
             "Attached memo for this transaction."
+        )
+        (
+            "selection",
+            value<std::string>(&option_.selection)->default_value("bnb"),
+            "Etp utxo selection: bnb (exact amount without change, else largest), largest, oldest or history. defaults to bnb"
         );
         return options;
     }
@@ -139,6 +144,7 @@ public:
         std::string memo;
         std::string change;
         uint64_t fee;
+        std::string selection;
     } option_;
 
 };
@@ -0,0 +1,93 @@
+/**
+ * Copyright (c) 2016-2021 mvs developers
+ *
+ * This file is part of metaverse-explorer.
+ *
+ * metaverse-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_JSON_EMITTER_HPP
+#define BX_JSON_EMITTER_HPP
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <metaverse/explorer/define.hpp>
+
+#include <jsoncpp/json/json.h>
+
+namespace libbitcoin {
+namespace explorer {
+namespace config {
+
+/**
+ * Writes a json document to a stream as it is produced, so that large
+ * results need not be held as a complete Json::Value before serialization.
+ * Small subtrees may still be written from a Json::Value.
+ * Styled output indents by three spaces, as the styled Json writer does.
+ * This class is not thread safe.
+ */
+class BCX_API json_emitter
+{
+public:
+    json_emitter(std::ostream& stream, bool compact);
+
+    void begin_object();
+    void end_object();
+    void begin_array();
+    void end_array();
+
+    /**
+     * Write the name of the next object member, its value must follow.
+     * @param[in]  name  The member name.
+     */
+    void key(const std::string& name);
+
+    /**
+     * Write a complete value, as an array element or after a key.
+     * @param[in]  value  The value to write.
+     */
+    void value(const Json::Value& value);
+
+    /**
+     * Write an object member.
+     * @param[in]  name   The member name.
+     * @param[in]  value  The member value.
+     */
+    void member(const std::string& name, const Json::Value& value);
+
+private:
+    struct scope
+    {
+        bool array;
+        bool empty;
+    };
+
+    void open(char token, bool array);
+    void close(char token);
+    void separate();
+    void indent();
+    void write(const Json::Value& value);
+
+    std::ostream& stream_;
+    const bool compact_;
+    std::vector<scope> scopes_;
+    bool keyed_;
+};
+
+} // namespace config
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
@@ -57,6 +57,10 @@ protected:
 
     void check_rpc_client_addresses(struct mg_connection& nc);
 
+    // Write the value straight into the response buffer.
+    void write_json(const Json::Value& value);
+    std::string to_json_string(const Json::Value& value);
+
 private:
     enum : int {
       // Method values are represented as powers of two for simplicity.
@@ -22,6 +22,7 @@
 #include <atomic>
 #include <mutex>
 #include <memory>
+#include <set>
 #include <unordered_map>
 #include <metaverse/bitcoin.hpp>
 #include <metaverse/mgbubble/MgServer.hpp>
@@ -120,23 +121,49 @@ protected:
 
 private:
     typedef std::vector<std::string> string_vector;
-    typedef std::map<std::weak_ptr<mg_connection>, string_vector,
-            std::owner_less<std::weak_ptr<mg_connection>>> connection_string_map;
-
-    void do_notify(
-        const std::vector<std::weak_ptr<mg_connection>>& notify_cons,
-        Json::Value& value,
-        std::shared_ptr<connection_string_map> topic_map = nullptr);
+    typedef std::weak_ptr<mg_connection> connection_ptr;
+    typedef std::map<connection_ptr, string_vector,
+            std::owner_less<connection_ptr>> connection_string_map;
+    typedef std::set<connection_ptr,
+            std::owner_less<connection_ptr>> connection_set;
+    typedef std::unordered_map<std::string, connection_set> topic_index;
+    typedef std::shared_ptr<const std::string> payload_ptr;
+    typedef std::vector<std::pair<std::shared_ptr<mg_connection>,
+            payload_ptr>> notification_list;
+
+    // Frames are serialized once per distinct payload and shared.
+    void do_notify(const notification_list& notifications);
+
+    // Transaction subscriptions, an empty address list means all.
+    void subscribe_addresses(const connection_ptr& con,
+        const string_vector& addresses);
+    void unsubscribe_addresses(const connection_ptr& con);
+
+    // Block and height subscriptions.
+    void subscribe_channel(const connection_ptr& con,
+        const std::string& channel);
+    void unsubscribe_channel(const connection_ptr& con,
+        const std::string& channel);
+
+    // Callers must hold the respective subscriber lock.
+    void remove_address_subscriber(const connection_ptr& con);
+    void remove_channel_subscriber(const connection_ptr& con);
 
     std::string get_address(const std::string& did_or_address) const;
 
 private:
     libbitcoin::server::server_node& node_;
     std::unordered_map<void*, std::shared_ptr<mg_connection>> map_connections_;
+
+    // Connection to its addresses, and address to its connections.
     connection_string_map subscribers_;
+    topic_index address_index_;
+    connection_set all_subscribers_;
     std::mutex subscribers_lock_;
 
+    // Connection to its channels, and channel to its connections.
     connection_string_map block_subscribers_;
+    topic_index channel_index_;
     std::mutex block_subscribers_lock_;
 };
 }
@@ -16,6 +16,8 @@
 
 #include <metaverse/bitcoin.hpp>
 #include <metaverse/network/acceptor.hpp>
+#include <metaverse/network/buffer_pool.hpp>
+#include <metaverse/network/channel_metrics.hpp>
 #include <metaverse/network/channel.hpp>
 #include <metaverse/network/connections.hpp>
 #include <metaverse/network/connector.hpp>
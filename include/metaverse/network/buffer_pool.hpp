@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MVS_NETWORK_BUFFER_POOL_HPP
+#define MVS_NETWORK_BUFFER_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <metaverse/bitcoin.hpp>
+#include <metaverse/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// A process wide pool of reusable message payload slabs, thread safe.
+/// Slabs are sized in powers of two and return to the pool when the last
+/// reference to them is dropped, so idle channels hold no read buffer.
+class BCT_API buffer_pool
+{
+public:
+    typedef std::shared_ptr<data_chunk> slab_ptr;
+
+    /// The pool shared by all channels.
+    static buffer_pool& instance();
+
+    /// Construct a pool that retains at most the given number of bytes.
+    buffer_pool(size_t maximum_retained);
+
+    /// Free all retained slabs.
+    ~buffer_pool();
+
+    /// This class is not copyable.
+    buffer_pool(const buffer_pool&) = delete;
+    void operator=(const buffer_pool&) = delete;
+
+    /// Obtain a slab of at least size bytes, its size is the slab class.
+    slab_ptr acquire(size_t size);
+
+    /// The number of bytes held in free slabs.
+    size_t retained() const;
+
+private:
+    static size_t slab_class(size_t size);
+    void release(data_chunk* slab);
+
+    const size_t maximum_retained_;
+
+    // These are protected by mutex.
+    size_t retained_;
+    std::vector<std::vector<data_chunk*>> free_;
+    mutable upgrade_mutex mutex_;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
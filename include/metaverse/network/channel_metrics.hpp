@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MVS_NETWORK_CHANNEL_METRICS_HPP
+#define MVS_NETWORK_CHANNEL_METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <metaverse/bitcoin.hpp>
+#include <metaverse/network/define.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+/// Always-on traffic accounting of a single channel, lock free.
+/// Counters are relaxed atomics, a snapshot is not a consistent cut across
+/// counters but each counter is individually exact.
+class BCT_API channel_metrics
+{
+public:
+    static const size_t type_count =
+        static_cast<size_t>(message::message_type::version) + 1;
+
+    /// Totals for one message type.
+    struct totals
+    {
+        uint64_t received_messages;
+        uint64_t received_bytes;
+        uint64_t sent_messages;
+        uint64_t sent_bytes;
+
+        /// Time spent parsing received messages and passing them to their
+        /// subscribers. Most types are relayed to the subscriber's strand,
+        /// so this excludes the time the protocol handlers take.
+        uint64_t dispatch_microseconds;
+    };
+
+    /// A copy of the counters of a channel, indexed by message type.
+    struct snapshot
+    {
+        std::array<totals, type_count> types;
+        size_t queue_depth;
+        size_t peak_queue_depth;
+        uint64_t uptime_seconds;
+
+        totals total() const;
+    };
+
+    /// Construct an instance, the uptime starts now.
+    channel_metrics();
+
+    /// This class is not copyable.
+    channel_metrics(const channel_metrics&) = delete;
+    void operator=(const channel_metrics&) = delete;
+
+    /// Count a received message, bytes include the heading.
+    void received(message::message_type type, size_t bytes,
+        uint64_t dispatch_microseconds);
+
+    /// Count a sent message, bytes include the heading.
+    void sent(message::message_type type, size_t bytes);
+
+    /// Record the depth of the outbound queue.
+    void set_queue_depth(size_t depth);
+
+    snapshot to_snapshot() const;
+
+private:
+    typedef std::atomic<uint64_t> counter;
+
+    struct counters
+    {
+        counter received_messages;
+        counter received_bytes;
+        counter sent_messages;
+        counter sent_bytes;
+        counter dispatch_microseconds;
+    };
+
+    static size_t to_index(message::message_type type);
+
+    const std::chrono::steady_clock::time_point started_;
+    std::array<counters, type_count> types_;
+    std::atomic<size_t> queue_depth_;
+    std::atomic<size_t> peak_queue_depth_;
+};
+
+} // namespace network
+} // namespace libbitcoin
+
+#endif
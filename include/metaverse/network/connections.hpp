@@ -27,6 +27,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include <metaverse/bitcoin.hpp>
 #include <metaverse/network/channel.hpp>
@@ -46,6 +47,8 @@ public:
     typedef std::function<void(size_t)> count_handler;
     typedef std::function<void(const code&)> result_handler;
     typedef std::function<void(const code&, channel::ptr)> channel_handler;
+    typedef std::pair<config::authority, channel_metrics::snapshot> metrics;
+    typedef std::vector<metrics> metrics_list;
 
     /// Construct an instance.
     connections();
@@ -102,6 +105,7 @@ public:
     virtual void exists(const config::authority& authority,
         truth_handler handler) const;
     config::authority::list authority_list();
+    metrics_list channel_metrics_list() const;
 
 private:
     typedef std::vector<channel::ptr> list;
@@ -30,6 +30,8 @@ namespace libbitcoin {
 namespace network {
 
 // A shared boost::asio write buffer, thread safe.
+// A message heading and payload may be held as two pieces and written with
+// a single gather write, which avoids copying the payload into the heading.
 class BCT_API const_buffer
 {
 public:
@@ -41,6 +43,7 @@ public:
     const_buffer();
     explicit const_buffer(data_chunk&& data);
     explicit const_buffer(const data_chunk& data);
+    const_buffer(data_chunk&& heading, data_chunk&& payload);
 
     size_t size() const;
     const_iterator begin() const;
@@ -48,7 +51,9 @@ public:
 
 private:
     std::shared_ptr<data_chunk> data_;
-    value_type buffer_;
+    std::shared_ptr<data_chunk> payload_;
+    value_type buffers_[2];
+    size_t count_;
 };
 
 } // namespace network
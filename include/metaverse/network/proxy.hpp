@@ -29,7 +29,10 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 #include <metaverse/bitcoin.hpp>
+#include <metaverse/network/buffer_pool.hpp>
+#include <metaverse/network/channel_metrics.hpp>
 #include <metaverse/network/const_buffer.hpp>
 #include <metaverse/network/define.hpp>
 #include <metaverse/network/message_subscriber.hpp>
@@ -51,7 +54,6 @@ public:
     typedef subscriber<const code&> stop_subscriber;
     typedef resubscriber<const code&, const std::string&, const_buffer,
         result_handler> send_subscriber;
-    using request_callback = std::function<void()>;
 
     /// Construct an instance.
     proxy(threadpool& pool, socket::ptr socket, uint32_t protocol_magic,
@@ -68,9 +70,12 @@ public:
     template <class Message>
     void send(const Message& message, result_handler handler)
     {
-        const auto buffer = const_buffer(message::serialize(protocol_version_,
-            message, protocol_magic_));
-        do_send(message.command, buffer, handler);
+        // The heading and payload are gathered on write, not concatenated.
+        auto payload = message.to_data(protocol_version_);
+        auto heading = message::serialize_heading<Message>(payload,
+            protocol_magic_);
+        do_send(message.command, const_buffer(std::move(heading),
+            std::move(payload)), handler);
     }
 
     /// Subscribe to messages of the specified type on the socket.
@@ -93,6 +98,9 @@ public:
     /// Save the p2p protocol version object of the peer.
     virtual void set_version(message::version::ptr value);
 
+    /// Get the traffic counters of this socket.
+    virtual const channel_metrics& metrics() const;
+
     uint32_t peer_start_height() { return peer_version_message_.load() ? peer_version_message_.load()->start_height : 0; }
 
     /// Read messages from this socket.
@@ -118,9 +126,18 @@ protected:
     virtual void handle_stopping() = 0;
 
 private:
-    typedef byte_source<data_chunk> payload_source;
+    typedef byte_source<data_slice> payload_source;
     typedef boost::iostreams::stream<payload_source> payload_stream;
 
+    struct outbound
+    {
+        message::message_type type;
+        const_buffer buffer;
+        result_handler handler;
+    };
+
+    typedef std::vector<outbound> outbound_batch;
+
     static config::authority authority_factory(socket::ptr socket);
 
     void do_close();
@@ -135,10 +152,11 @@ private:
 
     void do_send(const std::string& command, const_buffer buffer,
         result_handler handler);
-    void handle_send(const boost_code& ec, const_buffer buffer,
-        result_handler handler);
+    void write(outbound_batch&& batch);
+    void handle_send(const boost_code& ec, outbound_batch batch);
 
-    void handle_request(data_chunk payload_buffer, uint32_t protocol_version_, message::heading head, size_t payload_size);
+    void handle_request(data_slice payload, uint32_t peer_protocol_version,
+        const message::heading& head);
 
     const uint32_t protocol_magic_;
     const uint32_t protocol_version_;
@@ -146,7 +164,7 @@ private:
 
     // These are protected by sequential ordering.
     data_chunk heading_buffer_;
-    data_chunk payload_buffer_;
+    buffer_pool::slab_ptr payload_buffer_;
 
     dispatcher dispatch_;
 
@@ -157,7 +175,9 @@ private:
     bc::atomic<message::version::ptr> peer_version_message_;
     message_subscriber message_subscriber_;
     stop_subscriber::ptr stop_subscriber_;
-    std::queue<request_callback> outbound_queue_;
+    channel_metrics metrics_;
+    // The queue is protected by the socket lock.
+    outbound_batch outbound_queue_;
     std::atomic_bool has_sent_;
 
     std::atomic_int misbehaving_;
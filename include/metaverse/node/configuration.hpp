@@ -66,6 +66,13 @@ public:
     /// Options and environment vars.
     boost::filesystem::path file;
     boost::filesystem::path data_dir;
+    boost::filesystem::path replay;
+    boost::filesystem::path export_file;
+    boost::filesystem::path import_file;
+    uint64_t export_start;
+    uint64_t export_stop;
+    uint32_t import_batch;
+    bool import_trusted;
 
     /// Settings.
     node::settings node;
@@ -87,6 +87,12 @@ public:
     /// Transaction pool interface.
     virtual blockchain::transaction_pool& pool();
 
+    /// Threadpool of block organization, the network pool if not dedicated.
+    virtual threadpool& block_executor();
+
+    /// Threadpool of transaction validation, the network pool if not dedicated.
+    virtual threadpool& transaction_executor();
+
     // Subscriptions.
     // ------------------------------------------------------------------------
 
@@ -119,7 +125,12 @@ private:
     void handle_started(const code& ec, result_handler handler);
     void handle_running(const code& ec, result_handler handler);
 
+    void spawn_executors();
+    void close_executors();
+
     // These are thread safe.
+    threadpool block_pool_;
+    threadpool transaction_pool_;
     header_queue hashes_;
     const settings& settings_;
 protected:
@@ -27,6 +27,7 @@
 #include <metaverse/blockchain.hpp>
 #include <metaverse/network.hpp>
 #include <metaverse/node/define.hpp>
+#include <metaverse/node/utility/compact_block_builder.hpp>
 
 namespace libbitcoin {
 namespace node {
@@ -39,7 +40,8 @@ public:
 
     /// Construct a block protocol instance.
     protocol_block_in(network::p2p& network, network::channel::ptr channel,
-        blockchain::block_chain& blockchain);
+        blockchain::block_chain& blockchain,
+        blockchain::transaction_pool& pool);
 
     ptr do_subscribe();
 
@@ -54,6 +56,10 @@ private:
     typedef message::inventory::ptr inventory_ptr;
     typedef message::not_found::ptr not_found_ptr;
     typedef message::block_message::ptr_list block_ptr_list;
+    typedef message::compact_block::ptr compact_block_ptr;
+    typedef message::block_transactions::ptr block_transactions_ptr;
+    typedef message::transaction_message::ptr transaction_ptr;
+    typedef compact_block_builder::ptr builder_ptr;
 
     void get_block_inventory(const code& ec);
     void send_get_blocks(const hash_digest& stop_hash);
@@ -62,6 +68,8 @@ private:
 
     bool handle_receive_block(const code& ec, block_ptr message);
     bool handle_receive_headers(const code& ec, headers_ptr message);
+    void handle_announced_parent(const code& ec, uint64_t height,
+        get_data_ptr message);
     bool handle_receive_inventory(const code& ec, inventory_ptr message);
     bool handle_receive_not_found(const code& ec, not_found_ptr message);
     void handle_filter_orphans(const code& ec, get_data_ptr message);
@@ -71,11 +79,34 @@ private:
     bool handle_reorganized(const code& ec, size_t fork_point,
         const block_ptr_list& incoming, const block_ptr_list& outgoing);
 
+    bool handle_receive_compact_block(const code& ec,
+        compact_block_ptr message);
+    bool handle_receive_block_transactions(const code& ec,
+        block_transactions_ptr message);
+    void handle_filter_compact_orphans(const code& ec, get_data_ptr message,
+        builder_ptr builder);
+    void handle_filter_compact_blocks(const code& ec, get_data_ptr message,
+        builder_ptr builder);
+    void handle_fetch_pool(const code& ec,
+        const std::vector<transaction_ptr>& transactions, builder_ptr builder);
+    void store_compact_block(builder_ptr builder);
+    void send_get_block(const hash_digest& hash);
+
     blockchain::block_chain& blockchain_;
+    blockchain::transaction_pool& pool_;
     bc::atomic<hash_digest> last_locator_top_;
     bc::atomic<hash_digest> current_chain_top_;
     const bool headers_from_peer_;
+    const bool compact_from_peer_;
     std::atomic_int headers_batch_size_;
+
+    // Distinguishes locator responses (continue sync) from announcements.
+    std::atomic<bool> locator_requested_;
+    std::atomic<bool> continue_sync_;
+
+    // The compact block awaiting missing transactions, protected by mutex.
+    builder_ptr pending_compact_;
+    mutable upgrade_mutex pending_mutex_;
 };
 
 } // namespace node
@@ -57,6 +57,8 @@ private:
     typedef message::get_headers::ptr get_headers_ptr;
     typedef message::send_headers::ptr send_headers_ptr;
     typedef message::merkle_block::ptr merkle_block_ptr;
+    typedef message::send_compact_blocks::ptr send_compact_blocks_ptr;
+    typedef message::get_block_transactions::ptr get_block_transactions_ptr;
     typedef message::block_message::ptr_list block_ptr_list;
     typedef chain::header::list header_list;
 
@@ -69,6 +71,12 @@ private:
     bool handle_receive_get_blocks(const code& ec, get_blocks_ptr message);
     bool handle_receive_get_headers(const code& ec, get_headers_ptr message);
     bool handle_receive_send_headers(const code& ec, send_headers_ptr message);
+    bool handle_receive_send_compact_blocks(const code& ec,
+        send_compact_blocks_ptr message);
+    bool handle_receive_get_block_transactions(const code& ec,
+        get_block_transactions_ptr message);
+    void send_block_transactions(const code& ec, chain::block::ptr block,
+        get_block_transactions_ptr message);
 
     void handle_fetch_locator_hashes(const code& ec, const hash_list& hashes);
     void handle_fetch_locator_headers(const code& ec,
@@ -79,11 +87,15 @@ private:
         const block_ptr_list& incoming, const block_ptr_list& outgoing);
 
     size_t locator_limit() const;
+    bool peer_near_top();
 
     blockchain::block_chain& blockchain_;
     bc::atomic<hash_digest> last_locator_top_;
     std::atomic<size_t> current_chain_height_;
     std::atomic<bool> headers_to_peer_;
+    const bool headers_enabled_;
+    std::atomic<bool> compact_to_peer_;
+    const bool compact_enabled_;
 };
 
 } // namespace node
@@ -22,6 +22,7 @@
 #define MVS_NODE_SETTINGS_HPP
 
 #include <cstdint>
+#include <vector>
 #include <metaverse/bitcoin.hpp>
 #include <metaverse/node/define.hpp>
 
@@ -39,6 +40,12 @@ public:
     uint32_t block_timeout_seconds;
     uint32_t download_connections;
     bool transaction_pool_refresh;
+
+    /// Executors, zero threads shares the network threadpool.
+    uint32_t block_threads;
+    uint32_t transaction_threads;
+    std::vector<uint32_t> block_processors;
+    std::vector<uint32_t> transaction_processors;
 };
 
 } // namespace node
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MVS_NODE_COMPACT_BLOCK_BUILDER_HPP
+#define MVS_NODE_COMPACT_BLOCK_BUILDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <metaverse/bitcoin.hpp>
+#include <metaverse/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Rebuilds a full block from a compact block (bip152), not thread safe.
+class BCN_API compact_block_builder
+{
+public:
+    typedef std::shared_ptr<compact_block_builder> ptr;
+    typedef message::transaction_message::ptr transaction_ptr;
+    typedef std::vector<transaction_ptr> transaction_ptr_list;
+
+    /// Construct a builder, placing the prefilled transactions.
+    compact_block_builder(const message::compact_block& block);
+
+    /// False if the prefilled indexes or short ids are malformed.
+    bool is_valid() const;
+
+    /// True if every transaction of the block is populated.
+    bool is_complete() const;
+
+    /// The hash of the block being built.
+    hash_digest hash() const;
+
+    /// Populate slots whose short id matches a pool transaction.
+    void populate(const transaction_ptr_list& pool);
+
+    /// Populate the missing slots in order, false if the count mismatches.
+    bool populate(const message::block_transactions& response);
+
+    /// Indexes of the transactions not yet populated.
+    std::vector<uint64_t> missing() const;
+
+    /// Assemble the block, nullptr if incomplete or the merkle root differs.
+    message::block_message::ptr to_block() const;
+
+private:
+    typedef message::compact_block::short_id short_id;
+
+    bool valid_;
+    chain::header header_;
+    ec_signature blocksig_;
+    ec_compressed public_key_;
+    std::vector<short_id> short_ids_;
+    std::vector<size_t> short_id_slots_;
+    std::vector<bool> populated_;
+    chain::transaction::list transactions_;
+    half_hash key_;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
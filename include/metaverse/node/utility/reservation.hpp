@@ -24,6 +24,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <boost/bimap.hpp>
 #include <boost/bimap/set_of.hpp>
@@ -44,6 +47,8 @@ class BCN_API reservation
 public:
     typedef std::shared_ptr<reservation> ptr;
     typedef std::vector<reservation::ptr> list;
+    typedef std::pair<hash_digest, size_t> entry;
+    typedef std::vector<entry> entries;
 
     /// Construct a block reservation with the specified identifier.
     reservation(reservations& reservations, size_t slot,
@@ -61,10 +66,19 @@ public:
     /// The number of outstanding blocks.
     size_t size() const;
 
+    /// The number of outstanding blocks that have not yet been requested.
+    size_t unrequested() const;
+
+    /// The number of requested blocks that have not yet been received.
+    size_t in_flight() const;
+
+    /// The number of blocks to keep in flight, from bandwidth and latency.
+    size_t window() const;
+
     /// The reservation is empty and will remain so.
     bool stopped() const;
 
-    /// True if block import rate was more than one standard deviation low.
+    /// True if the peer has stalled or is far slower than the other peers.
     bool expired() const;
 
     /// Sets the idle state to true. Call when channel is stopped.
@@ -73,13 +87,13 @@ public:
     /// True if the reservation is not applied to a channel.
     bool idle() const;
 
-    /// The current cached average block import rate excluding import time.
+    /// The current cached average block receipt rate.
     performance rate() const;
 
-    /// The current cached average block import rate excluding import time.
+    /// The current cached average block receipt rate.
     void set_rate(const performance& rate);
 
-    /// The block data request message for the outstanding block hashes.
+    /// The block data request message to refill the in-flight window.
     /// Set new if the preceding request was unsuccessful or discarded.
     message::get_data request(bool new_channel);
 
@@ -89,15 +103,19 @@ public:
     /// Add the block hash to the reservation.
     void insert(const hash_digest& hash, size_t height);
 
-    /// Add to the blockchain, with height determined by the reservation.
-    void import(chain::block::ptr block);
+    /// Remove the block hash from the reservation if found.
+    void erase(const hash_digest& hash);
 
-    /// Determine if the reservation was partitioned and reset partition flag.
-    bool toggle_partitioned();
+    /// Queue for the blockchain, with height determined by the reservation.
+    void import(chain::block::ptr block);
 
-    /// Move half of the reservation to the specified reservation.
+    /// Move unrequested hashes to the specified reservation, in proportion
+    /// to the receipt rates of the two reservations.
     bool partition(reservation::ptr minimal);
 
+    /// Copy up to limit of the oldest in-flight hashes, for re-request.
+    entries stragglers(size_t limit) const;
+
     /// If not stopped and if empty try to get more hashes.
     void populate();
 
@@ -115,6 +133,8 @@ protected:
     virtual std::chrono::high_resolution_clock::time_point now() const;
 
 private:
+    typedef std::chrono::high_resolution_clock::time_point time_point;
+    typedef std::unordered_map<hash_digest, time_point> request_times;
     typedef struct
     {
         size_t events;
@@ -133,7 +153,15 @@ private:
     void clear_history();
 
     // Get the height of the block hash, remove and return true if it is found.
-    bool find_height_and_erase(const hash_digest& hash, uint32_t& out_height);
+    bool find_height_and_erase(const hash_digest& hash, uint32_t& out_height,
+        std::chrono::microseconds& out_latency);
+
+    // Reduce the latency estimate to the given response time if lower.
+    void update_latency(const std::chrono::microseconds& latency);
+
+    // Log the completion of a queued import.
+    void handle_import(bool success, const std::chrono::microseconds& cost,
+        size_t height, const std::string& encoded);
 
     // Update rate history to reflect an additional block of the given size.
     void update_rate(size_t events, const std::chrono::microseconds& database);
@@ -143,6 +171,7 @@ private:
 
     // Protected by rate mutex.
     performance rate_;
+    std::chrono::microseconds latency_;
     mutable upgrade_mutex rate_mutex_;
 
     // Protected by history mutex.
@@ -155,12 +184,13 @@ private:
 
     // Protected by hash mutex.
     bool pending_;
-    bool partitioned_;
     hash_heights heights_;
+    request_times requested_;
     mutable upgrade_mutex hash_mutex_;
 
     const size_t slot_;
     const std::chrono::microseconds rate_window_;
+    const std::chrono::microseconds stall_timeout_;
 };
 
 } // namespace node
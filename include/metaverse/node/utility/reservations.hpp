@@ -21,9 +21,12 @@
 #define MVS_NODE_RESERVATIONS_HPP
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <metaverse/blockchain.hpp>
 #include <metaverse/node/define.hpp>
@@ -46,22 +49,38 @@ public:
     } rate_statistics;
 
     typedef std::shared_ptr<reservations> ptr;
+    typedef std::function<void(bool, const std::chrono::microseconds&)>
+        import_handler;
+    typedef std::function<void()> drain_handler;
 
     /// Construct a reservation table of reservations, allocating hashes evenly
     /// among the rows up to the limit of a single get headers p2p request.
-    reservations(header_queue& hashes, blockchain::simple_chain& chain,
-        const settings& settings);
+    reservations(threadpool& pool, header_queue& hashes,
+        blockchain::simple_chain& chain, const settings& settings);
 
-    /// The average and standard deviation of block import rates.
+    /// The average and standard deviation of block receipt rates.
     rate_statistics rates() const;
 
     /// Return a copy of the reservation table.
     reservation::list table() const;
 
-    /// Import the given block to the blockchain at the specified height.
-    bool import(chain::block::ptr block, size_t height);
+    /// Queue the given block for import to the blockchain at the specified
+    /// height, so that the receiving channel is not blocked on the store.
+    void import(chain::block::ptr block, size_t height,
+        import_handler handler);
 
-    /// Populate a starved row by taking half of the hashes from a weak row.
+    /// True if the import queue is too deep to request more blocks.
+    bool saturated();
+
+    /// End the sync, invoking the handler once all queued imports are written.
+    void drain(drain_handler handler);
+
+    /// Claim a received block for import, false if already claimed by a
+    /// duplicate request, and remove it from the other reservations.
+    bool claim(const hash_digest& hash, reservation::ptr owner);
+
+    /// Populate a starved row from unreserved hashes, from the slowest row
+    /// or, when none remain, by duplicating the oldest in-flight requests.
     bool populate(reservation::ptr minimal);
 
     /// Remove the row from the reservation table if found.
@@ -86,12 +105,15 @@ private:
     // Mark hashes for blocks we already have.
     void mark_existing();
 
-    // Find the reservation with the most hashes.
-    reservation::ptr find_maximal();
+    // Find the reservation expected to finish last at its current rate.
+    reservation::ptr find_slowest(reservation::ptr minimal);
 
-    // Move half of the maximal reservation to the specified reservation.
+    // Move hashes of the slowest reservation to the specified reservation.
     bool partition(reservation::ptr minimal);
 
+    // Copy the stragglers of the most delayed reservation to the specified.
+    bool duplicate(reservation::ptr minimal);
+
     // Move the maximum unreserved hashes to the specified reservation.
     bool reserve(reservation::ptr minimal);
 
@@ -103,6 +125,14 @@ private:
     reservation::list table_;
     mutable upgrade_mutex mutex_;
 
+    // Protected by claim mutex, the claimed state of duplicated hashes.
+    std::unordered_map<hash_digest, bool> duplicates_;
+    std::atomic<bool> endgame_;
+    mutable upgrade_mutex claim_mutex_;
+
+    // Imports are ordered on the dispatcher, independent of the channels.
+    dispatcher dispatch_;
+
     const uint32_t timeout_;
     std::atomic<size_t> max_request_;
 };
@@ -0,0 +1,295 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse-server.
+ *
+ * metaverse-server is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MVS_SERVER_PREFIX_NOTIFIER_IPP
+#define MVS_SERVER_PREFIX_NOTIFIER_IPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <metaverse/bitcoin.hpp>
+
+namespace libbitcoin {
+namespace server {
+
+template <typename... Args>
+prefix_notifier<Args...>::prefix_notifier(threadpool& pool, size_t limit,
+    const std::string& class_name)
+  : limit_(limit), stopped_(true), size_(0), dispatch_(pool, class_name)
+{
+}
+
+template <typename... Args>
+prefix_notifier<Args...>::~prefix_notifier()
+{
+    BITCOIN_ASSERT_MSG(size_ == 0, "prefix notifier not cleared");
+}
+
+template <typename... Args>
+void prefix_notifier<Args...>::start()
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(subscribe_mutex_);
+
+    stopped_ = false;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+template <typename... Args>
+void prefix_notifier<Args...>::stop()
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(subscribe_mutex_);
+
+    stopped_ = true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+template <typename... Args>
+void prefix_notifier<Args...>::subscribe(handler handler,
+    const route& reply_to, const binary& prefix_filter,
+    const asio::duration& duration, Args... stopped_args)
+{
+    const auto expires = asio::steady_clock::now() + duration;
+    const auto subscription = std::make_pair(reply_to, prefix_filter);
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    subscribe_mutex_.lock();
+
+    if (!stopped_)
+    {
+        const auto length = lengths_.find(prefix_filter.size());
+        if (length != lengths_.end())
+        {
+            const auto filter = length->second.find(prefix_filter);
+            if (filter != length->second.end())
+            {
+                const auto it = filter->second.find(reply_to);
+                if (it != filter->second.end())
+                {
+                    expirations_.erase(it->second.expires);
+                    it->second.expires = expirations_.emplace(expires,
+                        subscription);
+
+                    subscribe_mutex_.unlock();
+                    //---------------------------------------------------------
+                    return;
+                }
+            }
+        }
+
+        if (limit_ == 0 || size_ < limit_)
+        {
+            const auto expiration = expirations_.emplace(expires,
+                subscription);
+            lengths_[prefix_filter.size()][prefix_filter].emplace(reply_to,
+                value{ handler, expiration });
+            ++size_;
+
+            subscribe_mutex_.unlock();
+            //-----------------------------------------------------------------
+            return;
+        }
+    }
+
+    subscribe_mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Limit exceeded and stopped share the same return arguments.
+    handler(stopped_args...);
+}
+
+template <typename... Args>
+void prefix_notifier<Args...>::unsubscribe(const route& reply_to,
+    const binary& prefix_filter, Args... unsubscribed_args)
+{
+    handler handler;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    subscribe_mutex_.lock();
+
+    const auto found = !stopped_ &&
+        erase(std::make_pair(reply_to, prefix_filter), handler);
+
+    subscribe_mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    if (found)
+        handler(unsubscribed_args...);
+}
+
+template <typename... Args>
+void prefix_notifier<Args...>::purge(Args... expired_args)
+{
+    const auto now = asio::steady_clock::now();
+    std::vector<handler> expired;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    subscribe_mutex_.lock();
+
+    // Expirations are ordered, stop at the first unexpired subscription.
+    while (!expirations_.empty() && expirations_.begin()->first < now)
+    {
+        handler handler;
+        const auto subscription = expirations_.begin()->second;
+
+        if (erase(subscription, handler))
+            expired.push_back(handler);
+        else
+            expirations_.erase(expirations_.begin());
+    }
+
+    subscribe_mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    for (const auto& handler: expired)
+        handler(expired_args...);
+}
+
+template <typename... Args>
+void prefix_notifier<Args...>::invoke(Args... args)
+{
+    // Critical Section (prevent concurrent handler execution)
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(invoke_mutex_);
+
+    lengths lengths;
+
+    // Critical Section (protect stop)
+    ///////////////////////////////////////////////////////////////////////////
+    subscribe_mutex_.lock();
+
+    std::swap(lengths, lengths_);
+    expirations_.clear();
+    size_ = 0;
+
+    subscribe_mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    for (const auto& length: lengths)
+        for (const auto& filter: length.second)
+            for (const auto& route: filter.second)
+                route.second.notify(args...);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+template <typename... Args>
+void prefix_notifier<Args...>::relay(const binary& field, Args... args)
+{
+    // This enqueues work while maintaining order.
+    dispatch_.ordered(&prefix_notifier<Args...>::do_relay,
+        this->shared_from_this(), field, args...);
+}
+
+// private
+template <typename... Args>
+void prefix_notifier<Args...>::do_relay(const binary& field, Args... args)
+{
+    // Critical Section (prevent concurrent handler execution)
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(invoke_mutex_);
+
+    matches matched;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    subscribe_mutex_.lock_shared();
+
+    // Lengths are ordered, none beyond the field length can match.
+    for (const auto& length: lengths_)
+    {
+        if (length.first > field.size())
+            break;
+
+        const binary prefix(length.first, field.blocks());
+        const auto filter = length.second.find(prefix);
+
+        if (filter == length.second.end())
+            continue;
+
+        for (const auto& route: filter->second)
+            matched.emplace_back(std::make_pair(route.first, prefix),
+                route.second.notify);
+    }
+
+    subscribe_mutex_.unlock_shared();
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Subscriptions may be created while this loop is executing.
+    // A handler that returns false is removed.
+    for (const auto& match: matched)
+    {
+        if (match.second(args...))
+            continue;
+
+        handler handler;
+
+        // Critical Section
+        ///////////////////////////////////////////////////////////////////
+        unique_lock lock(subscribe_mutex_);
+        erase(match.first, handler);
+        ///////////////////////////////////////////////////////////////////
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// Remove the subscription and any emptied filter or length entry.
+template <typename... Args>
+bool prefix_notifier<Args...>::erase(const key& key, handler& out_handler)
+{
+    const auto& filter_key = key.second;
+    const auto length = lengths_.find(filter_key.size());
+    if (length == lengths_.end())
+        return false;
+
+    const auto filter = length->second.find(filter_key);
+    if (filter == length->second.end())
+        return false;
+
+    const auto it = filter->second.find(key.first);
+    if (it == filter->second.end())
+        return false;
+
+    out_handler = it->second.notify;
+    expirations_.erase(it->second.expires);
+    filter->second.erase(it);
+    --size_;
+
+    if (filter->second.empty())
+        length->second.erase(filter);
+
+    if (length->second.empty())
+        lengths_.erase(length);
+
+    return true;
+}
+
+} // namespace server
+} // namespace libbitcoin
+
+#endif
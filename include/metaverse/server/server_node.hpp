@@ -74,6 +74,9 @@ public:
     /// Server configuration settings.
     virtual const settings& server_settings() const;
 
+    /// Threadpool of query execution, the network pool if not dedicated.
+    virtual threadpool& query_executor();
+
     // Run sequence.
     // ------------------------------------------------------------------------
 
@@ -145,6 +148,7 @@ private:
     transaction_service public_transaction_service_;
     notification_worker secure_notification_worker_;
     notification_worker public_notification_worker_;
+    threadpool query_pool_;
 };
 
 } // namespace server
@@ -41,6 +41,10 @@ public:
 
     /// Properties.
     uint16_t query_workers;
+    uint16_t query_pipeline;
+    uint16_t query_batch;
+    uint16_t query_threads;
+    std::vector<uint32_t> query_processors;
     uint32_t heartbeat_interval_seconds;
     uint32_t subscription_expiration_minutes;
     uint32_t subscription_limit;
@@ -50,6 +54,7 @@ public:
     std::string rpc_version;
     bool administrator_required;
     bool secure_only;
+    bool rpc_compact_json;
 
     bool query_service_enabled;
     bool heartbeat_service_enabled;
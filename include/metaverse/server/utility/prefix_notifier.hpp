@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse-server.
+ *
+ * metaverse-server is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MVS_SERVER_PREFIX_NOTIFIER_HPP
+#define MVS_SERVER_PREFIX_NOTIFIER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <metaverse/bitcoin.hpp>
+#include <metaverse/server/define.hpp>
+#include <metaverse/server/messages/route.hpp>
+
+namespace libbitcoin {
+namespace server {
+
+/// This class is thread safe.
+/// Subscriptions keyed by route and binary prefix filter. Filters are held
+/// in a table by bit length, so a relayed field is matched against all
+/// subscriptions with one lookup per distinct filter length, and only the
+/// matching handlers are invoked. Expirations are ordered, so that a purge
+/// visits only the expired subscriptions.
+template <typename... Args>
+class prefix_notifier
+  : public enable_shared_from_base<prefix_notifier<Args...>>
+{
+public:
+    typedef std::function<bool (Args...)> handler;
+    typedef std::shared_ptr<prefix_notifier<Args...>> ptr;
+
+    /// Construct an instance.
+    /// A limit of zero is unlimited, the class_name is for debugging.
+    prefix_notifier(threadpool& pool, size_t limit,
+        const std::string& class_name);
+    ~prefix_notifier();
+
+    /// Enable new subscriptions.
+    void start();
+
+    /// Prevent new subscriptions.
+    void stop();
+
+    /// Subscribe to notifications for fields matching the prefix filter.
+    /// Return true from the handler to remain subscribed.
+    /// If the key is matched the existing subscription is extended.
+    /// If stopped or full this invokes the hander with the specified args.
+    void subscribe(handler handler, const route& reply_to,
+        const binary& prefix_filter, const asio::duration& duration,
+        Args... stopped_args);
+
+    /// Remove the subscription matching the specified key.
+    /// If subscribed this invokes notification with the specified args.
+    void unsubscribe(const route& reply_to, const binary& prefix_filter,
+        Args... unsubscribed_args);
+
+    /// Remove expired subscriptions (blocking).
+    /// Invokes expiration notification with the specified arguments.
+    void purge(Args... expired_args);
+
+    /// Invoke and remove all handlers sequentially (blocking).
+    void invoke(Args... args);
+
+    /// Invoke the handlers whose filter prefixes field (non-blocking).
+    void relay(const binary& field, Args... args);
+
+private:
+    typedef std::pair<route, binary> key;
+    typedef std::multimap<asio::time_point, key> expirations;
+    typedef struct { handler notify; typename expirations::iterator expires; }
+        value;
+    typedef std::unordered_map<route, value> routes;
+    typedef std::unordered_map<binary, routes> filters;
+    typedef std::map<size_t, filters> lengths;
+    typedef std::vector<std::pair<key, handler>> matches;
+
+    void do_relay(const binary& field, Args... args);
+    bool erase(const key& key, handler& out_handler);
+
+    const size_t limit_;
+    bool stopped_;
+    size_t size_;
+    lengths lengths_;
+    expirations expirations_;
+    dispatcher dispatch_;
+    mutable upgrade_mutex invoke_mutex_;
+    mutable upgrade_mutex subscribe_mutex_;
+};
+
+} // namespace server
+} // namespace libbitcoin
+
+#include <metaverse/server/impl/utility/prefix_notifier.ipp>
+
+#endif
@@ -29,6 +29,7 @@
 #include <metaverse/server/messages/route.hpp>
 #include <metaverse/server/settings.hpp>
 #include <metaverse/server/utility/address_key.hpp>
+#include <metaverse/server/utility/prefix_notifier.hpp>
 
 namespace libbitcoin {
 namespace server {
@@ -75,17 +76,17 @@ private:
     typedef std::shared_ptr<uint8_t> sequence_ptr;
     typedef bc::message::block_message::ptr_list block_list;
 
-    typedef notifier<address_key, const code&,
-        const wallet::payment_address&, int32_t, const hash_digest&,
-        const chain::transaction&> payment_subscriber;
-    typedef notifier<address_key, const code&, uint32_t, uint32_t,
+    typedef prefix_notifier<const code&, const wallet::payment_address&,
+        int32_t, const hash_digest&, const chain::transaction&>
+        payment_subscriber;
+    typedef prefix_notifier<const code&, uint32_t, uint32_t,
         const hash_digest&, const chain::transaction&> stealth_subscriber;
-    typedef notifier<address_key, const code&, const binary&, uint32_t,
+    typedef prefix_notifier<const code&, const binary&, uint32_t,
         const hash_digest&, const chain::transaction&> address_subscriber;
     typedef notifier<address_key, const code&, uint32_t,
         const hash_digest&, const hash_digest&> penetration_subscriber;
 
-    // Remove expired subscriptions.
+    // Remove expired subscriptions, visiting only those expired.
     void purge();
     int32_t purge_interval_milliseconds() const;
 
@@ -103,11 +104,12 @@ private:
         const chain::transaction& tx);
 
     // v2/v3 (deprecated)
-    void notify_payment(const wallet::payment_address& address,
+    void notify_payment(const binary& field,
+        const wallet::payment_address& address, uint32_t height,
+        const hash_digest& block_hash, const chain::transaction& tx);
+    void notify_stealth(const binary& field, uint32_t prefix,
         uint32_t height, const hash_digest& block_hash,
         const chain::transaction& tx);
-    void notify_stealth(uint32_t prefix, uint32_t height,
-        const hash_digest& block_hash, const chain::transaction& tx);
 
     // v3
     void notify_address(const binary& field, uint32_t height,
@@ -20,10 +20,14 @@
 #ifndef MVS_SERVER_QUERY_WORKER_HPP
 #define MVS_SERVER_QUERY_WORKER_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <deque>
 #include <memory>
 #include <functional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <metaverse/protocol.hpp>
 #include <metaverse/server/define.hpp>
 #include <metaverse/server/messages/message.hpp>
@@ -36,6 +40,9 @@ class server_node;
 
 // This class is thread safe.
 // Provide asynchronous query responses to the query service.
+// Queries are received in batches and executed on the thread pool, with up to
+// server.query_pipeline in flight. Responses are queued back to the worker
+// thread, which alone owns the router socket, and wake it over an inproc pair.
 class BCS_API query_worker
   : public bc::protocol::zmq::worker
 {
@@ -46,32 +53,72 @@ public:
     query_worker(bc::protocol::zmq::authenticator& authenticator,
         server_node& node, bool secure);
 
+    /// The number of queries received and neither answered nor abandoned.
+    size_t pending() const;
+
 protected:
     typedef bc::protocol::zmq::socket socket;
+    typedef bc::protocol::zmq::poller poller;
 
     typedef std::function<void(const message&, send_handler)> command_handler;
     typedef std::unordered_map<std::string, command_handler> command_map;
 
+    // Set by the first response, or by the worker once the query expires.
+    typedef std::shared_ptr<std::atomic<bool>> answer_ptr;
+
+    struct query_task
+    {
+        message request;
+        command_handler execute;
+        answer_ptr answered;
+    };
+
+    struct outstanding_query
+    {
+        asio::time_point expiry;
+        answer_ptr answered;
+    };
+
+    typedef std::vector<query_task> query_batch;
+
     virtual void attach_interface();
     virtual void attach(const std::string& command, command_handler handler);
 
     virtual bool connect(socket& router);
     virtual bool disconnect(socket& router);
-    virtual void query(socket& router);
+    virtual void query(socket& router, poller& poller);
+    virtual void respond(socket& router);
 
     // Implement the worker.
     virtual void work() override;
 
 private:
+    bool receive(socket& router, query_batch& batch);
+    void execute(const query_batch& batch);
+    bool open_signal(socket& wakeup, const config::endpoint& endpoint);
+    void close_signal();
+    void complete(message&& response, answer_ptr answered);
+    int32_t expire();
+
     const bool secure_;
     const server::settings& settings_;
 
     // These are thread safe.
     server_node& node_;
     bc::protocol::zmq::authenticator& authenticator_;
+    dispatcher dispatch_;
+    std::atomic<size_t> pending_;
 
     // This is protected by base class mutex.
     command_map command_handlers_;
+
+    // This is used only on the worker thread, in order of dispatch.
+    std::deque<outstanding_query> outstanding_;
+
+    // These are protected by mutex.
+    std::vector<message> responses_;
+    socket::ptr signal_;
+    mutable upgrade_mutex mutex_;
 };
 
 } // namespace server
@@ -56,7 +56,8 @@ void account_script::set_script(const data_chunk& script)
     script_ = script;
 }
 
-bool account_script::from_data(reader& source)
+template <typename Reader>
+bool account_script::from_data(Reader& source)
 {
     description_ = source.read_string();
     address_ = source.read_string();
@@ -65,7 +66,8 @@ bool account_script::from_data(reader& source)
     return !address_.empty();
 }
 
-void account_script::to_data(writer& sink) const
+template <typename Writer>
+void account_script::to_data(Writer& sink) const
 {
     sink.write_string(description_);
     sink.write_string(address_);
@@ -165,7 +167,8 @@ void account_multisig::set_address(std::string& address) {
     address_ = address;
 }
 
-bool account_multisig::from_data(reader& source)
+template <typename Reader>
+bool account_multisig::from_data(Reader& source)
 {
     hd_index_ = source.read_4_bytes_little_endian();
     index_ = source.read_4_bytes_little_endian();
@@ -183,7 +186,8 @@ bool account_multisig::from_data(reader& source)
     return true;
 }
 
-void account_multisig::to_data(writer& sink) const
+template <typename Writer>
+void account_multisig::to_data(Writer& sink) const
 {
     sink.write_4_bytes_little_endian(hd_index_);
     sink.write_4_bytes_little_endian(index_);
@@ -310,7 +314,8 @@ void account::reset()
     this->status = account_status::normal;
 }
 
-bool account::from_data_t(reader& source)
+template <typename Reader>
+bool account::from_data_t(Reader& source)
 {
     reset();
     name = source.read_string();
@@ -349,7 +354,8 @@ bool account::from_data_t(reader& source)
     return true;
 }
 
-void account::to_data_t(writer& sink) const
+template <typename Writer>
+void account::to_data_t(Writer& sink) const
 {
     sink.write_string(name);
     sink.write_string(mnemonic);
@@ -614,5 +620,11 @@ std::shared_ptr<account_script::list> account::get_script(const std::string& add
     return acc_vec;
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool account::from_data_t(reader& source);
+template bool account::from_data_t(span_reader& source);
+template void account::to_data_t(writer& sink) const;
+template void account::to_data_t(span_writer& sink) const;
+
 } // namspace chain
 } // namspace libbitcoin
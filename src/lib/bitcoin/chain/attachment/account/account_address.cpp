@@ -81,7 +81,8 @@ void account_address::reset()
 
 
 
-bool account_address::from_data_t(reader& source)
+template <typename Reader>
+bool account_address::from_data_t(Reader& source)
 {
     reset();
     name = source.read_fixed_string(ADDRESS_NAME_FIX_SIZE);
@@ -104,7 +105,8 @@ bool account_address::from_data_t(reader& source)
 }
 
 
-void account_address::to_data_t(writer& sink) const
+template <typename Writer>
+void account_address::to_data_t(Writer& sink) const
 {
     sink.write_fixed_string(name, ADDRESS_NAME_FIX_SIZE);
     //sink.write_fixed_string(prv_key, ADDRESS_PRV_KEY_FIX_SIZE);
@@ -228,5 +230,11 @@ void account_address::set_status(uint8_t status)
     status_ = status;
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool account_address::from_data_t(reader& source);
+template bool account_address::from_data_t(span_reader& source);
+template void account_address::to_data_t(writer& sink) const;
+template void account_address::to_data_t(span_writer& sink) const;
+
 } // namspace chain
 } // namspace libbitcoin
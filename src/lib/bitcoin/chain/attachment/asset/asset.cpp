@@ -64,7 +64,8 @@ bool asset::is_valid_type() const
 }
 
 
-bool asset::from_data_t(reader& source)
+template <typename Reader>
+bool asset::from_data_t(Reader& source)
 {
     reset();
 
@@ -84,7 +85,7 @@ bool asset::from_data_t(reader& source)
                 break;
             }
         }
-        auto visitor = from_data_visitor(source);
+        auto visitor = from_data_visitor<Reader>(source);
         result = boost::apply_visitor(visitor, data);
     }
     else {
@@ -95,11 +96,12 @@ bool asset::from_data_t(reader& source)
     return result;
 }
 
-void asset::to_data_t(writer& sink) const
+template <typename Writer>
+void asset::to_data_t(Writer& sink) const
 {
     sink.write_4_bytes_little_endian(status);
 
-    auto visitor = to_data_visitor(sink);
+    auto visitor = to_data_visitor<Writer>(sink);
     boost::apply_visitor(visitor, data);
 }
 
@@ -146,5 +148,11 @@ const asset::asset_data_type& asset::get_data() const
     return this->data;
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool asset::from_data_t(reader& source);
+template bool asset::from_data_t(span_reader& source);
+template void asset::to_data_t(writer& sink) const;
+template void asset::to_data_t(span_writer& sink) const;
+
 } // namspace chain
 } // namspace libbitcoin
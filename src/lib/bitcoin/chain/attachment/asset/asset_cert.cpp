@@ -109,7 +109,8 @@ std::string asset_cert::asset_cert::get_key() const
     return get_key(symbol_, cert_type_);
 }
 
-bool asset_cert::from_data_t(reader& source)
+template <typename Reader>
+bool asset_cert::from_data_t(Reader& source)
 {
     reset();
     symbol_ = source.read_string();
@@ -129,7 +130,8 @@ bool asset_cert::from_data_t(reader& source)
     return result;
 }
 
-void asset_cert::to_data_t(writer& sink) const
+template <typename Writer>
+void asset_cert::to_data_t(Writer& sink) const
 {
     sink.write_string(symbol_);
     sink.write_string(owner_);
@@ -512,5 +514,11 @@ bool asset_cert::is_secondary_witness() const
     return (cert_type_ == asset_cert_ns::witness && is_valid_secondary_witness(symbol_));
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool asset_cert::from_data_t(reader& source);
+template bool asset_cert::from_data_t(span_reader& source);
+template void asset_cert::to_data_t(writer& sink) const;
+template void asset_cert::to_data_t(span_writer& sink) const;
+
 } // namspace chain
 } // namspace libbitcoin
@@ -69,7 +69,8 @@ void asset_detail::reset()
     description = "";
 }
 
-bool asset_detail::from_data_t(reader& source)
+template <typename Reader>
+bool asset_detail::from_data_t(Reader& source)
 {
     reset();
 
@@ -91,7 +92,8 @@ bool asset_detail::from_data_t(reader& source)
 }
 
 
-void asset_detail::to_data_t(writer& sink) const
+template <typename Writer>
+void asset_detail::to_data_t(Writer& sink) const
 {
     sink.write_string(symbol);
     sink.write_8_bytes_little_endian(maximum_supply);
@@ -266,5 +268,11 @@ bool asset_detail::is_secondaryissue_owns_enough(uint64_t own, uint64_t total, u
     return (value_needed == 0) || (own >= value_needed -1); // allow 1 inaccurate
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool asset_detail::from_data_t(reader& source);
+template bool asset_detail::from_data_t(span_reader& source);
+template void asset_detail::to_data_t(writer& sink) const;
+template void asset_detail::to_data_t(span_writer& sink) const;
+
 } // namspace chain
 } // namspace libbitcoin
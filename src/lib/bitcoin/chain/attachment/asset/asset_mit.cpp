@@ -71,7 +71,8 @@ bool asset_mit::operator< (const asset_mit& other) const
     return symbol_.compare(other.symbol_) < 0;
 }
 
-bool asset_mit::from_data_t(reader& source)
+template <typename Reader>
+bool asset_mit::from_data_t(Reader& source)
 {
     reset();
 
@@ -103,7 +104,8 @@ data_chunk asset_mit::to_short_data() const
 }
 
 
-void asset_mit::to_data_t(writer& sink) const
+template <typename Writer>
+void asset_mit::to_data_t(Writer& sink) const
 {
     sink.write_byte(status_);
     sink.write_string(symbol_);
@@ -287,5 +289,11 @@ data_chunk asset_mit_info::to_short_data() const
     return data;
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool asset_mit::from_data_t(reader& source);
+template bool asset_mit::from_data_t(span_reader& source);
+template void asset_mit::to_data_t(writer& sink) const;
+template void asset_mit::to_data_t(span_writer& sink) const;
+
 } // namspace chain
 } // namspace libbitcoin
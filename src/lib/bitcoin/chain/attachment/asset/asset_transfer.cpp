@@ -60,7 +60,8 @@ void asset_transfer::reset()
     quantity = 0;
 }
 
-bool asset_transfer::from_data_t(reader& source)
+template <typename Reader>
+bool asset_transfer::from_data_t(Reader& source)
 {
     reset();
     symbol = source.read_string();
@@ -74,7 +75,8 @@ bool asset_transfer::from_data_t(reader& source)
 }
 
 
-void asset_transfer::to_data_t(writer& sink) const
+template <typename Writer>
+void asset_transfer::to_data_t(Writer& sink) const
 {
     sink.write_string(symbol);
     sink.write_8_bytes_little_endian(quantity);
@@ -115,6 +117,11 @@ void asset_transfer::set_quantity(uint64_t quantity)
      this->quantity = quantity;
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool asset_transfer::from_data_t(reader& source);
+template bool asset_transfer::from_data_t(span_reader& source);
+template void asset_transfer::to_data_t(writer& sink) const;
+template void asset_transfer::to_data_t(span_writer& sink) const;
 
 } // namspace chain
 } // namspace libbitcoin
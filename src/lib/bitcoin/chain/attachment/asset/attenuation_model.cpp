@@ -22,6 +22,7 @@
 #include <metaverse/bitcoin/utility/string.hpp>
 #include <metaverse/blockchain/block_chain_impl.hpp>
 #include <metaverse/blockchain/validate_transaction.hpp>
+#include <array>
 #include <unordered_map>
 #include <memory>
 
@@ -30,6 +31,7 @@ namespace chain {
 
 static BC_CONSTEXPR uint64_t max_inflation_rate = 100000;
 static BC_CONSTEXPR uint64_t max_unlock_number = 100;
+static BC_CONSTEXPR size_t max_compiled_models = 10000;
 
 namespace {
     const char* LOG_HEADER{"attenuation_model"};
@@ -96,6 +98,7 @@ namespace {
 
 } // end of anonymous namespace
 
+// Parsed once into fixed slots, then immutable and shared between models.
 class attenuation_model::impl
 {
 public:
@@ -103,7 +106,7 @@ public:
         : model_param_(param)
     {
         if (!parse_param(is_init)) {
-            map_.clear();
+            clear();
         }
     }
 
@@ -168,15 +171,15 @@ public:
 
 private:
     bool validate_keys(model_type model, const std::vector<std::string>& keys) {
-        if (map_.size() != keys.size()) {
-            log::debug(LOG_HEADER) << "The size of keys " << map_.size()
+        if (key_count() != keys.size()) {
+            log::debug(LOG_HEADER) << "The size of keys " << key_count()
                 << " for model type " << std::to_string(to_index(model))
                 << " does not equal " << keys.size();
             return false;
         }
 
         for (size_t i = 0; i < keys.size(); ++i) {
-            if (map_.find(keys[i]) == map_.end()) {
+            if (!has_key(keys[i])) {
                 log::debug(LOG_HEADER) << "model type " << std::to_string(to_index(model))
                     << " needs key " << keys[i] << " but missed.";
                 return false;
@@ -254,7 +257,7 @@ private:
                     return false;
                 }
 
-                if (map_.find(key) != map_.end()) {
+                if (has_key(key)) {
                     log::debug(LOG_HEADER) << "key-value format is wrong, duplicate key : " << key;
                     return false;
                 }
@@ -288,7 +291,7 @@ private:
                         }
                     }
 
-                    map_[key] = std::move(num_vec);
+                    set_key(key, std::move(num_vec));
                 }
                 catch (const std::exception& e) {
                     log::debug(LOG_HEADER) << "exception caught: " << e.what();
@@ -308,23 +311,79 @@ private:
         return true;
     }
 
+    enum key_slot : uint8_t
+    {
+        slot_pn, slot_lh, slot_type, slot_lq, slot_lp, slot_un, slot_ir,
+        slot_uc, slot_uq, slot_unknown
+    };
+
+    static key_slot to_slot(const std::string& key) {
+        static const std::unordered_map<std::string, key_slot> slots{
+            {"PN", slot_pn}, {"LH", slot_lh}, {"TYPE", slot_type},
+            {"LQ", slot_lq}, {"LP", slot_lp}, {"UN", slot_un},
+            {"IR", slot_ir}, {"UC", slot_uc}, {"UQ", slot_uq}
+        };
+        auto iter = slots.find(key);
+        return iter == slots.end() ? slot_unknown : iter->second;
+    }
+
+    bool has_key(const std::string& key) const {
+        const auto slot = to_slot(key);
+        if (slot == slot_unknown) {
+            return std::find(unknown_keys_.begin(), unknown_keys_.end(), key)
+                != unknown_keys_.end();
+        }
+        return (present_ & (1u << slot)) != 0;
+    }
+
+    size_t key_count() const {
+        size_t count = unknown_keys_.size();
+        for (auto bits = present_; bits != 0; bits &= bits - 1) {
+            ++count;
+        }
+        return count;
+    }
+
+    void set_key(const std::string& key, std::vector<uint64_t>&& values) {
+        const auto slot = to_slot(key);
+        if (slot == slot_unknown) {
+            unknown_keys_.push_back(key);
+            return;
+        }
+
+        present_ |= (1u << slot);
+        if (slot == slot_uc) {
+            unlock_cycles_ = std::move(values);
+        }
+        else if (slot == slot_uq) {
+            unlocked_quantities_ = std::move(values);
+        }
+        else {
+            numbers_[slot] = values.front();
+        }
+    }
+
+    void clear() {
+        present_ = 0;
+        numbers_.fill(0);
+        unlock_cycles_.clear();
+        unlocked_quantities_.clear();
+        unknown_keys_.clear();
+    }
+
     template<typename T = uint64_t>
     T getnumber(const std::string& key) const {
         BITCOIN_ASSERT(!attenuation_model::is_multi_value_key(key));
-        auto iter = map_.find(key);
-        if (iter == map_.end()) {
+        const auto slot = to_slot(key);
+        if (slot >= numbers_.size()) {
             return 0;
         }
-        return iter->second[0];
+        return numbers_[slot];
     }
 
     const std::vector<uint64_t>& get_numbers(const std::string& key) const {
         BITCOIN_ASSERT(attenuation_model::is_multi_value_key(key));
-        auto iter = map_.find(key);
-        if (iter == map_.end()) {
-            return empty_num_vec;
-        }
-        return iter->second;
+        return to_slot(key) == slot_uc ? unlock_cycles_ : unlocked_quantities_;
     }
 
 private:
@@ -340,15 +399,59 @@ private:
     // "PN=0;LH=1000;TYPE=3;LQ=20000000;LP=12000;UN=12;IR=8"
     std::string model_param_;
 
-    // auxilary data
-    std::unordered_map<std::string, std::vector<uint64_t>> map_;
-    static const std::vector<uint64_t> empty_num_vec;
+    // auxilary data, unset keys read as zero or empty.
+    uint16_t present_{0};
+    std::array<uint64_t, slot_uc> numbers_{};
+    std::vector<uint64_t> unlock_cycles_;
+    std::vector<uint64_t> unlocked_quantities_;
+    std::vector<std::string> unknown_keys_;
 };
 
-const std::vector<uint64_t> attenuation_model::impl::empty_num_vec;
+std::shared_ptr<const attenuation_model::impl> attenuation_model::compile(
+    const std::string& param, bool is_init)
+{
+    typedef std::pair<std::string, bool> compiled_key;
+    struct compiled_key_hash {
+        size_t operator()(const compiled_key& key) const {
+            return std::hash<std::string>()(key.first) ^ key.second;
+        }
+    };
+
+    static shared_mutex mutex;
+    static std::unordered_map<compiled_key, std::shared_ptr<const impl>,
+        compiled_key_hash> compiled;
+
+    compiled_key key{param, is_init};
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    {
+        shared_lock lock(mutex);
+        auto iter = compiled.find(key);
+        if (iter != compiled.end()) {
+            return iter->second;
+        }
+    }
+    ///////////////////////////////////////////////////////////////////////////
+
+    auto model = std::make_shared<const impl>(param, is_init);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex);
+
+    // Params are unbounded, so start over rather than grow without limit.
+    if (compiled.size() >= max_compiled_models) {
+        compiled.clear();
+    }
+
+    compiled.emplace(std::move(key), model);
+    return model;
+    ///////////////////////////////////////////////////////////////////////////
+}
 
 attenuation_model::attenuation_model(const std::string& param, bool is_init)
-    : pimpl(std::make_unique<impl>(param, is_init))
+    : pimpl(compile(param, is_init))
 {
 }
 
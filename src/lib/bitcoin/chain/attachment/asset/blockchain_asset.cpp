@@ -53,7 +53,8 @@ void blockchain_asset::reset()
 }
 
 
-bool blockchain_asset::from_data_t(reader& source)
+template <typename Reader>
+bool blockchain_asset::from_data_t(Reader& source)
 {
     reset();
 
@@ -66,7 +67,8 @@ bool blockchain_asset::from_data_t(reader& source)
 }
 
 
-void blockchain_asset::to_data_t(writer& sink) const
+template <typename Writer>
+void blockchain_asset::to_data_t(Writer& sink) const
 {
     sink.write_4_bytes_little_endian(version_);
     tx_point_.to_data(sink);
@@ -129,7 +131,11 @@ void blockchain_asset::set_asset(const asset_detail& asset_)
      this->asset_ = asset_;
 }
 
-
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool blockchain_asset::from_data_t(reader& source);
+template bool blockchain_asset::from_data_t(span_reader& source);
+template void blockchain_asset::to_data_t(writer& sink) const;
+template void blockchain_asset::to_data_t(span_writer& sink) const;
 
 } // namspace chain
 } // namspace libbitcoin
@@ -52,7 +52,8 @@ void blockchain_cert::reset()
     cert_ = asset_cert();
 }
 
-bool blockchain_cert::from_data_t(reader& source)
+template <typename Reader>
+bool blockchain_cert::from_data_t(Reader& source)
 {
     reset();
 
@@ -64,7 +65,8 @@ bool blockchain_cert::from_data_t(reader& source)
     return true;
 }
 
-void blockchain_cert::to_data_t(writer& sink) const
+template <typename Writer>
+void blockchain_cert::to_data_t(Writer& sink) const
 {
     sink.write_4_bytes_little_endian(version_);
     tx_point_.to_data(sink);
@@ -127,6 +129,11 @@ void blockchain_cert::set_cert(const asset_cert& cert_)
      this->cert_ = cert_;
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool blockchain_cert::from_data_t(reader& source);
+template bool blockchain_cert::from_data_t(span_reader& source);
+template void blockchain_cert::to_data_t(writer& sink) const;
+template void blockchain_cert::to_data_t(span_writer& sink) const;
 
 } // namspace chain
 } // namspace libbitcoin
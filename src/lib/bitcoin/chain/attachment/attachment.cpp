@@ -118,7 +118,8 @@ bool attachment::is_valid_type() const
         || (DID_TYPE == type));
 }
 
-bool attachment::from_data_t(reader& source)
+template <typename Reader>
+bool attachment::from_data_t(Reader& source)
 {
     reset();
 
@@ -173,7 +174,7 @@ bool attachment::from_data_t(reader& source)
             }
         }
 
-        auto visitor = from_data_visitor(source);
+        auto visitor = from_data_visitor<Reader>(source);
         result = boost::apply_visitor(visitor, attach);
     }
     else {
@@ -184,7 +185,8 @@ bool attachment::from_data_t(reader& source)
     return result;
 }
 
-void attachment::to_data_t(writer& sink) const
+template <typename Writer>
+void attachment::to_data_t(Writer& sink) const
 {
     sink.write_4_bytes_little_endian(version);
     sink.write_4_bytes_little_endian(type);
@@ -192,7 +194,7 @@ void attachment::to_data_t(writer& sink) const
         sink.write_string(todid);
         sink.write_string(fromdid);
     }
-    auto visitor = to_data_visitor(sink);
+    auto visitor = to_data_visitor<Writer>(sink);
     boost::apply_visitor(visitor, attach);
 }
 
@@ -279,5 +281,11 @@ const attachment::attachment_data_type& attachment::get_attach() const
     return this->attach;
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool attachment::from_data_t(reader& source);
+template bool attachment::from_data_t(span_reader& source);
+template void attachment::to_data_t(writer& sink) const;
+template void attachment::to_data_t(span_writer& sink) const;
+
 } // namspace chain
 } // namspace libbitcoin
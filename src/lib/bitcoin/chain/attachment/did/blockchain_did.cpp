@@ -54,7 +54,8 @@ void blockchain_did::reset()
 }
 
 
-bool blockchain_did::from_data_t(reader& source)
+template <typename Reader>
+bool blockchain_did::from_data_t(Reader& source)
 {
     reset();
 
@@ -68,7 +69,8 @@ bool blockchain_did::from_data_t(reader& source)
 }
 
 
-void blockchain_did::to_data_t(writer& sink) const
+template <typename Writer>
+void blockchain_did::to_data_t(Writer& sink) const
 {
     sink.write_4_bytes_little_endian(version_);
     tx_point_.to_data(sink);
@@ -160,5 +162,12 @@ std::string blockchain_did::get_status_string() const
 
     return strStatus;
 }
+
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool blockchain_did::from_data_t(reader& source);
+template bool blockchain_did::from_data_t(span_reader& source);
+template void blockchain_did::to_data_t(writer& sink) const;
+template void blockchain_did::to_data_t(span_writer& sink) const;
+
 } // namspace chain
 } // namspace libbitcoin
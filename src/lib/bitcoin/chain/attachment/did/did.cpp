@@ -56,7 +56,8 @@ bool did::is_valid_type() const
         || (DID_TRANSFERABLE_TYPE == status));
 }
 
-bool did::from_data_t(reader& source)
+template <typename Reader>
+bool did::from_data_t(Reader& source)
 {
     reset();
 
@@ -74,7 +75,8 @@ bool did::from_data_t(reader& source)
     return result;
 }
 
-void did::to_data_t(writer& sink) const
+template <typename Writer>
+void did::to_data_t(Writer& sink) const
 {
     sink.write_4_bytes_little_endian(status);
     data.to_data(sink);
@@ -111,5 +113,11 @@ const did_detail& did::get_data() const
     return this->data;
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool did::from_data_t(reader& source);
+template bool did::from_data_t(span_reader& source);
+template void did::to_data_t(writer& sink) const;
+template void did::to_data_t(span_writer& sink) const;
+
 } // namspace chain
 } // namspace libbitcoin
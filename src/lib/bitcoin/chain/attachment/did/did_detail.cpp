@@ -52,7 +52,8 @@ void did_detail::reset()
     address = "";
 }
 
-bool did_detail::from_data_t(reader& source)
+template <typename Reader>
+bool did_detail::from_data_t(Reader& source)
 {
     reset();
 
@@ -66,7 +67,8 @@ bool did_detail::from_data_t(reader& source)
     return result;
 }
 
-void did_detail::to_data_t(writer& sink) const
+template <typename Writer>
+void did_detail::to_data_t(Writer& sink) const
 {
     sink.write_string(symbol);
     sink.write_string(address);
@@ -131,5 +133,11 @@ std::string did_detail::get_blackhole_did_symbol()
     return "BLACKHOLE";
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool did_detail::from_data_t(reader& source);
+template bool did_detail::from_data_t(span_reader& source);
+template void did_detail::to_data_t(writer& sink) const;
+template void did_detail::to_data_t(span_writer& sink) const;
+
 } // namspace chain
 } // namspace libbitcoin
@@ -48,7 +48,8 @@ bool etp::is_valid() const
 }
 
 
-bool etp::from_data_t(reader& source)
+template <typename Reader>
+bool etp::from_data_t(Reader& source)
 {
     /*
     reset();
@@ -60,7 +61,8 @@ bool etp::from_data_t(reader& source)
     return true;
 }
 
-void etp::to_data_t(writer& sink) const
+template <typename Writer>
+void etp::to_data_t(Writer& sink) const
 {
     //sink.write_8_bytes_little_endian(value); // not use etp now
 }
@@ -89,5 +91,11 @@ void etp::set_value(uint64_t value)
     this->value = value;
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool etp::from_data_t(reader& source);
+template bool etp::from_data_t(span_reader& source);
+template void etp::to_data_t(writer& sink) const;
+template void etp::to_data_t(span_writer& sink) const;
+
 } // namspace chain
 } // namspace libbitcoin
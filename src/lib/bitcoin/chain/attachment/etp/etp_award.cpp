@@ -47,7 +47,8 @@ bool etp_award::is_valid() const
     return true;
 }
 
-bool etp_award::from_data_t(reader& source)
+template <typename Reader>
+bool etp_award::from_data_t(Reader& source)
 {
     reset();
     height = source.read_8_bytes_little_endian();
@@ -57,7 +58,8 @@ bool etp_award::from_data_t(reader& source)
 }
 
 
-void etp_award::to_data_t(writer& sink) const
+template <typename Writer>
+void etp_award::to_data_t(Writer& sink) const
 {
     sink.write_8_bytes_little_endian(height);
 }
@@ -85,5 +87,11 @@ void etp_award::set_height(uint64_t height)
     this->height = height;
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool etp_award::from_data_t(reader& source);
+template bool etp_award::from_data_t(span_reader& source);
+template void etp_award::to_data_t(writer& sink) const;
+template void etp_award::to_data_t(span_writer& sink) const;
+
 } // namspace chain
 } // namspace libbitcoin
@@ -50,7 +50,8 @@ bool blockchain_message::is_valid() const
             || variable_string_size(content_) + 1 > BLOCKCHAIN_MESSAGE_FIX_SIZE);
 }
 
-bool blockchain_message::from_data_t(reader& source)
+template <typename Reader>
+bool blockchain_message::from_data_t(Reader& source)
 {
     reset();
     content_ = source.read_string();
@@ -59,7 +60,8 @@ bool blockchain_message::from_data_t(reader& source)
     return result;
 }
 
-void blockchain_message::to_data_t(writer& sink) const
+template <typename Writer>
+void blockchain_message::to_data_t(Writer& sink) const
 {
     sink.write_string(content_);
 }
@@ -87,5 +89,11 @@ void blockchain_message::set_content(const std::string& content)
     content_ = limit_size_string(content, BLOCKCHAIN_MESSAGE_FIX_SIZE);
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool blockchain_message::from_data_t(reader& source);
+template bool blockchain_message::from_data_t(span_reader& source);
+template void blockchain_message::to_data_t(writer& sink) const;
+template void blockchain_message::to_data_t(span_writer& sink) const;
+
 } // namspace chain
 } // namspace libbitcoin
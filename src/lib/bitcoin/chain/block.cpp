@@ -109,7 +109,8 @@ bool block::is_proof_of_dpos() const
     return header.is_proof_of_dpos();
 }
 
-bool block::from_data_t(reader& source, bool with_transaction_count)
+template <typename Reader>
+bool block::from_data_t(Reader& source, bool with_transaction_count)
 {
     reset();
 
@@ -148,7 +149,8 @@ bool block::from_data_t(reader& source, bool with_transaction_count)
 }
 
 
-void block::to_data_t(writer& sink, bool with_transaction_count) const
+template <typename Writer>
+void block::to_data_t(Writer& sink, bool with_transaction_count) const
 {
     header.to_data(sink, with_transaction_count);
 
@@ -308,5 +310,13 @@ chain::block block::genesis_testnet()
     return genesis;
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool block::from_data_t(reader& source, bool with_transaction_count);
+template bool block::from_data_t(span_reader& source, bool with_transaction_count);
+template void block::to_data_t(writer& sink,
+    bool with_transaction_count) const;
+template void block::to_data_t(span_writer& sink,
+    bool with_transaction_count) const;
+
 } // namspace chain
 } // namspace libbitcoin
@@ -64,7 +64,8 @@ bool business_data::is_valid_type() const
             || (TYPE_DID_TRANSFER == KIND2UINT16(kind));
 }
 
-bool business_data::from_data_t(reader& source)
+template <typename Reader>
+bool business_data::from_data_t(Reader& source)
 {
     reset();
     kind = static_cast<business_kind>(source.read_2_bytes_little_endian());
@@ -121,7 +122,7 @@ bool business_data::from_data_t(reader& source)
                 break;
             }
         }
-        auto visitor = from_data_visitor(source);
+        auto visitor = from_data_visitor<Reader>(source);
         result = boost::apply_visitor(visitor, data);
     }
     else
@@ -134,11 +135,12 @@ bool business_data::from_data_t(reader& source)
 
 }
 
-void business_data::to_data_t(writer& sink)
+template <typename Writer>
+void business_data::to_data_t(Writer& sink)
 {
     sink.write_2_bytes_little_endian(KIND2UINT16(kind));
     sink.write_4_bytes_little_endian(timestamp);
-    auto visitor = to_data_visitor(sink);
+    auto visitor = to_data_visitor<Writer>(sink);
     boost::apply_visitor(visitor, data);
 }
 
@@ -181,5 +183,11 @@ uint32_t business_data::get_timestamp() const
     return timestamp;
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool business_data::from_data_t(reader& source);
+template bool business_data::from_data_t(span_reader& source);
+template void business_data::to_data_t(writer& sink);
+template void business_data::to_data_t(span_writer& sink);
+
 } // namspace chain
 } // namspace libbitcoin
@@ -155,7 +155,8 @@ void header::reset()
     mutex_.unlock();
 }
 
-bool header::from_data_t(reader& source, bool with_transaction_count)
+template <typename Reader>
+bool header::from_data_t(Reader& source, bool with_transaction_count)
 {
     reset();
 
@@ -189,7 +190,8 @@ bool header::from_data_t(reader& source, bool with_transaction_count)
 }
 
 
-void header::to_data_t(writer& sink, bool with_transaction_count) const
+template <typename Writer>
+void header::to_data_t(Writer& sink, bool with_transaction_count) const
 {
     sink.write_4_bytes_little_endian(version);
     sink.write_hash(previous_block_hash);
@@ -280,5 +282,13 @@ std::string get_block_version(uint32_t version)
     return "Unknown";
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool header::from_data_t(reader& source, bool with_transaction_count);
+template bool header::from_data_t(span_reader& source, bool with_transaction_count);
+template void header::to_data_t(writer& sink,
+    bool with_transaction_count) const;
+template void header::to_data_t(span_writer& sink,
+    bool with_transaction_count) const;
+
 } // namspace chain
 } // namspace libbitcoin
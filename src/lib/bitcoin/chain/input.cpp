@@ -89,7 +89,8 @@ void input::reset()
     sequence = 0;
 }
 
-bool input::from_data_t(reader& source)
+template <typename Reader>
+bool input::from_data_t(Reader& source)
 {
     reset();
 
@@ -117,7 +118,8 @@ bool input::from_data_t(reader& source)
     return result;
 }
 
-void input::to_data_t(writer& sink) const
+template <typename Writer>
+void input::to_data_t(Writer& sink) const
 {
     previous_output.to_data(sink);
     script.to_data(sink, true);
@@ -154,5 +156,11 @@ std::string input::get_script_address() const
     return payment_address.encoded();
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool input::from_data_t(reader& source);
+template bool input::from_data_t(span_reader& source);
+template void input::to_data_t(writer& sink) const;
+template void input::to_data_t(span_writer& sink) const;
+
 } // namspace chain
 } // namspace libbitcoin
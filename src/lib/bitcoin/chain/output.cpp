@@ -131,7 +131,8 @@ void output::reset()
     attach_data.reset(); // added for asset issue/transfer
 }
 
-bool output::from_data_t(reader& source)
+template <typename Reader>
+bool output::from_data_t(Reader& source)
 {
     reset();
 
@@ -153,7 +154,8 @@ bool output::from_data_t(reader& source)
     return result;
 }
 
-void output::to_data_t(writer& sink) const
+template <typename Writer>
+void output::to_data_t(Writer& sink) const
 {
     sink.write_8_bytes_little_endian(value);
     script.to_data(sink, true);
@@ -543,5 +545,11 @@ uint32_t output::get_lock_seconds_sequence(uint32_t default_value) const
     return get_relative_locktime_locked_seconds(raw_value);
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool output::from_data_t(reader& source);
+template bool output::from_data_t(span_reader& source);
+template void output::to_data_t(writer& sink) const;
+template void output::to_data_t(span_writer& sink) const;
+
 } // namspace chain
 } // namspace libbitcoin
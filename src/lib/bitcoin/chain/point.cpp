@@ -114,7 +114,8 @@ void point::reset()
     index = 0;
 }
 
-bool point::from_data_t(reader& source)
+template <typename Reader>
+bool point::from_data_t(Reader& source)
 {
     reset();
 
@@ -128,7 +129,8 @@ bool point::from_data_t(reader& source)
     return result;
 }
 
-void point::to_data_t(writer& sink) const
+template <typename Writer>
+void point::to_data_t(Writer& sink) const
 {
     sink.write_hash(hash);
     sink.write_4_bytes_little_endian(index);
@@ -225,5 +227,11 @@ uint64_t point::checksum() const
 //     return tupe_cmp(left.hash, left.index) < tupe_cmp(right.hash, right.index);
 // }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool point::from_data_t(reader& source);
+template bool point::from_data_t(span_reader& source);
+template void point::to_data_t(writer& sink) const;
+template void point::to_data_t(span_writer& sink) const;
+
 } // namspace chain
 } // namspace libbitcoin
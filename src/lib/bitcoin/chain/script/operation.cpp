@@ -67,6 +67,13 @@ operation operation::factory_from_data(reader& source)
     return instance;
 }
 
+operation operation::factory_from_data(span_reader& source)
+{
+    operation instance;
+    instance.from_data(source);
+    return instance;
+}
+
 bool operation::is_valid() const
 {
     return (code == opcode::zero) && data.empty();
@@ -80,8 +87,8 @@ void operation::reset()
 
 bool operation::from_data(const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(istream);
+    span_reader source(data);
+    return from_data(source);
 }
 
 bool operation::from_data(std::istream& stream)
@@ -91,6 +98,17 @@ bool operation::from_data(std::istream& stream)
 }
 
 bool operation::from_data(reader& source)
+{
+    return from_data_t(source);
+}
+
+bool operation::from_data(span_reader& source)
+{
+    return from_data_t(source);
+}
+
+template <typename Reader>
+bool operation::from_data_t(Reader& source)
 {
     reset();
 
@@ -134,6 +152,17 @@ void operation::to_data(std::ostream& stream) const
 }
 
 void operation::to_data(writer& sink) const
+{
+    to_data_t(sink);
+}
+
+void operation::to_data(span_writer& sink) const
+{
+    to_data_t(sink);
+}
+
+template <typename Writer>
+void operation::to_data_t(Writer& sink) const
 {
     if (code != opcode::raw_data)
     {
@@ -211,8 +240,9 @@ std::string operation::to_string(uint32_t flags) const
     return ss.str();
 }
 
+template <typename Reader>
 bool operation::read_opcode_data_size(uint32_t& count, opcode code,
-    uint8_t raw_byte, reader& source)
+    uint8_t raw_byte, Reader& source)
 {
     switch (code)
     {
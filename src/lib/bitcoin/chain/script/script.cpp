@@ -79,6 +79,14 @@ script script::factory_from_data(reader& source, bool prefix, parse_mode mode)
     return instance;
 }
 
+script script::factory_from_data(span_reader& source, bool prefix,
+    parse_mode mode)
+{
+    script instance;
+    instance.from_data(source, prefix, mode);
+    return instance;
+}
+
 script_pattern script::pattern() const
 {
     if (operation::is_null_data_pattern(operations))
@@ -148,8 +156,8 @@ bool script::from_data(const data_chunk& data, bool prefix, parse_mode mode)
 
     if (prefix)
     {
-        data_source istream(data);
-        result = from_data(istream, true, mode);
+        span_reader source(data);
+        result = from_data(source, true, mode);
     }
     else
     {
@@ -170,6 +178,17 @@ bool script::from_data(std::istream& stream, bool prefix, parse_mode mode)
 }
 
 bool script::from_data(reader& source, bool prefix, parse_mode mode)
+{
+    return from_data_t(source, prefix, mode);
+}
+
+bool script::from_data(span_reader& source, bool prefix, parse_mode mode)
+{
+    return from_data_t(source, prefix, mode);
+}
+
+template <typename Reader>
+bool script::from_data_t(Reader& source, bool prefix, parse_mode mode)
 {
     reset();
 
@@ -221,6 +240,17 @@ void script::to_data(std::ostream& stream, bool prefix) const
 }
 
 void script::to_data(writer& sink, bool prefix) const
+{
+    to_data_t(sink, prefix);
+}
+
+void script::to_data(span_writer& sink, bool prefix) const
+{
+    to_data_t(sink, prefix);
+}
+
+template <typename Writer>
+void script::to_data_t(Writer& sink, bool prefix) const
 {
     if (prefix)
         sink.write_variable_uint_little_endian(satoshi_content_size());
@@ -357,13 +387,12 @@ bool script::parse(const data_chunk& raw_script)
 
     if (raw_script.begin() != raw_script.end())
     {
-        data_source istream(raw_script);
+        span_reader source(raw_script);
 
-        while (result && istream &&
-            (istream.peek() != std::istream::traits_type::eof()))
+        while (result && source && !source.is_exhausted())
         {
             operations.emplace_back();
-            result = operations.back().from_data(istream);
+            result = operations.back().from_data(source);
         }
     }
 
@@ -115,7 +115,8 @@ void transaction::reset()
     mutex_.unlock();
 }
 
-bool transaction::from_data_t(reader& source)
+template <typename Reader>
+bool transaction::from_data_t(Reader& source)
 {
     reset();
     version = source.read_4_bytes_little_endian();
@@ -171,7 +172,8 @@ bool transaction::from_data_t(reader& source)
     return result;
 }
 
-void transaction::to_data_t(writer& sink) const
+template <typename Writer>
+void transaction::to_data_t(Writer& sink) const
 {
     sink.write_4_bytes_little_endian(version);
     sink.write_variable_uint_little_endian(inputs.size());
@@ -458,6 +460,11 @@ bool transaction::has_did_transfer() const
     return false;
 }
 
+// Instantiate for the virtual reader/writer and the span reader/writer.
+template bool transaction::from_data_t(reader& source);
+template bool transaction::from_data_t(span_reader& source);
+template void transaction::to_data_t(writer& sink) const;
+template void transaction::to_data_t(span_writer& sink) const;
 
 } // namspace chain
 } // namspace libbitcoin
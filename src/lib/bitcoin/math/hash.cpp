@@ -26,6 +26,7 @@
 #include <errno.h>
 #include <new>
 #include <stdexcept>
+#include <metaverse/bitcoin/utility/endian.hpp>
 #include "external/crypto_scrypt.h"
 #include "external/hmac_sha256.h"
 #include "external/hmac_sha512.h"
@@ -115,6 +116,60 @@ short_hash bitcoin_short_hash(data_slice data)
     return ripemd160_hash(sha256_hash(data));
 }
 
+#define SIPROUND \
+    do { \
+        v0 += v1; v1 = (v1 << 13) | (v1 >> 51); v1 ^= v0; \
+        v0 = (v0 << 32) | (v0 >> 32); \
+        v2 += v3; v3 = (v3 << 16) | (v3 >> 48); v3 ^= v2; \
+        v0 += v3; v3 = (v3 << 21) | (v3 >> 43); v3 ^= v0; \
+        v2 += v1; v1 = (v1 << 17) | (v1 >> 47); v1 ^= v2; \
+        v2 = (v2 << 32) | (v2 >> 32); \
+    } while (false)
+
+uint64_t siphash(const half_hash& key, data_slice data)
+{
+    const auto k0 = from_little_endian_unsafe<uint64_t>(key.begin());
+    const auto k1 = from_little_endian_unsafe<uint64_t>(key.begin() + 8);
+
+    uint64_t v0 = 0x736f6d6570736575ull ^ k0;
+    uint64_t v1 = 0x646f72616e646f6dull ^ k1;
+    uint64_t v2 = 0x6c7967656e657261ull ^ k0;
+    uint64_t v3 = 0x7465646279746573ull ^ k1;
+
+    const auto size = data.size();
+    const auto blocks = size / sizeof(uint64_t);
+    auto it = data.begin();
+
+    for (size_t block = 0; block < blocks; ++block)
+    {
+        const auto word = from_little_endian_unsafe<uint64_t>(it);
+        it += sizeof(uint64_t);
+        v3 ^= word;
+        SIPROUND;
+        SIPROUND;
+        v0 ^= word;
+    }
+
+    // The final word carries the remaining bytes and the length byte.
+    uint64_t last = static_cast<uint64_t>(size & 0xff) << 56;
+    for (size_t byte = 0; it != data.end(); ++it, ++byte)
+        last |= static_cast<uint64_t>(*it) << (8 * byte);
+
+    v3 ^= last;
+    SIPROUND;
+    SIPROUND;
+    v0 ^= last;
+
+    v2 ^= 0xff;
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+#undef SIPROUND
+
 static void handle_script_result(int result)
 {
     if (result == 0)
@@ -20,11 +20,13 @@
  */
 #include <metaverse/bitcoin/message/compact_block.hpp>
 
+#include <algorithm>
 #include <initializer_list>
 #include <boost/iostreams/stream.hpp>
 #include <metaverse/bitcoin/message/version.hpp>
 #include <metaverse/bitcoin/utility/container_sink.hpp>
 #include <metaverse/bitcoin/utility/container_source.hpp>
+#include <metaverse/bitcoin/utility/endian.hpp>
 #include <metaverse/bitcoin/utility/istream_reader.hpp>
 #include <metaverse/bitcoin/utility/ostream_writer.hpp>
 
@@ -59,9 +61,59 @@ compact_block compact_block::factory_from_data(uint32_t version,
     return instance;
 }
 
+compact_block compact_block::factory_from_block(const chain::block& block,
+    uint64_t nonce)
+{
+    compact_block instance;
+    instance.header = block.header;
+    instance.nonce = nonce;
+    instance.blocksig = block.blocksig;
+    instance.public_key = block.public_key;
+
+    // The coinbase and the coinstake are never found in a peer's pool.
+    const auto prefilled = std::min<size_t>(block.transactions.size(),
+        block.is_proof_of_stake() ? 2 : 1);
+
+    for (size_t index = 0; index < prefilled; ++index)
+        instance.transactions.push_back({ index, block.transactions[index] });
+
+    const auto key = instance.short_id_key();
+    instance.short_ids.reserve(block.transactions.size() - prefilled);
+
+    for (auto tx = block.transactions.begin() + prefilled;
+        tx != block.transactions.end(); ++tx)
+        instance.short_ids.push_back(to_short_id(key, tx->hash()));
+
+    return instance;
+}
+
+compact_block::short_id compact_block::to_short_id(const half_hash& key,
+    const hash_digest& tx_hash)
+{
+    // The short id is the lower six bytes of the siphash, little endian.
+    const auto bytes = to_little_endian(siphash(key, tx_hash));
+    short_id out;
+    std::copy(bytes.begin(), bytes.begin() + out.size(), out.begin());
+    return out;
+}
+
 bool compact_block::is_valid() const
 {
-    return header.is_valid() && !short_ids.empty() && !transactions.empty();
+    return header.is_valid() && !transactions.empty();
+}
+
+half_hash compact_block::short_id_key() const
+{
+    const auto hash = sha256_hash(header.to_data(false),
+        to_little_endian(nonce));
+    half_hash key;
+    std::copy(hash.begin(), hash.begin() + key.size(), key.begin());
+    return key;
+}
+
+size_t compact_block::transaction_count() const
+{
+    return short_ids.size() + transactions.size();
 }
 
 void compact_block::reset()
@@ -72,6 +124,8 @@ void compact_block::reset()
     short_ids.shrink_to_fit();
     transactions.clear();
     transactions.shrink_to_fit();
+    blocksig.fill(0);
+    public_key.fill(0);
 }
 
 bool compact_block::from_data(uint32_t version, const data_chunk& data)
@@ -121,6 +175,18 @@ bool compact_block::from_data(uint32_t version, reader& source)
         }
     }
 
+    if (result && (header.is_proof_of_stake() || header.is_proof_of_dpos()))
+    {
+        source.read_data(blocksig.data(), blocksig.size());
+        result = static_cast<bool>(source);
+    }
+
+    if (result && header.is_proof_of_dpos())
+    {
+        source.read_data(public_key.data(), public_key.size());
+        result = static_cast<bool>(source);
+    }
+
     if (!result || insufficient_version)
         reset();
 
@@ -154,6 +220,12 @@ void compact_block::to_data(uint32_t version, writer& sink) const
     sink.write_variable_uint_little_endian(transactions.size());
     for (const auto& element: transactions)
         element.to_data(version, sink);
+
+    if (header.is_proof_of_stake() || header.is_proof_of_dpos())
+        sink.write_data(blocksig.data(), blocksig.size());
+
+    if (header.is_proof_of_dpos())
+        sink.write_data(public_key.data(), public_key.size());
 }
 
 uint64_t compact_block::serialized_size(uint32_t version) const
@@ -165,6 +237,12 @@ uint64_t compact_block::serialized_size(uint32_t version) const
     for (const auto& tx: transactions)
         size += tx.serialized_size(version);
 
+    if (header.is_proof_of_stake() || header.is_proof_of_dpos())
+        size += blocksig.size();
+
+    if (header.is_proof_of_dpos())
+        size += public_key.size();
+
     return size;
 }
 
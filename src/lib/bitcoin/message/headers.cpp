@@ -174,6 +174,25 @@ void headers::to_inventory(inventory_vector::list& out,
     std::transform(elements.begin(), elements.end(), out.begin(), map);
 }
 
+// True if each header links to the header that precedes it.
+bool headers::is_sequential() const
+{
+    if (elements.empty())
+        return true;
+
+    auto previous = elements.front().hash();
+
+    for (auto it = elements.begin() + 1; it != elements.end(); ++it)
+    {
+        if (it->previous_block_hash != previous)
+            return false;
+
+        previous = it->hash();
+    }
+
+    return true;
+}
+
 uint64_t headers::serialized_size(uint32_t version) const
 {
     uint64_t size = variable_uint_size(elements.size());
@@ -22,6 +22,7 @@
 
 #include <boost/iostreams/stream.hpp>
 #include <metaverse/bitcoin/messages.hpp>
+#include <metaverse/bitcoin/message/alert.hpp>
 #include <metaverse/bitcoin/message/version.hpp>
 #include <metaverse/bitcoin/utility/container_sink.hpp>
 #include <metaverse/bitcoin/utility/container_source.hpp>
@@ -146,6 +147,11 @@ void heading::to_data(writer& sink) const
 }
 
 message_type heading::type() const
+{
+    return to_type(command);
+}
+
+message_type heading::to_type(const std::string& command)
 {
     // TODO: convert to static map.
     if (command == address::command)
@@ -202,6 +208,70 @@ message_type heading::type() const
     return message_type::unknown;
 }
 
+std::string heading::to_command(message_type type)
+{
+    switch (type)
+    {
+        case message_type::address:
+            return address::command;
+        case message_type::alert:
+            return alert::command;
+        case message_type::block_message:
+            return block_message::command;
+        case message_type::block_transactions:
+            return block_transactions::command;
+        case message_type::compact_block:
+            return compact_block::command;
+        case message_type::fee_filter:
+            return fee_filter::command;
+        case message_type::filter_add:
+            return filter_add::command;
+        case message_type::filter_clear:
+            return filter_clear::command;
+        case message_type::filter_load:
+            return filter_load::command;
+        case message_type::get_address:
+            return get_address::command;
+        case message_type::get_block_transactions:
+            return get_block_transactions::command;
+        case message_type::get_blocks:
+            return get_blocks::command;
+        case message_type::get_data:
+            return get_data::command;
+        case message_type::get_headers:
+            return get_headers::command;
+        case message_type::headers:
+            return headers::command;
+        case message_type::inventory:
+            return inventory::command;
+        case message_type::memory_pool:
+            return memory_pool::command;
+        case message_type::merkle_block:
+            return merkle_block::command;
+        case message_type::not_found:
+            return not_found::command;
+        case message_type::ping:
+            return ping::command;
+        case message_type::pong:
+            return pong::command;
+        case message_type::reject:
+            return reject::command;
+        case message_type::send_compact_blocks:
+            return send_compact_blocks::command;
+        case message_type::send_headers:
+            return send_headers::command;
+        case message_type::transaction_message:
+            return transaction_message::command;
+        case message_type::verack:
+            return verack::command;
+        case message_type::version:
+            return version::command;
+        case message_type::unknown:
+        default:
+            return "unknown";
+    }
+}
+
 bool operator==(const heading& left, const heading& right)
 {
     return (left.magic == right.magic)
@@ -0,0 +1,360 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <metaverse/bitcoin/utility/scheduler.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <metaverse/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+
+// Identifies the scheduler thread (if any) running the current thread.
+static thread_local const scheduler* current_scheduler = nullptr;
+static thread_local size_t current_queue = 0;
+
+// scheduler
+// ----------------------------------------------------------------------------
+
+scheduler::scheduler(size_t number_threads, thread_priority priority)
+  : pending_(0), sleeping_(0), next_(0), stopped_(false)
+{
+    if (number_threads == 0)
+        number_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    // All queues must exist before any thread starts stealing.
+    for (size_t index = 0; index < number_threads; ++index)
+        queues_.emplace_back(new queue);
+
+    for (size_t index = 0; index < number_threads; ++index)
+        threads_.push_back(asio::thread(
+            std::bind(&scheduler::run, this, index, priority)));
+}
+
+scheduler::~scheduler()
+{
+    stop();
+}
+
+bool scheduler::post(task job)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(stop_mutex_);
+
+    if (stopped_)
+        return false;
+
+    // Owned threads push to their own queue, others spread across queues.
+    const auto index = current_scheduler == this ? current_queue :
+        next_++ % queues_.size();
+
+    // Counted before the push so that a thief never observes a negative.
+    ++pending_;
+    auto& target = *queues_[index];
+    {
+        scoped_lock queue_lock(target.mutex);
+        target.tasks.push_back(std::move(job));
+    }
+    ///////////////////////////////////////////////////////////////////////////
+
+    wake();
+    return true;
+}
+
+bool scheduler::run_one()
+{
+    task job;
+    const auto owned = current_scheduler == this;
+    const auto index = owned ? current_queue : next_++ % queues_.size();
+
+    if (!(owned && pop(index, job)) && !steal(index, job))
+        return false;
+
+    job();
+    return true;
+}
+
+void scheduler::stop()
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    {
+        unique_lock lock(stop_mutex_);
+        stopped_ = true;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+
+    wake_.notify_all();
+
+    // Threads exit once the queued tasks are exhausted.
+    for (auto& thread: threads_)
+        if (thread.joinable())
+            thread.join();
+
+    threads_.clear();
+}
+
+size_t scheduler::size() const
+{
+    return queues_.size();
+}
+
+size_t scheduler::backlog() const
+{
+    return pending_.load();
+}
+
+// private
+void scheduler::run(size_t index, thread_priority priority)
+{
+    set_thread_priority(priority);
+    current_scheduler = this;
+    current_queue = index;
+
+    const auto ready = [this]()
+    {
+        return pending_ > 0 || stopped_;
+    };
+
+    task job;
+
+    while (true)
+    {
+        if (pop(index, job) || steal(index, job))
+        {
+            job();
+            job = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+
+        // Posters check sleeping_ after counting, so one of us sees the other.
+        ++sleeping_;
+        wake_.wait(lock, ready);
+        --sleeping_;
+
+        if (stopped_ && pending_ == 0)
+            break;
+    }
+}
+
+// Take the most recent task of the owned queue.
+bool scheduler::pop(size_t index, task& out)
+{
+    auto& source = *queues_[index];
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    scoped_lock lock(source.mutex);
+
+    if (source.tasks.empty())
+        return false;
+
+    out = std::move(source.tasks.back());
+    source.tasks.pop_back();
+    --pending_;
+    return true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// Take the oldest task of another queue, ending with the owned queue.
+bool scheduler::steal(size_t index, task& out)
+{
+    const auto count = queues_.size();
+
+    for (size_t offset = 1; offset <= count; ++offset)
+    {
+        auto& source = *queues_[(index + offset) % count];
+
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        scoped_lock lock(source.mutex);
+
+        if (source.tasks.empty())
+            continue;
+
+        out = std::move(source.tasks.front());
+        source.tasks.pop_front();
+        --pending_;
+        return true;
+        ///////////////////////////////////////////////////////////////////////
+    }
+
+    return false;
+}
+
+void scheduler::wake()
+{
+    if (sleeping_ == 0)
+        return;
+
+    // Taking the mutex orders this with a thread that is about to wait.
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+
+    wake_.notify_one();
+}
+
+// task_group
+// ----------------------------------------------------------------------------
+
+task_group::task_group(scheduler& scheduler)
+  : scheduler_(scheduler), state_(std::make_shared<state>())
+{
+}
+
+void task_group::run(scheduler::task job)
+{
+    const auto group = state_;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    {
+        std::lock_guard<std::mutex> lock(group->mutex);
+        ++group->pending;
+        group->queued.push_back(job);
+        group->done.notify_all();
+    }
+    ///////////////////////////////////////////////////////////////////////////
+
+    // The posted action runs a queued task of the group, unless a waiter has
+    // already claimed it. The scheduler drains its queues before it stops,
+    // so it outlives this.
+    auto& pool = scheduler_;
+    const auto action = [&pool, group]()
+    {
+        scheduler::task queued;
+        if (!claim(group, queued))
+            return;
+
+        queued();
+        complete(pool, group);
+    };
+
+    if (!scheduler_.post(action))
+        action();
+}
+
+void task_group::then(scheduler::task continuation)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+
+        if (state_->pending != 0)
+        {
+            state_->continuations.push_back(continuation);
+            return;
+        }
+    }
+    ///////////////////////////////////////////////////////////////////////////
+
+    follow(scheduler_, continuation);
+}
+
+// Only tasks of this group are run here, as the caller may hold locks that
+// tasks of other clients of the scheduler also take.
+void task_group::wait()
+{
+    const auto ready = [this]()
+    {
+        return state_->pending == 0 || !state_->queued.empty();
+    };
+
+    while (true)
+    {
+        scheduler::task job;
+
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        {
+            std::unique_lock<std::mutex> lock(state_->mutex);
+            state_->done.wait(lock, ready);
+
+            if (state_->pending == 0)
+                return;
+
+            job = std::move(state_->queued.front());
+            state_->queued.pop_front();
+        }
+        ///////////////////////////////////////////////////////////////////////
+
+        job();
+        complete(scheduler_, state_);
+    }
+}
+
+// private
+bool task_group::claim(state_ptr group, scheduler::task& out)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    std::lock_guard<std::mutex> lock(group->mutex);
+
+    if (group->queued.empty())
+        return false;
+
+    out = std::move(group->queued.front());
+    group->queued.pop_front();
+    return true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void task_group::complete(scheduler& scheduler, state_ptr group)
+{
+    std::vector<scheduler::task> continuations;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    {
+        std::lock_guard<std::mutex> lock(group->mutex);
+
+        if (--group->pending != 0)
+            return;
+
+        std::swap(continuations, group->continuations);
+        group->done.notify_all();
+    }
+    ///////////////////////////////////////////////////////////////////////////
+
+    for (const auto& continuation: continuations)
+        follow(scheduler, continuation);
+}
+
+void task_group::follow(scheduler& scheduler, scheduler::task continuation)
+{
+    if (!scheduler.post(continuation))
+        continuation();
+}
+
+} // namespace libbitcoin
@@ -20,13 +20,16 @@
  */
 #include <metaverse/bitcoin/utility/thread.hpp>
 
+#include <cstdint>
 #include <stdexcept>
+#include <vector>
 
 #ifdef _MSC_VER
     #include <windows.h>
 #else
     #include <unistd.h>
     #include <pthread.h>
+    #include <sched.h>
     #include <sys/resource.h>
     #include <sys/types.h>
     #ifndef PRIO_MAX
@@ -72,4 +75,29 @@ void set_thread_priority(thread_priority priority)
 #endif
 }
 
+// Pin the thread where supported, otherwise leave scheduling to the system.
+void set_thread_affinity(const std::vector<uint32_t>& processors)
+{
+    if (processors.empty())
+        return;
+
+#if defined(_MSC_VER)
+    DWORD_PTR mask = 0;
+    for (const auto processor: processors)
+        if (processor < sizeof(mask) * 8)
+            mask |= (DWORD_PTR(1) << processor);
+
+    if (mask != 0)
+        SetThreadAffinityMask(GetCurrentThread(), mask);
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const auto processor: processors)
+        if (processor < CPU_SETSIZE)
+            CPU_SET(processor, &set);
+
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
 } // namespace libbitcoin
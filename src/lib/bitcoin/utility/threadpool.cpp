@@ -20,9 +20,13 @@
  */
 #include <metaverse/bitcoin/utility/threadpool.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <new>
 #include <thread>
+#include <vector>
 #include <metaverse/bitcoin/utility/asio.hpp>
 #include <metaverse/bitcoin/utility/thread.hpp>
 
@@ -45,16 +49,25 @@ void threadpool::spawn(size_t number_threads, thread_priority priority)
         spawn_once(priority);
 }
 
-void threadpool::spawn_once(thread_priority priority)
+void threadpool::spawn(size_t number_threads, thread_priority priority,
+    const std::vector<uint32_t>& processors)
+{
+    for (size_t i = 0; i < number_threads; ++i)
+        spawn_once(priority, processors);
+}
+
+void threadpool::spawn_once(thread_priority priority,
+    const std::vector<uint32_t>& processors)
 {
     // In C++14 work should use a unique_ptr.
     // Work prevents the service from running out of work and terminating.
     if (!work_)
         work_ = std::make_shared<asio::service::work>(service_);
 
-    const auto action = [this, priority]
+    const auto action = [this, priority, processors]
     {
         set_thread_priority(priority);
+        set_thread_affinity(processors);
         service_.run();
     };
 
@@ -92,4 +105,41 @@ const asio::service& threadpool::service() const
     return service_;
 }
 
+void threadpool::attach(monitor::count_ptr counter)
+{
+    const auto expired = [](const count_reference& reference)
+    {
+        return reference.expired();
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(counters_mutex_);
+
+    // Counters of destroyed work queues are dropped as new ones arrive.
+    counters_.erase(std::remove_if(counters_.begin(), counters_.end(),
+        expired), counters_.end());
+    counters_.push_back(counter);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+size_t threadpool::backlog() const
+{
+    size_t total = 0;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(counters_mutex_);
+
+    for (const auto& reference: counters_)
+    {
+        const auto counter = reference.lock();
+        if (counter)
+            total += counter->load();
+    }
+    ///////////////////////////////////////////////////////////////////////////
+
+    return total;
+}
+
 } // namespace libbitcoin
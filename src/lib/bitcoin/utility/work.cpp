@@ -35,6 +35,9 @@ work::work(threadpool& pool, const std::string& name)
     strand_(service_),
     name_(name)
 {
+    pool.attach(ordered_);
+    pool.attach(unordered_);
+    pool.attach(concurrent_);
 }
 
 size_t work::ordered_backlog()
@@ -0,0 +1,243 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <metaverse/blockchain/account_cache.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <metaverse/bitcoin.hpp>
+
+namespace libbitcoin {
+namespace blockchain {
+
+account_cache::account_cache(size_t balance_capacity)
+  : balance_capacity_(std::max(balance_capacity, size_t(1)))
+{
+}
+
+bool account_cache::addresses(const std::string& account,
+    address_list_ptr& out) const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
+
+    const auto it = addresses_.find(account);
+    if (it == addresses_.end())
+        return false;
+
+    // Callers own their list, the cached one is never handed out.
+    out = std::make_shared<chain::account_address::list>(*it->second);
+    return true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void account_cache::store_addresses(const std::string& account,
+    const chain::account_address::list& addresses, uint64_t generation)
+{
+    // Unknown account names would otherwise grow the map without bound.
+    if (addresses.empty())
+        return;
+
+    const auto list = std::make_shared<chain::account_address::list>(
+        addresses);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
+
+    if (generation != address_generation_)
+        return;
+
+    addresses_[account] = list;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+uint64_t account_cache::address_generation() const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
+    return address_generation_;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void account_cache::drop_addresses(const std::string& account)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
+    ++address_generation_;
+    addresses_.erase(account);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+bool account_cache::get_balance(const std::string& address, uint64_t top,
+    balance& out)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    // Exclusive, as a hit refreshes the recency of the balance.
+    unique_lock lock(mutex_);
+
+    const auto it = balances_.find(address);
+    if (it == balances_.end())
+        return false;
+
+    // Frozen funds may have matured since, unfrozen funds stay unfrozen.
+    const auto& value = it->second.value;
+    if (value.frozen != 0 && value.height != top)
+        return false;
+
+    recency_.splice(recency_.begin(), recency_, it->second.position);
+    out = value;
+    return true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void account_cache::store_balance(const std::string& address,
+    const balance& value, uint64_t generation)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
+
+    if (generation != generation_)
+        return;
+
+    const auto it = balances_.find(address);
+    if (it != balances_.end())
+    {
+        it->second.value = value;
+        recency_.splice(recency_.begin(), recency_, it->second.position);
+        return;
+    }
+
+    if (balances_.size() >= balance_capacity_)
+        erase_balance(balances_.find(recency_.back()));
+
+    recency_.push_front(address);
+    balances_.emplace(address, balance_entry{ value, recency_.begin() });
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+uint64_t account_cache::generation() const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
+    return generation_;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void account_cache::connect(const chain::block& block)
+{
+    auto empty = false;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    mutex_.lock_upgrade();
+
+    if (balances_.empty())
+    {
+        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+        mutex_.unlock_upgrade_and_lock();
+        ++generation_;
+        mutex_.unlock();
+        //---------------------------------------------------------------------
+        empty = true;
+    }
+    else
+    {
+        mutex_.unlock_upgrade();
+    }
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Nothing is cached, so there is no need to parse the block.
+    if (empty)
+        return;
+
+    std::unordered_set<std::string> touched;
+    auto unknown = false;
+
+    for (const auto& tx: block.transactions)
+    {
+        for (const auto& output: tx.outputs)
+            touched.insert(output.get_script_address());
+
+        if (tx.is_coinbase())
+            continue;
+
+        for (const auto& input: tx.inputs)
+        {
+            const auto address = input.get_script_address();
+
+            // A spend that cannot be attributed may be from any address.
+            if (address.empty())
+                unknown = true;
+            else
+                touched.insert(address);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
+    ++generation_;
+
+    if (unknown)
+    {
+        balances_.clear();
+        recency_.clear();
+        return;
+    }
+
+    for (const auto& address: touched)
+    {
+        const auto it = balances_.find(address);
+        if (it != balances_.end())
+            erase_balance(it);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void account_cache::disconnect()
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
+    ++generation_;
+    balances_.clear();
+    recency_.clear();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// private, call under exclusive lock.
+void account_cache::erase_balance(balance_map::iterator it)
+{
+    recency_.erase(it->second.position);
+    balances_.erase(it);
+}
+
+} // namespace blockchain
+} // namespace libbitcoin
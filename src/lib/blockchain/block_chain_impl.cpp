@@ -48,7 +48,7 @@
 namespace libbitcoin {
 namespace blockchain {
 
-////#define NAME "blockchain"
+#define NAME "blockchain"
 
 using namespace bc::chain;
 using namespace bc::database;
@@ -59,17 +59,33 @@ using boost::filesystem::path;
 using string = std::string;
 
 
+// Heights of cumulative work held in memory, deeper forks also read headers.
+static constexpr size_t chain_work_window = 100000;
+
+// Address balances held in memory, any address may be queried over RPC.
+static constexpr size_t account_balance_capacity = 50000;
+
 block_chain_impl::block_chain_impl(threadpool& pool,
     const blockchain::settings& chain_settings,
     const database::settings& database_settings)
+  : block_chain_impl(pool, pool, chain_settings, database_settings)
+{
+}
+
+block_chain_impl::block_chain_impl(threadpool& block_pool,
+    threadpool& transaction_pool, const blockchain::settings& chain_settings,
+    const database::settings& database_settings)
   : stopped_(true),
     sync_disabled_(false),
     settings_(chain_settings),
-    organizer_(pool, *this, chain_settings),
+    scheduler_(chain_settings.scheduler_threads, thread_priority::low),
+    organizer_(block_pool, scheduler_, *this, chain_settings),
     ////read_dispatch_(pool, NAME),
-    ////write_dispatch_(pool, NAME),
-    transaction_pool_(pool, *this, chain_settings),
-    database_(database_settings)
+    write_dispatch_(block_pool, NAME),
+    transaction_pool_(transaction_pool, scheduler_, *this, chain_settings),
+    database_(database_settings),
+    work_(chain_work_window),
+    account_cache_(account_balance_capacity)
 {
 }
 
@@ -102,6 +118,16 @@ transaction_pool& block_chain_impl::pool()
     return transaction_pool_;
 }
 
+scheduler& block_chain_impl::task_scheduler()
+{
+    return scheduler_;
+}
+
+account_cache& block_chain_impl::get_account_cache()
+{
+    return account_cache_;
+}
+
 const settings& block_chain_impl::chain_settings() const
 {
     return settings_;
@@ -346,8 +372,26 @@ bool block_chain_impl::get_difficulty(u256& out_difficulty,
     if (!database_.blocks.top(top))
         return false;
 
-    out_difficulty = 0;
-    for (uint64_t index = height; index <= top; ++index)
+    // Rebuild the window if it has not been filled or lost contiguity.
+    if (!work_.covers(top))
+    {
+        work_.clear();
+        const auto first = top < chain_work_window ? 0 :
+            top - chain_work_window + 1;
+
+        for (uint64_t index = first; index <= top; ++index)
+            work_.push(index,
+                block_work(database_.blocks.get(index).header().bits));
+    }
+
+    // Only the part of a deep fork below the window walks the headers.
+    const auto base = std::max(work_.base(), height);
+    u256 above;
+    if (!work_.sum(above, base))
+        return false;
+
+    out_difficulty = above;
+    for (uint64_t index = height; index < base; ++index)
     {
         const auto bits = database_.blocks.get(index).header().bits;
         out_difficulty += block_work(bits);
@@ -438,18 +482,69 @@ bool block_chain_impl::get_transaction(transaction& out_transaction,
 
 // This is safe to call concurrently (but with no other methods).
 bool block_chain_impl::import(block::ptr block, uint64_t height)
+{
+    return import(block, height, true);
+}
+
+bool block_chain_impl::import(block::ptr block, uint64_t height, bool sync)
 {
     if (stopped())
         return false;
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section.
+    // Imports exclude snapshots, which must not observe a partial block.
+    unique_lock lock(mutex_);
+
     // THIS IS THE DATABASE BLOCK WRITE AND INDEX OPERATION.
-    database_.push(*block, height);
+    database_.push(*block, height, sync);
+    work_.push(height, block_work(block->header.bits));
+    account_cache_.connect(*block);
     return true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void block_chain_impl::synchronize()
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section.
+    unique_lock lock(mutex_);
+
+    database_.synchronize();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+bool block_chain_impl::snapshot(const boost::filesystem::path& directory,
+    uint64_t& out_height)
+{
+    if (stopped())
+        return false;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section.
+    // Blocks are stored, imported and synchronized and accounts written
+    // under this lock, so holding it quiesces all writes at a block boundary.
+    unique_lock lock(mutex_);
+
+    size_t top;
+    if (!database_.blocks.top(top))
+        return false;
+
+    out_height = top;
+    return database_.snapshot(directory);
+    ///////////////////////////////////////////////////////////////////////////
 }
 
 bool block_chain_impl::push(block_detail::ptr block)
 {
-    database_.push(*block->actual());
+    const auto& actual = *block->actual();
+    database_.push(actual);
+
+    size_t top;
+    if (database_.blocks.top(top))
+        work_.push(top, block_work(actual.header.bits));
+
+    account_cache_.connect(actual);
     return true;
 }
 
@@ -475,17 +570,26 @@ bool block_chain_impl::pop_from(block_detail::list& out_blocks,
     // If the fork is at the top there is one block to pop, and so on.
     out_blocks.reserve(top - height + 1);
 
+    // Balances are dropped once the blocks are gone, whatever the outcome.
+    const auto invalidate = [this](bool result)
+    {
+        account_cache_.disconnect();
+        return result;
+    };
+
     for (uint64_t index = top; index >= height; --index)
     {
         chain::block block;
         if (!database_.pop(block)) {
-            return false;
+            work_.clear();
+            return invalidate(false);
         }
+        work_.pop(index);
         const auto sp_block = std::make_shared<block_detail>(std::move(block));
         out_blocks.push_back(sp_block);
     }
 
-    return true;
+    return invalidate(true);
 }
 
 // block_chain (internal locks).
@@ -530,21 +634,26 @@ void block_chain_impl::store(message::block_message::ptr block,
         return;
     }
 
-    // We moved write to the network thread using a critical section here.
-    // We do not want to give the thread to any other activity at this point.
-    // A flood of valid orphans from multiple peers could tie up the CPU here,
-    // but resolving that cleanly requires removing the orphan pool.
+    // Validation is ordered on the block pool so that it does not hold the
+    // network thread. A flood of valid orphans from multiple peers could tie
+    // up the block pool, but resolving that requires removing the orphan pool.
+    const auto store_block = [this, block, handler]()
+    {
+        if (stopped())
+        {
+            handler(error::service_stopped, 0);
+            return;
+        }
 
-    ////write_dispatch_.ordered(
-    ////    std::bind(&block_chain_impl::do_store,
-    ////        this, block, handler));
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section.
+        unique_lock lock(mutex_);
 
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section.
-    unique_lock lock(mutex_);
+        do_store(block, handler);
+        ///////////////////////////////////////////////////////////////////////
+    };
 
-    do_store(block, handler);
-    ///////////////////////////////////////////////////////////////////////////
+    write_dispatch_.ordered(store_block);
 }
 
 // This processes the block through the organizer.
@@ -1481,6 +1590,7 @@ operation_result block_chain_impl::store_account_address(std::shared_ptr<account
     const auto hash = get_short_hash(address->get_name());
     database_.account_addresses.store(hash, *address);
     database_.account_addresses.sync();
+    account_cache_.drop_addresses(address->get_name());
     ///////////////////////////////////////////////////////////////////////////
     return operation_result::okay;
 }
@@ -1501,6 +1611,7 @@ operation_result block_chain_impl::delete_account_address(const std::string& nam
     for( auto each : addr_vec )
         database_.account_addresses.delete_last_row(hash);
     database_.account_addresses.sync();
+    account_cache_.drop_addresses(name);
     ///////////////////////////////////////////////////////////////////////////
     return operation_result::okay;
 }
@@ -1514,6 +1625,11 @@ std::shared_ptr<account_address> block_chain_impl::get_account_address(
 std::shared_ptr<account_address::list> block_chain_impl::get_account_addresses(
     const std::string& name)
 {
+    account_cache::address_list_ptr cached;
+    if (account_cache_.addresses(name, cached))
+        return cached;
+
+    const auto generation = account_cache_.address_generation();
     auto sp_addr = std::make_shared<account_address::list>();
     auto result = database_.account_addresses.get(get_short_hash(name));
     if (result.size()) {
@@ -1524,6 +1640,7 @@ std::shared_ptr<account_address::list> block_chain_impl::get_account_addresses(
         };
         std::for_each(result.begin(), result.end(), action);
     }
+    account_cache_.store_addresses(name, *sp_addr, generation);
     return sp_addr;
 }
 
@@ -2733,6 +2850,10 @@ void block_chain_impl::safe_store_account(account& acc, std::vector<std::shared_
     }
     database_.account_addresses.sync();
 
+    for(auto& address:addresses) {
+        account_cache_.drop_addresses(address->get_name());
+    }
+
     database_.accounts.store(acc);
     database_.accounts.sync();
 }
@@ -0,0 +1,188 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <metaverse/blockchain/block_file.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <metaverse/bitcoin.hpp>
+#include <metaverse/blockchain/validate_block.hpp>
+
+namespace libbitcoin {
+namespace blockchain {
+
+// block_file_writer
+// ----------------------------------------------------------------------------
+
+block_file_writer::block_file_writer(const boost::filesystem::path& file)
+  : file_(file),
+    last_height_(0)
+{
+}
+
+bool block_file_writer::open()
+{
+    if (stream_)
+        return false;
+
+    stream_ = std::make_shared<bc::ofstream>(file_.string(),
+        std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+
+    ostream_writer sink(*stream_);
+    sink.write_4_bytes_little_endian(block_file_magic);
+    sink.write_4_bytes_little_endian(block_file_version);
+    return sink;
+}
+
+bool block_file_writer::write(const data_chunk& block, uint64_t height)
+{
+    if (!stream_ || block.size() > max_uint32)
+        return false;
+
+    if (last_height_ != 0 && height <= last_height_)
+        return false;
+
+    ostream_writer sink(*stream_);
+    sink.write_8_bytes_little_endian(height);
+    sink.write_4_bytes_little_endian(static_cast<uint32_t>(block.size()));
+    sink.write_data(block);
+    last_height_ = height;
+    return sink;
+}
+
+bool block_file_writer::close()
+{
+    if (!stream_)
+        return false;
+
+    stream_->flush();
+    const auto result = static_cast<bool>(*stream_);
+    stream_.reset();
+    return result;
+}
+
+// file_block_source
+// ----------------------------------------------------------------------------
+
+file_block_source::file_block_source(const boost::filesystem::path& file,
+    uint64_t start_height)
+  : file_(file),
+    start_height_(start_height),
+    size_(0)
+{
+}
+
+bool file_block_source::open()
+{
+    if (stream_)
+        return false;
+
+    stream_ = std::make_shared<bc::ifstream>(file_.string(),
+        std::ifstream::in | std::ifstream::binary);
+
+    // Skipped records are not read, so their extent is checked by size.
+    boost::system::error_code ec;
+    size_ = boost::filesystem::file_size(file_, ec);
+    if (ec)
+        size_ = 0;
+
+    istream_reader source(*stream_);
+    const auto magic = source.read_4_bytes_little_endian();
+    const auto version = source.read_4_bytes_little_endian();
+
+    if (!source || magic != block_file_magic || version != block_file_version)
+    {
+        log::error(LOG_BLOCKCHAIN)
+            << "block file " << file_.string() << " is not a block export";
+        stream_.reset();
+        return false;
+    }
+
+    return true;
+}
+
+code file_block_source::next(data_chunk& out_block, uint64_t& out_height)
+{
+    if (!stream_)
+        return error::operation_failed;
+
+    istream_reader source(*stream_);
+
+    while (true)
+    {
+        // The file ends cleanly only at a record boundary.
+        if (stream_->peek() == std::char_traits<char>::eof())
+            return error::not_found;
+
+        const auto height = source.read_8_bytes_little_endian();
+        if (!source)
+        {
+            log::error(LOG_BLOCKCHAIN)
+                << "block file " << file_.string() << " is truncated in a "
+                << "record header";
+            return error::bad_stream;
+        }
+
+        const auto size = source.read_4_bytes_little_endian();
+        if (!source || size > max_block_size)
+        {
+            log::error(LOG_BLOCKCHAIN)
+                << "block file " << file_.string() << " is corrupt after "
+                << height;
+            return error::bad_stream;
+        }
+
+        if (height < start_height_)
+        {
+            stream_->seekg(size, std::ios_base::cur);
+            const auto position = stream_->tellg();
+            if (!*stream_ || position < 0 ||
+                static_cast<uint64_t>(position) > size_)
+            {
+                log::error(LOG_BLOCKCHAIN)
+                    << "block file " << file_.string() << " is truncated at "
+                    << height;
+                return error::bad_stream;
+            }
+
+            continue;
+        }
+
+        out_block.resize(size);
+        if (source.read_data(out_block.data(), size) != size)
+        {
+            log::error(LOG_BLOCKCHAIN)
+                << "block file " << file_.string() << " is truncated at "
+                << height;
+            return error::bad_stream;
+        }
+
+        out_height = height;
+        return error::success;
+    }
+}
+
+void file_block_source::close()
+{
+    stream_.reset();
+}
+
+} // namespace blockchain
+} // namespace libbitcoin
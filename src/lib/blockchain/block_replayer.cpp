@@ -0,0 +1,317 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <metaverse/blockchain/block_replayer.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <metaverse/bitcoin.hpp>
+#include <metaverse/blockchain/block_detail.hpp>
+#include <metaverse/blockchain/validate_block_impl.hpp>
+
+namespace libbitcoin {
+namespace blockchain {
+
+using namespace bc::chain;
+using namespace bc::config;
+using namespace bc::database;
+
+// database_block_source
+// ----------------------------------------------------------------------------
+
+database_block_source::database_block_source(const database::settings& settings,
+    uint64_t start_height, uint64_t stop_height)
+  : database_(settings),
+    height_(start_height),
+    stop_height_(stop_height),
+    top_(0),
+    opened_(false)
+{
+}
+
+bool database_block_source::open()
+{
+    if (opened_ || !database_.start())
+        return false;
+
+    size_t top;
+    if (!database_.blocks.top(top))
+    {
+        database_.stop();
+        return false;
+    }
+
+    top_ = std::min(uint64_t(top), stop_height_);
+    opened_ = true;
+    return true;
+}
+
+code database_block_source::next(data_chunk& out_block, uint64_t& out_height)
+{
+    if (!opened_)
+        return error::operation_failed;
+
+    if (height_ > top_)
+        return error::not_found;
+
+    const auto result = database_.blocks.get(height_);
+    if (!result)
+    {
+        log::error(LOG_BLOCKCHAIN)
+            << "replay: block [" << height_ << "] is missing from the source";
+        return error::operation_failed;
+    }
+
+    const auto count = result.transaction_count();
+    transaction::list transactions;
+    transactions.reserve(count);
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        const auto tx = database_.transactions.get(
+            result.transaction_hash(index));
+
+        if (!tx)
+        {
+            log::error(LOG_BLOCKCHAIN)
+                << "replay: block [" << height_ << "] transaction "
+                << encode_hash(result.transaction_hash(index))
+                << " is missing from the source";
+            return error::operation_failed;
+        }
+
+        transactions.push_back(tx.transaction());
+    }
+
+    auto header = result.header();
+    header.transaction_count = count;
+    const chain::block block(header, transactions, result.blocksig(),
+        result.public_key());
+
+    out_block = block.to_data();
+    out_height = height_++;
+    return error::success;
+}
+
+void database_block_source::close()
+{
+    if (!opened_)
+        return;
+
+    opened_ = false;
+    database_.stop();
+    database_.close();
+}
+
+// block_replayer
+// ----------------------------------------------------------------------------
+
+block_replayer::block_replayer(block_chain_impl& chain, size_t sync_interval,
+    bool trust_checkpoints)
+  : chain_(chain),
+    use_testnet_rules_(chain.chain_settings().use_testnet_rules),
+    checkpoints_(checkpoint::sort(chain.chain_settings().checkpoints)),
+    sync_interval_(std::max(sync_interval, size_t(1))),
+    trust_checkpoints_(trust_checkpoints),
+    unsynchronized_(0),
+    stopped_(false),
+    totals_{}
+{
+}
+
+void block_replayer::stop()
+{
+    stopped_ = true;
+}
+
+bool block_replayer::stopped() const
+{
+    return stopped_;
+}
+
+const block_replayer::timings& block_replayer::totals() const
+{
+    return totals_;
+}
+
+code block_replayer::replay(block_source& source)
+{
+    if (!source.open())
+        return error::file_system;
+
+    code ec(error::success);
+    data_chunk data;
+    uint64_t height;
+
+    while (!stopped())
+    {
+        const auto read = source.next(data, height);
+
+        // A damaged source fails the replay, only its end completes it.
+        if (read.value() == error::not_found)
+            break;
+
+        if (read)
+        {
+            ec = read;
+            break;
+        }
+
+        ec = replay(data, height);
+        if (ec)
+        {
+            log::error(LOG_BLOCKCHAIN)
+                << "replay: block [" << height << "] failed, " << ec.message();
+            break;
+        }
+    }
+
+    source.close();
+
+    // Flush the tail of the last interval even if the replay failed.
+    if (unsynchronized_ != 0)
+    {
+        const auto sync = [this]()
+        {
+            block_chain_writer locked_write(chain_);
+            chain_.synchronize();
+        };
+
+        totals_.sync += timer<duration>::duration(sync);
+        unsynchronized_ = 0;
+    }
+
+    if (!ec && stopped())
+        ec = error::service_stopped;
+
+    return ec;
+}
+
+code block_replayer::replay(const data_chunk& data, uint64_t height)
+{
+    uint64_t top;
+    if (!chain_.get_last_height(top) || height != top + 1)
+        return error::previous_block_invalid;
+
+    block_detail::ptr detail;
+    const auto deserialize = [&data, &detail]()
+    {
+        chain::block block;
+        if (block.from_data(data))
+            detail = std::make_shared<block_detail>(std::move(block));
+    };
+
+    totals_.deserialize += timer<duration>::duration(deserialize);
+    if (!detail)
+        return error::bad_stream;
+
+    const auto& block = detail->actual();
+    const block_detail::list orphan_chain{ detail };
+    const auto callback = [this]()
+    {
+        return stopped();
+    };
+
+    // The block is the only member of its orphan chain, forking at the top.
+    validate_block_impl validate(chain_, top, orphan_chain, 0, height,
+        *block, use_testnet_rules_, checkpoints_, callback);
+
+    code ec(error::success);
+    const auto check = [this, &ec, &validate]()
+    {
+        ec = validate.check_block(chain_);
+    };
+
+    totals_.check += timer<duration>::duration(check);
+    if (ec)
+        return ec;
+
+    const auto accept = [&ec, &validate]()
+    {
+        ec = validate.accept_block();
+    };
+
+    totals_.accept += timer<duration>::duration(accept);
+    if (ec)
+        return ec;
+
+    // By default this connects below the last checkpoint as well, so that
+    // the replay measures full validation of every block.
+    const auto trusted = trust_checkpoints_ && !checkpoints_.empty() &&
+        height <= checkpoints_.back().height();
+
+    const auto connect = [this, &ec, &validate]()
+    {
+        hash_digest err_tx;
+        ec = validate.connect_block(err_tx, chain_);
+    };
+
+    if (trusted)
+        ++totals_.trusted;
+    else
+        totals_.connect += timer<duration>::duration(connect);
+
+    if (ec)
+        return ec;
+
+    auto imported = false;
+    const auto store = [this, &imported, &block, height]()
+    {
+        block_chain_writer locked_write(chain_);
+        imported = chain_.import(block, height, false);
+    };
+
+    totals_.store += timer<duration>::duration(store);
+    if (!imported)
+        return error::service_stopped;
+
+    if (++unsynchronized_ >= sync_interval_)
+    {
+        const auto sync = [this]()
+        {
+            block_chain_writer locked_write(chain_);
+            chain_.synchronize();
+        };
+
+        totals_.sync += timer<duration>::duration(sync);
+        unsynchronized_ = 0;
+    }
+
+    const auto& txs = block->transactions;
+    const auto inputs = [](uint64_t total, const transaction& tx)
+    {
+        return total + tx.inputs.size();
+    };
+
+    ++totals_.blocks;
+    totals_.transactions += txs.size();
+    totals_.inputs += std::accumulate(txs.begin(), txs.end(), uint64_t(0),
+        inputs);
+
+    log::debug(LOG_BLOCKCHAIN)
+        << "replay: block [" << height << "] stored (" << txs.size()
+        << ") txs";
+    return ec;
+}
+
+} // namespace blockchain
+} // namespace libbitcoin
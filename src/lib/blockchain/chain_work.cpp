@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <metaverse/blockchain/chain_work.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <metaverse/bitcoin.hpp>
+
+namespace libbitcoin {
+namespace blockchain {
+
+// Entries are running totals from an arbitrary origin, prior_ being the
+// total just below base_, so any range sum is the difference of two totals.
+chain_work::chain_work(size_t window)
+  : window_(window == 0 ? 1 : window),
+    base_(0),
+    prior_(0)
+{
+}
+
+void chain_work::clear()
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+
+    cumulative_.clear();
+    base_ = 0;
+    prior_ = 0;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void chain_work::push(uint64_t height, const u256& work)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+
+    if (cumulative_.empty())
+    {
+        base_ = height;
+        prior_ = 0;
+    }
+    else if (height != base_ + cumulative_.size())
+    {
+        return;
+    }
+
+    const auto total = cumulative_.empty() ? prior_ : cumulative_.back();
+    cumulative_.push_back(total + work);
+
+    if (cumulative_.size() > window_)
+    {
+        prior_ = cumulative_.front();
+        cumulative_.pop_front();
+        ++base_;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void chain_work::pop(uint64_t height)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(mutex_);
+
+    if (height <= base_)
+    {
+        cumulative_.clear();
+        return;
+    }
+
+    const auto count = height - base_;
+    if (count < cumulative_.size())
+        cumulative_.resize(static_cast<size_t>(count));
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+bool chain_work::covers(uint64_t top) const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+
+    return !cumulative_.empty() && base_ + cumulative_.size() - 1 == top;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+uint64_t chain_work::base() const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+
+    return base_;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+bool chain_work::sum(u256& out_work, uint64_t height) const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+
+    if (cumulative_.empty() || height < base_)
+        return false;
+
+    const auto top = base_ + cumulative_.size() - 1;
+    if (height > top)
+    {
+        out_work = 0;
+        return true;
+    }
+
+    const auto below = height == base_ ? prior_ :
+        cumulative_[static_cast<size_t>(height - base_ - 1)];
+
+    out_work = cumulative_.back() - below;
+    return true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+} // namespace blockchain
+} // namespace libbitcoin
@@ -47,14 +47,14 @@ using namespace bc::config;
 
 #define NAME "organizer"
 
-organizer::organizer(threadpool& pool, block_chain_impl& chain,
-    const settings& settings)
+organizer::organizer(threadpool& pool, scheduler& fanout,
+    block_chain_impl& chain, const settings& settings)
   : stopped_(true),
     use_testnet_rules_(settings.use_testnet_rules),
     checkpoints_(checkpoint::sort(settings.checkpoints)),
     chain_(chain),
     orphan_pool_(settings.block_pool_capacity),
-    subscriber_(std::make_shared<reorganize_subscriber>(pool, NAME))
+    subscriber_(std::make_shared<reorganize_subscriber>(pool, fanout, NAME))
 {
 }
 
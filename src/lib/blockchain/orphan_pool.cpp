@@ -22,42 +22,54 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <metaverse/blockchain/block.hpp>
 #include <metaverse/blockchain/block_detail.hpp>
 
 namespace libbitcoin {
 namespace blockchain {
 
+// The number of oldest blocks considered for each eviction.
+static constexpr size_t eviction_window = 16;
+
 orphan_pool::orphan_pool(size_t capacity)
+  : capacity_(capacity == 0 ? 1 : capacity),
+    sequence_(0)
 {
-    buffer_.reserve(capacity == 0 ? 1 : capacity);
+    blocks_.reserve(capacity_);
 }
 
 // There is no validation whatsoever of the block up to this pont.
 bool orphan_pool::add(block_detail::ptr block)
 {
     const auto& header = block->actual()->header;
+    const auto hash = block->hash();
 
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
     mutex_.lock_upgrade();
 
     // No duplicates allowed.
-    if (exists(header))
+    if (exists(hash))
     {
         mutex_.unlock_upgrade();
         //-----------------------------------------------------------------
         return false;
     }
 
-    const auto old_size = buffer_.size();
+    const auto old_size = blocks_.size();
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
     mutex_.unlock_upgrade_and_lock();
-    buffer_.push_back(block);
+
+    if (blocks_.size() >= capacity_)
+        evict();
+
+    insert(hash, block);
     mutex_.unlock();
     ///////////////////////////////////////////////////////////////////////////
 
     log::debug(LOG_BLOCKCHAIN)
-        << "Orphan pool added block [" << encode_hash(block->hash())
+        << "Orphan pool added block [" << encode_hash(hash)
         << "] previous [" << encode_hash(header.previous_block_hash)
         << "] old size (" << old_size << ").";
 
@@ -66,32 +78,33 @@ bool orphan_pool::add(block_detail::ptr block)
 
 void orphan_pool::remove(block_detail::ptr block)
 {
+    const auto hash = block->hash();
+
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
     mutex_.lock_upgrade();
 
-    const auto it = std::find(buffer_.begin(), buffer_.end(), block);
+    const auto it = blocks_.find(hash);
 
-    if (it == buffer_.end())
+    if (it == blocks_.end() || it->second.block != block)
     {
         mutex_.unlock_upgrade();
         //-----------------------------------------------------------------
         return;
     }
 
-    const auto old_size = buffer_.size();
+    const auto old_size = blocks_.size();
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
     mutex_.unlock_upgrade_and_lock();
-    buffer_.erase(it);
+    erase(it);
     mutex_.unlock();
     ///////////////////////////////////////////////////////////////////////////
 
     log::debug(LOG_BLOCKCHAIN)
-        << "Orphan pool removed block [" << encode_hash(block->hash())
+        << "Orphan pool removed block [" << encode_hash(hash)
         << "] old size (" << old_size << "). with status: " << block->error().message();
 }
 
-// TODO: use hash table pool to eliminate this O(n^2) search.
 void orphan_pool::filter(message::get_data::ptr message) const
 {
     auto& inventories = message->inventories;
@@ -108,10 +121,11 @@ void orphan_pool::filter(message::get_data::ptr message) const
     ///////////////////////////////////////////////////////////////////////////
 }
 
+// Each step is a hash lookup of the parent, so this is linear in the length
+// of the returned chain rather than in the size of the pool.
 block_detail::list orphan_pool::trace(block_detail::ptr end) const
 {
     block_detail::list trace;
-    trace.reserve(buffer_.size());
     trace.push_back(end);
     auto hash = end->actual()->header.previous_block_hash;
 
@@ -119,10 +133,15 @@ block_detail::list orphan_pool::trace(block_detail::ptr end) const
     // Critical Section
     mutex_.lock_shared();
 
-    for (auto it = rfind(buffer_.rbegin(), hash); it != buffer_.rend(); it = rfind(it, hash))
+    for (auto it = blocks_.find(hash); it != blocks_.end();
+        it = blocks_.find(hash))
     {
-        trace.push_back(*it);
-        hash = (*it)->actual()->header.previous_block_hash;
+        // Guard against a trace that has wrapped back to its end.
+        if (it->second.block == end)
+            break;
+
+        trace.push_back(it->second.block);
+        hash = it->second.block->actual()->header.previous_block_hash;
     }
 
     mutex_.unlock_shared();
@@ -130,23 +149,26 @@ block_detail::list orphan_pool::trace(block_detail::ptr end) const
 
     BITCOIN_ASSERT(!trace.empty());
     std::reverse(trace.begin(), trace.end());
-    trace.shrink_to_fit();
     return trace;
 }
 
 block_detail::list orphan_pool::unprocessed() const
 {
     block_detail::list unprocessed;
-    unprocessed.reserve(buffer_.size());
 
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
     mutex_.lock_shared();
 
+    unprocessed.reserve(blocks_.size());
+
     // Earlier blocks enter pool first, so reversal helps avoid fragmentation.
-    for (auto it = buffer_.rbegin(); it != buffer_.rend(); ++it)
-        if (!(*it)->processed())
-            unprocessed.push_back(*it);
+    for (auto it = arrivals_.rbegin(); it != arrivals_.rend(); ++it)
+    {
+        const auto& block = blocks_.at(it->second).block;
+        if (!block->processed())
+            unprocessed.push_back(block);
+    }
 
     mutex_.unlock_shared();
     ///////////////////////////////////////////////////////////////////////////
@@ -187,44 +209,77 @@ block_detail::ptr orphan_pool::delete_pending_block(const hash_digest& needed_bl
 
 bool orphan_pool::exists(const hash_digest& hash) const
 {
-    const auto match = [&hash](const block_detail::ptr& entry)
-    {
-        return hash == entry->hash();
-    };
-
-    return std::any_of(buffer_.begin(), buffer_.end(), match);
+    return blocks_.find(hash) != blocks_.end();
 }
 
-bool orphan_pool::exists(const chain::header& header) const
+bool orphan_pool::has_children(const hash_digest& hash) const
 {
-    const auto match = [&header](const block_detail::ptr& entry)
-    {
-        return header == entry->actual()->header;
-    };
+    return children_.find(hash) != children_.end();
+}
 
-    return std::any_of(buffer_.begin(), buffer_.end(), match);
+void orphan_pool::insert(const hash_digest& hash, block_detail::ptr block)
+{
+    const auto sequence = sequence_++;
+    const auto& parent = block->actual()->header.previous_block_hash;
+    blocks_.emplace(hash, entry{ block, sequence });
+    arrivals_.emplace(sequence, hash);
+    children_.emplace(parent, hash);
 }
 
-/*
-orphan_pool::const_iterator orphan_pool::find(buffer::const_iterator begin, const hash_digest& hash) const
+void orphan_pool::erase(blocks::const_iterator it)
 {
-    const auto match = [&hash](const block_detail::ptr& entry)
+    const auto& hash = it->first;
+    const auto& parent = it->second.block->actual()->header.previous_block_hash;
+    const auto range = children_.equal_range(parent);
+
+    for (auto child = range.first; child != range.second; ++child)
     {
-        return hash == entry->hash();
-    };
+        if (child->second == hash)
+        {
+            children_.erase(child);
+            break;
+        }
+    }
 
-    return std::find_if(begin, buffer_.end(), match);
+    arrivals_.erase(it->second.sequence);
+    blocks_.erase(it);
 }
-*/
 
-orphan_pool::const_reverse_iterator orphan_pool::rfind(buffer::const_reverse_iterator begin, const hash_digest& hash) const
+// Evicting a parent would strand its children, so leaves go first, then the
+// least work, then the oldest, all within the oldest few blocks.
+void orphan_pool::evict()
 {
-    const auto match = [&hash](const block_detail::ptr& entry)
+    if (arrivals_.empty())
+        return;
+
+    auto victim = blocks_.end();
+    auto victim_parent = true;
+    u256 victim_work = 0;
+    size_t count = 0;
+
+    for (auto it = arrivals_.begin(); it != arrivals_.end() &&
+        count < eviction_window; ++it, ++count)
     {
-        return hash == entry->hash();
-    };
+        const auto candidate = blocks_.find(it->second);
+        BITCOIN_ASSERT(candidate != blocks_.end());
+        const auto parent = has_children(it->second);
+        const auto work = block_work(
+            candidate->second.block->actual()->header.bits);
+
+        if (victim == blocks_.end() || (victim_parent && !parent) ||
+            (victim_parent == parent && work < victim_work))
+        {
+            victim = candidate;
+            victim_parent = parent;
+            victim_work = work;
+        }
+    }
+
+    log::debug(LOG_BLOCKCHAIN)
+        << "Orphan pool evicted block [" << encode_hash(victim->first)
+        << "] at capacity (" << capacity_ << ").";
 
-    return std::find_if(begin, buffer_.rend(), match);
+    erase(victim);
 }
 
 } // namespace blockchain
@@ -40,15 +40,15 @@ using namespace std::placeholders;
 
 using string = std::string;
 
-transaction_pool::transaction_pool(threadpool& pool, block_chain& chain,
-                                   const settings& settings)
+transaction_pool::transaction_pool(threadpool& pool, scheduler& fanout,
+                                   block_chain& chain, const settings& settings)
     : stopped_(true),
       maintain_consistency_(settings.transaction_pool_consistency),
       buffer_(settings.transaction_pool_capacity),
       dispatch_(pool, NAME),
       blockchain_(chain),
       index_(pool, chain),
-      subscriber_(std::make_shared<transaction_subscriber>(pool, NAME))
+      subscriber_(std::make_shared<transaction_subscriber>(pool, fanout, NAME))
 {
 }
 
@@ -159,128 +159,7 @@ void transaction_pool::handle_validated(const code& ec, transaction_ptr tx,
 
 code transaction_pool::check_symbol_repeat(transaction_ptr tx)
 {
-    std::set<string> assets;
-    std::set<string> asset_certs;
-    std::set<string> asset_mits;
-    std::set<string> dids;
-    std::set<string> didaddreses;
-    std::set<string> didattaches;
-
-    auto check_outputs = [&](transaction_ptr txs)->code
-    {
-        for (auto &output : txs->outputs)
-        {
-            //add attachment check;avoid send with did while transfer
-            if (output.attach_data.get_version() == DID_ATTACH_VERIFY_VERSION)
-            {
-                auto check_did = [&dids, &didattaches](string attach_did) {
-                    if (!attach_did.empty() && dids.find(attach_did) != dids.end())
-                    {
-                        log::debug(LOG_BLOCKCHAIN)
-                        << "check_symbol_repeat attachment did: " + attach_did
-                        << " already exists in memorypool!";
-                        return false;
-                    }
-
-                    didattaches.insert(attach_did);
-                    return true;
-                };
-
-                if (!check_did(output.attach_data.get_from_did())
-                 || !check_did(output.attach_data.get_to_did())) {
-                    log::debug(LOG_BLOCKCHAIN)
-                        << "check_symbol_repeat from_did " + output.attach_data.get_from_did()
-                        << " to_did " + output.attach_data.get_to_did()
-                        << " check failed!"
-                        << " " << tx->to_string(1);
-                    return error::did_exist;
-                }
-            }
-
-            if (output.is_asset_issue())
-            {
-                auto r = assets.insert(output.get_asset_symbol());
-                if (r.second == false)
-                {
-                    log::debug(LOG_BLOCKCHAIN)
-                        << "check_symbol_repeat asset " + output.get_asset_symbol()
-                        << " already exists in memorypool!"
-                        << " " << tx->to_string(1);
-                    return error::asset_exist;
-                }
-            }
-            else if (output.is_asset_cert())
-            {
-                auto &&key = output.get_asset_cert().get_key();
-                auto r = asset_certs.insert(key);
-                if (r.second == false)
-                {
-                    log::debug(LOG_BLOCKCHAIN)
-                        << "check_symbol_repeat cert " + output.get_asset_cert_symbol()
-                        << " with type " << output.get_asset_cert_type()
-                        << " already exists in memorypool!"
-                        << " " << tx->to_string(1);
-                    return error::asset_cert_exist;
-                }
-            }
-            else if (output.is_asset_mit())
-            {
-                auto r = asset_mits.insert(output.get_asset_symbol());
-                if (r.second == false)
-                {
-                    log::debug(LOG_BLOCKCHAIN)
-                        << "check_symbol_repeat mit " + output.get_asset_symbol()
-                        << " already exists in memorypool!"
-                        << " " << tx->to_string(1);
-                    return error::mit_exist;
-                }
-            }
-            else if (output.is_did())
-            {
-                auto didsymbol = output.get_did_symbol();
-                auto didexist = dids.insert(didsymbol);
-                if (didexist.second == false) {
-                    log::debug(LOG_BLOCKCHAIN)
-                        << "check_symbol_repeat did " + didsymbol
-                        << " already exists in memorypool!"
-                        << " " << tx->to_string(1);
-                    return error::did_exist;
-                }
-
-                auto didaddress = didaddreses.insert(output.get_did_address());
-                if (didaddress.second == false)
-                {
-                    log::debug(LOG_BLOCKCHAIN)
-                        << "check_symbol_repeat did address " + output.get_did_address()
-                        << " already has did on it in memorypool!"
-                        << " " << tx->to_string(1);
-                    return error::address_registered_did;
-                }
-
-                if (didattaches.find(didsymbol) != didattaches.end())
-                {
-                    log::debug(LOG_BLOCKCHAIN)
-                        << "check_symbol_repeat attachment did: " + didsymbol
-                        << " already transfer in memorypool!"
-                        << " " << tx->to_string(1);
-                    return error::did_exist;
-                }
-            }
-        }
-        return error::success;
-    };
-
-    code ec;
-    for (auto &item : buffer_)
-    {
-        if (!item.tx)
-            continue;
-
-        if((ec = check_outputs(item.tx)))
-            break;
-    }
-
-    return (ec.value() != error::success) ? ec : check_outputs(tx);
+    return symbols_.check(*tx);
 }
 
 // handle_confirm will never fire if handle_validate returns a failure code.
@@ -379,6 +258,7 @@ void transaction_pool::delete_tx(const hash_digest& tx_hash)
             if (item->tx->hash() == tx_hash)
             {
                 log::debug(LOG_BLOCKCHAIN) << " delete_tx hash:" << libbitcoin::encode_hash(tx_hash) << " success";
+                symbols_.remove(*item->tx);
                 buffer_.erase(item);
                 break;
             }
@@ -530,7 +410,15 @@ void transaction_pool::add(transaction_ptr tx, confirm_handler handler)
     if (maintain_consistency_ && buffer_.size() == buffer_.capacity())
         delete_package(error::pool_filled);
 
+    if (buffer_.capacity() == 0)
+        return;
+
+    // Otherwise the circular buffer overwrites the oldest.
+    if (buffer_.full())
+        symbols_.remove(*buffer_.front().tx);
+
     buffer_.push_back({ tx, handler });
+    symbols_.add(*tx);
 }
 
 // There has been a reorg, clear the memory pool using the given reason code.
@@ -540,6 +428,7 @@ void transaction_pool::clear(const code& ec)
         entry.handle_confirm(ec, entry.tx);
 
     buffer_.clear();
+    symbols_.clear();
 }
 
 // Delete memory pool txs that are obsoleted by a new block acceptance.
@@ -658,6 +547,7 @@ bool transaction_pool::delete_single(const hash_digest& tx_hash, const code& ec)
         return false;
 
     it->handle_confirm(ec, it->tx);
+    symbols_.remove(*it->tx);
     buffer_.erase(it);
 
     if (ec) {
@@ -673,6 +563,7 @@ bool transaction_pool::delete_single(const hash_digest& tx_hash, const code& ec)
             break;
 
         it->handle_confirm(ec, it->tx);
+        symbols_.remove(*it->tx);
         buffer_.erase(it);
     }
 
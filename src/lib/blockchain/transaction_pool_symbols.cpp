@@ -0,0 +1,244 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <metaverse/blockchain/transaction_pool_symbols.hpp>
+
+#include <set>
+#include <string>
+#include <metaverse/bitcoin.hpp>
+
+namespace libbitcoin {
+namespace blockchain {
+
+using namespace chain;
+
+void transaction_pool_symbols::add(const transaction& tx)
+{
+    const auto tx_hash = tx.hash();
+
+    for (const auto& output: tx.outputs)
+    {
+        if (output.attach_data.get_version() == DID_ATTACH_VERIFY_VERSION)
+        {
+            const auto& from_did = output.attach_data.get_from_did();
+            const auto& to_did = output.attach_data.get_to_did();
+
+            if (!from_did.empty())
+                did_attachments_.emplace(from_did, tx_hash);
+
+            if (!to_did.empty())
+                did_attachments_.emplace(to_did, tx_hash);
+        }
+
+        if (output.is_asset_issue())
+            assets_.emplace(output.get_asset_symbol(), tx_hash);
+        else if (output.is_asset_cert())
+            certs_.emplace(output.get_asset_cert().get_key(), tx_hash);
+        else if (output.is_asset_mit())
+            mits_.emplace(output.get_asset_symbol(), tx_hash);
+        else if (output.is_did())
+        {
+            dids_.emplace(output.get_did_symbol(), tx_hash);
+            did_addresses_.emplace(output.get_did_address(), tx_hash);
+        }
+    }
+}
+
+void transaction_pool_symbols::remove(const transaction& tx)
+{
+    const auto tx_hash = tx.hash();
+
+    for (const auto& output: tx.outputs)
+    {
+        if (output.attach_data.get_version() == DID_ATTACH_VERIFY_VERSION)
+        {
+            erase(did_attachments_, output.attach_data.get_from_did(), tx_hash);
+            erase(did_attachments_, output.attach_data.get_to_did(), tx_hash);
+        }
+
+        if (output.is_asset_issue())
+            erase(assets_, output.get_asset_symbol(), tx_hash);
+        else if (output.is_asset_cert())
+            erase(certs_, output.get_asset_cert().get_key(), tx_hash);
+        else if (output.is_asset_mit())
+            erase(mits_, output.get_asset_symbol(), tx_hash);
+        else if (output.is_did())
+        {
+            erase(dids_, output.get_did_symbol(), tx_hash);
+            erase(did_addresses_, output.get_did_address(), tx_hash);
+        }
+    }
+}
+
+void transaction_pool_symbols::clear()
+{
+    assets_.clear();
+    certs_.clear();
+    mits_.clear();
+    dids_.clear();
+    did_addresses_.clear();
+    did_attachments_.clear();
+}
+
+// Local sets catch repeats within the transaction itself, as the pool
+// indexes do not yet contain it.
+code transaction_pool_symbols::check(const transaction& tx) const
+{
+    std::set<std::string> assets;
+    std::set<std::string> certs;
+    std::set<std::string> mits;
+    std::set<std::string> dids;
+    std::set<std::string> did_addresses;
+    std::set<std::string> did_attachments;
+
+    const auto pooled = [](const symbol_map& map, const std::string& key)
+    {
+        return map.find(key) != map.end();
+    };
+
+    for (const auto& output: tx.outputs)
+    {
+        // Avoid sending with a did while that did is being registered.
+        if (output.attach_data.get_version() == DID_ATTACH_VERIFY_VERSION)
+        {
+            const auto check_did = [&](const std::string& attach_did)
+            {
+                if (!attach_did.empty() && (pooled(dids_, attach_did) ||
+                    dids.count(attach_did) != 0))
+                {
+                    log::debug(LOG_BLOCKCHAIN)
+                        << "check_symbol_repeat attachment did: " + attach_did
+                        << " already exists in memorypool!";
+                    return false;
+                }
+
+                did_attachments.insert(attach_did);
+                return true;
+            };
+
+            if (!check_did(output.attach_data.get_from_did())
+                || !check_did(output.attach_data.get_to_did()))
+            {
+                log::debug(LOG_BLOCKCHAIN)
+                    << "check_symbol_repeat from_did "
+                    + output.attach_data.get_from_did()
+                    << " to_did " + output.attach_data.get_to_did()
+                    << " check failed!"
+                    << " " << tx.to_string(1);
+                return error::did_exist;
+            }
+        }
+
+        if (output.is_asset_issue())
+        {
+            const auto symbol = output.get_asset_symbol();
+            if (pooled(assets_, symbol) || !assets.insert(symbol).second)
+            {
+                log::debug(LOG_BLOCKCHAIN)
+                    << "check_symbol_repeat asset " + symbol
+                    << " already exists in memorypool!"
+                    << " " << tx.to_string(1);
+                return error::asset_exist;
+            }
+        }
+        else if (output.is_asset_cert())
+        {
+            const auto key = output.get_asset_cert().get_key();
+            if (pooled(certs_, key) || !certs.insert(key).second)
+            {
+                log::debug(LOG_BLOCKCHAIN)
+                    << "check_symbol_repeat cert "
+                    + output.get_asset_cert_symbol()
+                    << " with type " << output.get_asset_cert_type()
+                    << " already exists in memorypool!"
+                    << " " << tx.to_string(1);
+                return error::asset_cert_exist;
+            }
+        }
+        else if (output.is_asset_mit())
+        {
+            const auto symbol = output.get_asset_symbol();
+            if (pooled(mits_, symbol) || !mits.insert(symbol).second)
+            {
+                log::debug(LOG_BLOCKCHAIN)
+                    << "check_symbol_repeat mit " + symbol
+                    << " already exists in memorypool!"
+                    << " " << tx.to_string(1);
+                return error::mit_exist;
+            }
+        }
+        else if (output.is_did())
+        {
+            const auto symbol = output.get_did_symbol();
+            if (pooled(dids_, symbol) || !dids.insert(symbol).second)
+            {
+                log::debug(LOG_BLOCKCHAIN)
+                    << "check_symbol_repeat did " + symbol
+                    << " already exists in memorypool!"
+                    << " " << tx.to_string(1);
+                return error::did_exist;
+            }
+
+            const auto address = output.get_did_address();
+            if (pooled(did_addresses_, address) ||
+                !did_addresses.insert(address).second)
+            {
+                log::debug(LOG_BLOCKCHAIN)
+                    << "check_symbol_repeat did address " + address
+                    << " already has did on it in memorypool!"
+                    << " " << tx.to_string(1);
+                return error::address_registered_did;
+            }
+
+            if (pooled(did_attachments_, symbol) ||
+                did_attachments.count(symbol) != 0)
+            {
+                log::debug(LOG_BLOCKCHAIN)
+                    << "check_symbol_repeat attachment did: " + symbol
+                    << " already transfer in memorypool!"
+                    << " " << tx.to_string(1);
+                return error::did_exist;
+            }
+        }
+    }
+
+    return error::success;
+}
+
+// private
+//-----------------------------------------------------------------------------
+
+void transaction_pool_symbols::erase(symbol_map& map, const std::string& key,
+    const hash_digest& tx_hash)
+{
+    const auto range = map.equal_range(key);
+
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second == tx_hash)
+        {
+            map.erase(it);
+            return;
+        }
+    }
+}
+
+} // namespace blockchain
+} // namespace libbitcoin
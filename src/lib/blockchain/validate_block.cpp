@@ -23,6 +23,7 @@
 
 #include <set>
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -451,16 +452,41 @@ code validate_block::connect_block(hash_digest& err_tx, blockchain::block_chain_
     // BIP30 duplicate exceptions are spent and are not indexed.
     if (is_active(script_context::bip30_enabled))
     {
-        ////////////// TODO: parallelize. //////////////
-        for (const auto& tx : transactions)
+        // The lookups are independent reads, so fan them out in slices and
+        // report the first duplicate by position, as a serial scan would.
+        auto& fanout = chain.task_scheduler();
+        const auto total = transactions.size();
+        const auto slices = std::min(total, fanout.size() * 4);
+        std::atomic<size_t> first(total);
+        task_group group(fanout);
+
+        for (size_t slice = 0; slice < slices; ++slice)
         {
-            if (is_spent_duplicate(tx))
+            group.run([&, slice]()
             {
-                err_tx = tx.hash();
-                return error::duplicate_or_spent;
-            }
+                for (auto index = slice; index < total; index += slices)
+                {
+                    if (index > first || stopped())
+                        return;
+
+                    if (!is_spent_duplicate(transactions[index]))
+                        continue;
+
+                    auto prior = first.load();
+                    while (index < prior &&
+                        !first.compare_exchange_weak(prior, index));
+                    return;
+                }
+            });
+        }
 
-            RETURN_IF_STOPPED();
+        group.wait();
+        RETURN_IF_STOPPED();
+
+        if (first < total)
+        {
+            err_tx = transactions[first].hash();
+            return error::duplicate_or_spent;
         }
     }
 
@@ -25,6 +25,13 @@
 #include <memory>
 #include <stdexcept>
 #include <algorithm>
+#include <vector>
+#ifdef __linux__
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/ioctl.h>
+    #include <linux/fs.h>
+#endif
 #include <boost/filesystem.hpp>
 #include <metaverse/bitcoin.hpp>
 #include <metaverse/bitcoin/utility/path.hpp>
@@ -305,6 +312,23 @@ data_base::store::store(const path& prefix)
     database_lock = prefix / "process_lock";
 }
 
+std::vector<data_base::path> data_base::store::files() const
+{
+    return
+    {
+        blocks_lookup, blocks_index, history_lookup, history_rows,
+        stealth_rows, spends_lookup, transactions_lookup,
+        /* begin database for account, asset, address_asset relationship */
+        accounts_lookup, assets_lookup, certs_lookup, witness_certs_lookup,
+        address_assets_lookup, address_assets_rows, account_assets_lookup,
+        account_assets_rows, dids_lookup, address_dids_lookup,
+        address_dids_rows, account_addresses_lookup, account_addresses_rows,
+        /* end database for account, asset, address_asset relationship */
+        mits_lookup, address_mits_lookup, address_mits_rows,
+        mit_history_lookup, mit_history_rows, witness_profiles_lookup
+    };
+}
+
 bool data_base::store::touch_all() const
 {
     // Return the result of the database file create.
@@ -532,6 +556,7 @@ data_base::data_base(const settings& settings)
   : data_base(settings.directory, settings.history_start_height,
         settings.stealth_start_height)
 {
+    set_policies(settings);
 }
 
 data_base::data_base(const path& prefix, size_t history_height,
@@ -542,7 +567,8 @@ data_base::data_base(const path& prefix, size_t history_height,
 
 data_base::data_base(const store& paths, size_t history_height,
     size_t stealth_height)
-  : lock_file_path_(paths.database_lock),
+  : paths_(paths),
+    lock_file_path_(paths.database_lock),
     history_height_(history_height),
     stealth_height_(stealth_height),
     sequential_lock_(0),
@@ -570,6 +596,42 @@ data_base::data_base(const store& paths, size_t history_height,
 {
 }
 
+// Policies take effect as each file is started.
+void data_base::set_policies(const settings& settings)
+{
+    typedef memory_map::policy::access access;
+
+    const auto contains = [](const std::vector<std::string>& names,
+        const std::string& name)
+    {
+        return std::find(names.begin(), names.end(), name) != names.end();
+    };
+
+    auto advice = access::random;
+    if (settings.file_access == "normal")
+        advice = access::normal;
+    else if (settings.file_access == "sequential")
+        advice = access::sequential;
+    else if (settings.file_access == "willneed")
+        advice = access::willneed;
+    else if (settings.file_access != "random")
+        log::warning(LOG_DATABASE) << "Unknown database.file_access '"
+            << settings.file_access << "', using random.";
+
+    for (const auto& file: paths_.files())
+    {
+        const auto name = file.filename().string();
+
+        memory_map::policy policy;
+        policy.advice = advice;
+        policy.huge_pages = contains(settings.huge_page_files, name);
+        policy.lock_header = contains(settings.locked_header_files, name);
+        policy.preallocate = settings.preallocate_files;
+        policy.expansion = std::max(settings.file_growth_rate, uint32_t(100));
+        memory_map::set_policy(file, policy);
+    }
+}
+
 // Close does not call stop because there is no way to detect thread join.
 data_base::~data_base()
 {
@@ -893,6 +955,74 @@ void data_base::synchronize()
     witness_profiles.sync();
 }
 
+// Clone the file where the file system shares extents (btrfs, xfs), which is
+// near instant and takes no space, otherwise fall back to a full copy.
+static bool copy_store_file(const path& from, const path& to)
+{
+#ifdef FICLONE
+    const auto source = ::open(from.string().c_str(), O_RDONLY);
+    if (source != -1)
+    {
+        const auto target = ::open(to.string().c_str(),
+            O_WRONLY | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+        const auto cloned = target != -1 && ::ioctl(target, FICLONE, source) == 0;
+
+        if (target != -1)
+            ::close(target);
+
+        ::close(source);
+
+        if (cloned)
+            return true;
+
+        boost::system::error_code ignored;
+        remove(to, ignored);
+    }
+#endif
+
+    boost::system::error_code ec;
+    copy_file(from, to, ec);
+    return !ec;
+}
+
+bool data_base::snapshot(const path& directory)
+{
+    boost::system::error_code ec;
+    if (exists(directory, ec) || !create_directories(directory, ec))
+    {
+        log::error(LOG_DATABASE)
+            << "Snapshot directory " << directory << " cannot be created.";
+        return false;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section.
+    // Files are copied from the page cache, so no file may be remapped
+    // between the sync and the copy. This does not exclude writers.
+    unique_lock lock(*mutex_);
+
+    // Table headers and row counts are written to the maps on sync.
+    synchronize();
+
+    auto files = paths_.files();
+    files.push_back(lock_file_path_.parent_path() / db_metadata::file_name);
+
+    for (const auto& file: files)
+    {
+        if (!copy_store_file(file, directory / file.filename()))
+        {
+            log::error(LOG_DATABASE)
+                << "Snapshot failed to copy " << file << " to " << directory;
+            return false;
+        }
+    }
+    ///////////////////////////////////////////////////////////////////////////
+
+    log::info(LOG_DATABASE)
+        << "Snapshot of " << files.size() << " files written to " << directory;
+    return true;
+}
+
 void data_base::synchronize_dids()
 {
     dids.sync();
@@ -928,6 +1058,11 @@ void data_base::push(const block& block)
 }
 
 void data_base::push(const block& block, uint64_t height)
+{
+    push(block, height, true);
+}
+
+void data_base::push(const block& block, uint64_t height, bool sync)
 {
     for (size_t index = 0; index < block.transactions.size(); ++index)
     {
@@ -959,7 +1094,8 @@ void data_base::push(const block& block, uint64_t height)
     blocks.store(block, height);
 
     // Synchronise everything that was added.
-    synchronize();
+    if (sync)
+        synchronize();
 }
 
 void data_base::push_inputs(const hash_digest& tx_hash, size_t height,
@@ -1102,7 +1238,6 @@ bool data_base::pop(chain::block& block)
             pop_inputs(tx->inputs, height);
     }
 
-    // Stealth unlink is not implemented.
     stealth.unlink(height);
     blocks.unlink(height);
     blocks.remove(block.header.hash()); // wdy remove block from block hash table
@@ -20,9 +20,11 @@
  */
 #include <metaverse/database/databases/stealth_database.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <utility>
 #include <boost/filesystem.hpp>
 #include <metaverse/bitcoin.hpp>
 #include <metaverse/database/memory/memory.hpp>
@@ -41,10 +43,16 @@ constexpr size_t prefix_size = sizeof(uint32_t);
 constexpr size_t row_size = prefix_size + height_size + hash_size +
     short_hash_size + hash_size;
 
+// Filters match from the first little endian byte of the prefix, so rows are
+// partitioned by that byte.
+constexpr size_t partition_bits = byte_bits;
+constexpr size_t partition_count = size_t(1) << partition_bits;
+
 stealth_database::stealth_database(const path& rows_filename,
     std::shared_ptr<shared_mutex> mutex)
   : rows_file_(rows_filename, mutex),
-    rows_manager_(rows_file_, 0, row_size)
+    rows_manager_(rows_file_, 0, row_size),
+    partitions_(partition_count)
 {
 }
 
@@ -71,7 +79,11 @@ bool stealth_database::create()
         return false;
 
     // Should not call start after create, already started.
-    return rows_manager_.start();
+    if (!rows_manager_.start())
+        return false;
+
+    build_index();
+    return true;
 }
 
 // Startup and shutdown.
@@ -79,9 +91,11 @@ bool stealth_database::create()
 
 bool stealth_database::start()
 {
-    return
-        rows_file_.start() &&
-        rows_manager_.start();
+    if (!rows_file_.start() || !rows_manager_.start())
+        return false;
+
+    build_index();
+    return true;
 }
 
 bool stealth_database::stop()
@@ -97,30 +111,56 @@ bool stealth_database::close()
 // ----------------------------------------------------------------------------
 
 // The prefix is fixed at 32 bits, but the filter is 0-32 bits, so the records
-// cannot be indexed using a hash table. We also do not index by height.
+// cannot be indexed using a hash table. A filter of eight or more bits names
+// one partition, a shorter filter a contiguous range of them.
 stealth_compact::list stealth_database::scan(const binary& filter,
     size_t from_height) const
 {
+    const auto bits = std::min(filter.size(), partition_bits);
+    const auto leading = filter.blocks().empty() ? 0 : filter.blocks().front();
+    const size_t first = (leading >> (partition_bits - bits)) <<
+        (partition_bits - bits);
+    const auto last = first + (size_t(1) << (partition_bits - bits));
+
+    std::vector<std::pair<uint32_t, array_index>> rows;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    shared_lock lock(mutex_);
+
+    for (auto index = first; index < last; ++index)
+    {
+        const auto& rows_in = partitions_[index];
+
+        // Partitions are height ordered, so skip directly to from_height.
+        const auto below = [this](array_index row, size_t height)
+        {
+            return read_height(row) < height;
+        };
+
+        auto it = std::lower_bound(rows_in.begin(), rows_in.end(),
+            from_height, below);
+
+        for (; it != rows_in.end(); ++it)
+            if (filter.is_prefix_of(read_prefix(*it)))
+                rows.emplace_back(read_height(*it), *it);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Partitions are each ordered, merge them by height (then row).
+    if (last - first > 1)
+        std::sort(rows.begin(), rows.end());
+
     stealth_compact::list result;
+    result.reserve(rows.size());
 
-    for (array_index row = 0; row < rows_manager_.count(); ++row)
+    for (const auto& row: rows)
     {
-        const auto memory = rows_manager_.get(row);
-        auto record = REMAP_ADDRESS(memory);
-
-        // Skip if prefix doesn't match.
-        const auto field = from_little_endian_unsafe<uint32_t>(record);
-        if (!filter.is_prefix_of(field))
-            continue;
-
-        // Skip if height is too low.
-        record += prefix_size;
-        const auto height = from_little_endian_unsafe<uint32_t>(record);
-        if (height < from_height)
-            continue;
-
-        // Add row to results.
-        auto deserial = make_deserializer_unsafe(record + height_size);
+        const auto memory = rows_manager_.get(row.second);
+        const auto record = REMAP_ADDRESS(memory);
+        auto deserial = make_deserializer_unsafe(
+            record + prefix_size + height_size);
+
         result.push_back(
         {
             deserial.read_hash(),
@@ -129,7 +169,6 @@ stealth_compact::list stealth_database::scan(const binary& filter,
         });
     }
 
-    // TODO: we could sort result here.
     return result;
 }
 
@@ -152,11 +191,36 @@ void stealth_database::store(uint32_t prefix, uint32_t height,
     serial.write_hash(row.ephemeral_public_key_hash);
     serial.write_short_hash(row.public_key_hash);
     serial.write_hash(row.transaction_hash);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
+
+    insert_row(index, prefix, height);
+    ///////////////////////////////////////////////////////////////////////////
 }
 
-void stealth_database::unlink(size_t /* from_height */)
+// Blocks are popped from the top, so rows at and above from_height are the
+// last rows written and the table is truncated to exclude them.
+void stealth_database::unlink(size_t from_height)
 {
-    // TODO: scan by height and mark as deleted.
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
+
+    auto count = rows_manager_.count();
+    while (count > 0 && read_height(count - 1) >= from_height)
+        --count;
+
+    if (count == rows_manager_.count())
+        return;
+
+    for (auto& rows_in: partitions_)
+        while (!rows_in.empty() && rows_in.back() >= count)
+            rows_in.pop_back();
+
+    rows_manager_.set_count(count);
+    ///////////////////////////////////////////////////////////////////////////
 }
 
 void stealth_database::sync()
@@ -164,5 +228,62 @@ void stealth_database::sync()
     rows_manager_.sync();
 }
 
+// private
+//-----------------------------------------------------------------------------
+
+size_t stealth_database::partition_of(uint32_t prefix)
+{
+    return prefix & (partition_count - 1);
+}
+
+uint32_t stealth_database::read_prefix(array_index row) const
+{
+    const auto memory = rows_manager_.get(row);
+    return from_little_endian_unsafe<uint32_t>(REMAP_ADDRESS(memory));
+}
+
+uint32_t stealth_database::read_height(array_index row) const
+{
+    const auto memory = rows_manager_.get(row);
+    return from_little_endian_unsafe<uint32_t>(
+        REMAP_ADDRESS(memory) + prefix_size);
+}
+
+// Rows normally arrive in height order, otherwise the row is placed by height.
+void stealth_database::insert_row(array_index row, uint32_t prefix,
+    uint32_t height)
+{
+    auto& rows_in = partitions_[partition_of(prefix)];
+
+    if (rows_in.empty() || read_height(rows_in.back()) <= height)
+    {
+        rows_in.push_back(row);
+        return;
+    }
+
+    const auto above = [this](uint32_t height, array_index row)
+    {
+        return height < read_height(row);
+    };
+
+    rows_in.insert(std::upper_bound(rows_in.begin(), rows_in.end(), height,
+        above), row);
+}
+
+void stealth_database::build_index()
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
+
+    for (auto& rows_in: partitions_)
+        rows_in.clear();
+
+    const auto count = rows_manager_.count();
+    for (array_index row = 0; row < count; ++row)
+        insert_row(row, read_prefix(row), read_height(row));
+    ///////////////////////////////////////////////////////////////////////////
+}
+
 } // namespace database
 } // namespace libbitcoin
@@ -29,19 +29,10 @@ namespace database {
 
 #ifdef REMAP_SAFETY
 
-accessor::accessor(shared_mutex& mutex, uint8_t*& data)
-  : mutex_(mutex)
+accessor::accessor(uint8_t* data)
+  : data_(data)
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Begin Critical Section
-
-    // Acquire shared lock.
-    mutex_.lock_shared();
-
     BITCOIN_ASSERT_MSG(data != nullptr, "Invalid pointer value.");
-
-    // Save protected pointer.
-    data_ = data;
 }
 
 uint8_t* accessor::buffer()
@@ -55,15 +46,6 @@ void accessor::increment(size_t value)
     data_ += value;
 }
 
-accessor::~accessor()
-{
-    // Release shared lock.
-    mutex_.unlock_shared();
-
-    // End Critical Section
-    ///////////////////////////////////////////////////////////////////////////
-}
-
 #endif // REMAP_SAFETY
 
 } // namespace database
@@ -32,9 +32,11 @@
     #include <sys/mman.h>
     #define FILE_OPEN_PERMISSIONS S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH
 #endif
+#include <cerrno>
 #include <cstddef>
 #include <cstdint>
 #include <fcntl.h>
+#include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -60,6 +62,37 @@ using boost::filesystem::path;
 #define EXPANSION_NUMERATOR 150
 #define EXPANSION_DENOMINATOR 100
 
+// The least address space reserved for a mapping, doubled until it fits.
+static constexpr size_t minimum_reservation = size_t(1) << 30;
+
+// Policies are registered by path before the owning database starts.
+typedef std::map<std::string, memory_map::policy> policy_map;
+static shared_mutex policy_mutex;
+
+static policy_map& policies()
+{
+    static policy_map instance;
+    return instance;
+}
+
+memory_map::policy::policy()
+  : advice(access::random),
+    huge_pages(false),
+    lock_header(false),
+    preallocate(false),
+    expansion(EXPANSION_NUMERATOR)
+{
+}
+
+void memory_map::set_policy(const path& filename, const policy& value)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(policy_mutex);
+    policies()[filename.string()] = value;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
 size_t memory_map::file_size(int file_handle)
 {
     if (file_handle == -1)
@@ -88,6 +121,22 @@ size_t memory_map::file_size(int file_handle)
     return static_cast<size_t>(sbuf.st_size);
 }
 
+// Pages past the end of the file are mapped but never touched, so the file
+// can grow into the reservation without moving the mapping.
+size_t memory_map::reservation(size_t size)
+{
+#ifdef _WIN32
+    // A view cannot extend past the end of the file without growing it.
+    return size;
+#else
+    auto capacity = minimum_reservation;
+    while (capacity < size && capacity <= max_size_t / 2)
+        capacity *= 2;
+
+    return std::max(capacity, size);
+#endif
+}
+
 int memory_map::open_file(const path& filename)
 {
 #ifdef _WIN32
@@ -139,7 +188,9 @@ memory_map::memory_map(const path& filename)
     filename_(filename),
     data_(nullptr),
     file_size_(file_size(file_handle_)),
-    logical_size_(file_size_),
+    logical_size_(file_size_.load()),
+    capacity_(0),
+    locked_size_(0),
     closed_(true),
     stopped_(true)
 {
@@ -179,10 +230,16 @@ bool memory_map::start()
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
     std::string error_name;
 
+    {
+        shared_lock lock(policy_mutex);
+        const auto it = policies().find(filename_.string());
+        policy_ = it == policies().end() ? policy() : it->second;
+    }
+
     // Initialize data_.
     if (!map(file_size_))
         error_name = "map";
-    else if (madvise(data_, 0, MADV_RANDOM) == -1)
+    else if (!advise())
         error_name = "madvise";
     else
     {
@@ -249,7 +306,7 @@ bool memory_map::close()
 
     if (msync(data_, logical_size_, MS_SYNC) == -1)
         error_name = "msync";
-    else if (munmap(data_, file_size_) == -1)
+    else if (!unmap())
         error_name = "munmap";
     else if (ftruncate(file_handle_, logical_size_) == -1)
         error_name = "ftruncate";
@@ -284,18 +341,14 @@ bool memory_map::stopped() const
 
 size_t memory_map::size() const
 {
-    // Critical Section (internal)
-    ///////////////////////////////////////////////////////////////////////////
-    REMAP_READ(mutex_);
-
     return file_size_;
-    ///////////////////////////////////////////////////////////////////////////
 }
 
 // throws runtime_error
+// Lock free, the address remains valid until close even if the map grows.
 memory_ptr memory_map::access()
 {
-    return REMAP_ACCESSOR(data_, mutex_);
+    return REMAP_ACCESSOR(data_.load(), mutex_);
 }
 
 // throws runtime_error
@@ -307,7 +360,7 @@ memory_ptr memory_map::resize(size_t size)
 // throws runtime_error
 memory_ptr memory_map::reserve(size_t size)
 {
-    return reserve(size, EXPANSION_NUMERATOR);
+    return reserve(size, policy_.expansion);
 }
 
 // throws runtime_error
@@ -323,6 +376,7 @@ memory_ptr memory_map::reserve(size_t size, size_t expansion)
     // cross-file integrity. So we must coalesce all threads before closing.
 
     // Critical Section
+    // The upgrade lock orders growth, it does not exclude readers.
     ///////////////////////////////////////////////////////////////////////////
     const auto memory = REMAP_ALLOCATOR(mutex_);
 
@@ -337,19 +391,14 @@ memory_ptr memory_map::reserve(size_t size, size_t expansion)
     {
         const size_t target = size * expansion / EXPANSION_DENOMINATOR;
 
-        mutex_.unlock_upgrade_and_lock();
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-
         // TODO: isolate cause and if recoverable (disk size) return nullptr.
-        // All existing database pointers are invalidated by this call.
+        // Existing database pointers remain valid across this call.
         if (!truncate_mapped(target))
         {
+            REMAP_DOWNGRADE(memory, data_);
             handle_error("resize", filename_);
             throw std::runtime_error("Resize failure, disk space may be low.");
         }
-
-        //---------------------------------------------------------------------
-        mutex_.unlock_and_lock_upgrade();
     }
 
     logical_size_ = size;
@@ -361,9 +410,73 @@ memory_ptr memory_map::reserve(size_t size, size_t expansion)
     ///////////////////////////////////////////////////////////////////////////
 }
 
+void memory_map::lock_header(size_t size)
+{
+    if (!policy_.lock_header)
+        return;
+
+    // Critical Section (internal/unconditional)
+    ///////////////////////////////////////////////////////////////////////////
+    mutex_.lock();
+
+    locked_size_ = std::min(size, file_size_.load());
+    const auto locked = pin();
+
+    mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Usually RLIMIT_MEMLOCK, the header remains pageable.
+    if (!locked)
+        log::warning(LOG_DATABASE)
+            << "Failed to lock " << locked_size_ << " bytes of " << filename_
+            << " : " << errno;
+}
+
 // privates
 // ----------------------------------------------------------------------------
 
+// Hints are best effort, only an invalid access advice is an error.
+bool memory_map::advise()
+{
+    int advice = MADV_RANDOM;
+
+#ifndef _WIN32
+    switch (policy_.advice)
+    {
+        case policy::access::normal:
+            advice = MADV_NORMAL;
+            break;
+        case policy::access::sequential:
+            advice = MADV_SEQUENTIAL;
+            break;
+        case policy::access::willneed:
+            advice = MADV_WILLNEED;
+            break;
+        case policy::access::random:
+        default:
+            advice = MADV_RANDOM;
+            break;
+    }
+#endif
+
+    if (madvise(data_, capacity_, advice) == -1)
+        return false;
+
+#ifdef MADV_HUGEPAGE
+    if (policy_.huge_pages && madvise(data_, capacity_, MADV_HUGEPAGE) == -1)
+        log::debug(LOG_DATABASE)
+            << "Huge pages unavailable for " << filename_ << " : " << errno;
+#endif
+
+    return true;
+}
+
+// A new mapping is not locked, so this is repeated after each remap.
+bool memory_map::pin()
+{
+    return locked_size_ == 0 || mlock(data_, locked_size_) != -1;
+}
+
 size_t memory_map::page()
 {
 #ifdef _WIN32
@@ -385,37 +498,47 @@ size_t memory_map::page()
 
 bool memory_map::unmap()
 {
-    const auto success = (munmap(data_, file_size_) != -1);
+    auto success = (munmap(data_, capacity_) != -1);
+
+    for (const auto& mapping: retired_)
+        success &= (munmap(mapping.first, mapping.second) != -1);
+
+    retired_.clear();
+    capacity_ = 0;
     file_size_ = 0;
     data_ = nullptr;
     return success;
 }
 
+// The current mapping, if any, is left to the caller.
 bool memory_map::map(size_t size)
 {
     if (size == 0)
         return false;
 
-    data_ = reinterpret_cast<uint8_t*>(mmap(0, size, PROT_READ | PROT_WRITE,
-        MAP_SHARED, file_handle_, 0));
-
-    return validate(size);
-}
+    const auto capacity = reservation(size);
+    const auto data = mmap(0, capacity, PROT_READ | PROT_WRITE, MAP_SHARED,
+        file_handle_, 0);
 
-bool memory_map::remap(size_t size)
-{
-#ifdef MREMAP_MAYMOVE
-    data_ = reinterpret_cast<uint8_t*>(mremap(data_, file_size_, size,
-        MREMAP_MAYMOVE));
+    if (data == MAP_FAILED)
+        return false;
 
-    return validate(size);
-#else
-    return unmap() && map(size);
-#endif
+    capacity_ = capacity;
+    file_size_ = size;
+    data_ = reinterpret_cast<uint8_t*>(data);
+    return true;
 }
 
 bool memory_map::truncate(size_t size)
 {
+#ifdef __linux__
+    // Reserve the blocks up front so growth does not fault in a sparse file.
+    const auto current = file_size(file_handle_);
+    if (policy_.preallocate && size > current &&
+        posix_fallocate(file_handle_, current, size - current) == 0)
+        return true;
+#endif
+
     return ftruncate(file_handle_, size) != -1;
 }
 
@@ -427,33 +550,28 @@ bool memory_map::truncate_mapped(size_t size)
     ///////////////////////////////////////////////////////////////////////////
     conditional_lock lock(remap_mutex_);
 
-#ifndef MREMAP_MAYMOVE
-    if (!unmap())
-        return false;
-#endif
-
     if (!truncate(size))
         return false;
 
-#ifndef MREMAP_MAYMOVE
-    return map(size);
-#else
-    return remap(size);
-#endif
-    ///////////////////////////////////////////////////////////////////////////
-}
-
-bool memory_map::validate(size_t size)
-{
-    if (data_ == MAP_FAILED)
+    if (size <= capacity_)
     {
-        file_size_ = 0;
-        data_ = nullptr;
-        return false;
+        file_size_ = size;
+        return true;
     }
 
-    file_size_ = size;
+    // Readers may hold the old address, so it is unmapped only on close.
+    const auto retired = std::make_pair(data_.load(), capacity_);
+
+    if (!map(size))
+        return false;
+
+    retired_.push_back(retired);
+
+    // Hints belong to the mapping, best effort as on start.
+    advise();
+    pin();
     return true;
+    ///////////////////////////////////////////////////////////////////////////
 }
 
 } // namespace database
@@ -30,7 +30,10 @@ using namespace boost::filesystem;
 settings::settings()
   : history_start_height(0),
     stealth_start_height(0),
-    directory("database")
+    directory("database"),
+    file_access("random"),
+    preallocate_files(false),
+    file_growth_rate(150)
 {
 }
 
@@ -135,6 +135,13 @@ console_result dispatch_command(int argc, const char* argv[],
 console_result dispatch_command(int argc, const char* argv[],
     Json::Value& jv_output,
     libbitcoin::server::server_node& node, uint8_t api_version)
+{
+    return dispatch_command(argc, argv, jv_output, nullptr, node, api_version);
+}
+
+console_result dispatch_command(int argc, const char* argv[],
+    Json::Value& jv_output, const emitter_source& begin_stream,
+    libbitcoin::server::server_node& node, uint8_t api_version)
 {
     std::istringstream input;
     std::ostringstream output;
@@ -234,7 +241,11 @@ console_result dispatch_command(int argc, const char* argv[],
             }
         }
 
-        return static_cast<commands::command_extension*>(command.get())->invoke(jv_output, node);
+        const auto extension = static_cast<commands::command_extension*>(command.get());
+        if (begin_stream && extension->streams())
+            return extension->invoke(begin_stream(), node);
+
+        return extension->invoke(jv_output, node);
     }
     else {
         command->set_api_version(1); // only compatible for v1
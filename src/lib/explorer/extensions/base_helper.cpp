@@ -992,6 +992,21 @@ void sync_fetch_deposited_balance(wallet::payment_address& address,
 void sync_fetchbalance(wallet::payment_address& address,
     bc::blockchain::block_chain_impl& blockchain, balances& addr_balance)
 {
+    auto& cache = blockchain.get_account_cache();
+    const auto generation = cache.generation();
+
+    uint64_t height = 0;
+    blockchain.get_last_height(height);
+
+    bc::blockchain::account_cache::balance cached;
+    if (cache.get_balance(address.encoded(), height, cached)) {
+        addr_balance.confirmed_balance = cached.confirmed;
+        addr_balance.total_received = cached.total_received;
+        addr_balance.unspent_balance = cached.unspent;
+        addr_balance.frozen_balance = cached.frozen;
+        return;
+    }
+
     auto&& rows = blockchain.get_address_history(address, false);
 
     uint64_t total_received = 0;
@@ -1001,8 +1016,6 @@ void sync_fetchbalance(wallet::payment_address& address,
 
     chain::transaction tx_temp;
     uint64_t tx_height;
-    uint64_t height = 0;
-    blockchain.get_last_height(height);
 
     for (auto& row: rows) {
         // spend unconfirmed (or no spend attempted)
@@ -1033,6 +1046,10 @@ void sync_fetchbalance(wallet::payment_address& address,
     addr_balance.total_received = total_received;
     addr_balance.unspent_balance = unspent_balance;
     addr_balance.frozen_balance = frozen_balance;
+
+    cache.store_balance(address.encoded(), { total_received,
+        confirmed_balance, unspent_balance, frozen_balance, height },
+        generation);
 }
 
 void sync_fetchbalance(wallet::payment_address& address,
@@ -1126,6 +1143,41 @@ bool base_transfer_common::get_spendable_output(
     return blockchain_.is_utxo_spendable(tx_temp, row.output.index, row.output_height, height, utxo_min_confirm());
 }
 
+address_asset_record base_transfer_common::add_unspent(
+        const std::string& prikey, const chain::history& row, const chain::output& output,
+        uint64_t asset_amount, uint32_t sequence)
+{
+    address_asset_record record;
+
+    if (!prikey.empty()) { // raw tx has no prikey
+        record.prikey = prikey;
+        record.script = output.script;
+    }
+    else if (include_input_script()) {
+        record.script = output.script;
+    }
+
+    record.addr = output.get_script_address();
+    record.amount = row.value;
+    record.symbol = output.get_asset_symbol();
+    record.asset_amount = asset_amount;
+    record.asset_cert = output.get_asset_cert_type();
+    record.output = row.output;
+    record.type = get_utxo_attach_type(output);
+    record.sequence = sequence;
+
+    from_list_.push_back(record);
+
+    unspent_etp_ += record.amount;
+    unspent_asset_ += record.asset_amount;
+
+    if (record.asset_cert != asset_cert_ns::none) {
+        unspent_asset_cert_.push_back(record.asset_cert);
+    }
+
+    return record;
+}
+
 // only consider etp and asset and cert.
 // specify parameter 'did' to true to only consider did
 void base_transfer_common::sync_fetchutxo(
@@ -1290,33 +1342,7 @@ void base_transfer_common::sync_fetchutxo(
         }
 
         // add to from list
-        address_asset_record record;
-
-        if (!prikey.empty()) { // raw tx has no prikey
-            record.prikey = prikey;
-            record.script = output.script;
-        }
-        else if (include_input_script()) {
-            record.script = output.script;
-        }
-
-        record.addr = output.get_script_address();
-        record.amount = etp_amount;
-        record.symbol = asset_symbol;
-        record.asset_amount = asset_amount;
-        record.asset_cert = cert_type;
-        record.output = row.output;
-        record.type = get_utxo_attach_type(output);
-        record.sequence = lock_sequence;
-
-        from_list_.push_back(record);
-
-        unspent_etp_ += record.amount;
-        unspent_asset_ += record.asset_amount;
-
-        if (record.asset_cert != asset_cert_ns::none) {
-            unspent_asset_cert_.push_back(record.asset_cert);
-        }
+        const auto record = add_unspent(prikey, row, output, asset_amount, lock_sequence);
 
         // asset_locked_transfer as a special change
         if (new_model_param_ptr && (asset_total_amount > record.asset_amount)) {
@@ -1806,6 +1832,108 @@ bool base_transfer_common::filter_out_address(const std::string& address) const
     return blockchain_.is_script_address(address);
 }
 
+// Choose etp inputs across the addresses by amount and height read from the
+// address history, loading only the chosen transactions to confirm them.
+bool base_transfer_helper::select_etp_unspent(const chain::account_address::list& addresses)
+{
+    if (coin_selection_ == coin_selection::history || use_specified_rows_
+        || payment_etp_ == 0 || unspent_etp_ != 0) {
+        return false;
+    }
+
+    uint64_t height = 0;
+    blockchain_.get_last_height(height);
+
+    struct spendable
+    {
+        const chain::account_address* owner;
+        chain::history row;
+    };
+
+    std::vector<spendable> rows;
+    coin_candidate::list candidates;
+
+    for (auto& each : addresses) {
+        const auto& address = each.get_address();
+        if (filter_out_address(address)) {
+            continue;
+        }
+
+        if (!from_.empty() && from_ != address) {
+            continue;
+        }
+
+        for (auto& row : blockchain_.get_address_history(address, true)) {
+            // spent, or carries no etp
+            if (row.spend.hash != null_hash || row.value == 0) {
+                continue;
+            }
+
+            if (exclude_etp_range_.first < exclude_etp_range_.second
+                && row.value >= exclude_etp_range_.first
+                && row.value < exclude_etp_range_.second) {
+                continue;
+            }
+
+            candidates.push_back({row.value, row.output_height, rows.size()});
+            rows.push_back({&each, row});
+        }
+    }
+
+    const coin_selector selector(coin_selection_);
+    std::vector<chain::output> outputs(rows.size());
+
+    // Candidates that fail confirmation are dropped and selection repeats.
+    while (true) {
+        const auto selected = selector.select(candidates, payment_etp_);
+        if (selected.empty()) {
+            return false;
+        }
+
+        std::vector<size_t> rejected;
+        for (const auto index : selected) {
+            const auto& entry = rows[index];
+            auto& output = outputs[index];
+
+            if (!get_spendable_output(output, entry.row, height)
+                || !output.is_etp()
+                || output.get_script_address() != entry.owner->get_address()
+                || (locktime_ > 0 && output.get_lock_sequence(max_input_sequence) != max_input_sequence)) {
+                rejected.push_back(index);
+            }
+        }
+
+        if (!rejected.empty()) {
+            std::sort(rejected.begin(), rejected.end());
+            const auto is_rejected = [&rejected](const coin_candidate& candidate) {
+                return std::binary_search(rejected.begin(), rejected.end(), candidate.index);
+            };
+            candidates.erase(std::remove_if(candidates.begin(), candidates.end(), is_rejected),
+                candidates.end());
+            continue;
+        }
+
+        std::map<const chain::account_address*, std::string> prikeys;
+        for (const auto index : selected) {
+            const auto& entry = rows[index];
+            const auto& output = outputs[index];
+
+            auto prikey = prikeys.find(entry.owner);
+            if (prikey == prikeys.end()) {
+                prikey = prikeys.emplace(entry.owner, entry.owner->get_prv_key(passwd_)).first;
+            }
+
+            const auto sequence = locktime_ > 0
+                ? relative_locktime_disabled
+                : output.get_lock_sequence(max_input_sequence);
+
+            add_unspent(prikey->second, entry.row, output, 0, sequence);
+        }
+
+        return true;
+    }
+}
+
 void base_transfer_helper::populate_unspent_list()
 {
     // get address list
@@ -1814,6 +1942,9 @@ void base_transfer_helper::populate_unspent_list()
         throw address_list_nullptr_exception{"nullptr for address list"};
     }
 
+    // etp inputs chosen here are skipped below, as etp is then satisfied.
+    select_etp_unspent(*pvaddr);
+
     // get from address balances
     for (auto& each : *pvaddr) {
         const auto& address = each.get_address();
@@ -0,0 +1,231 @@
+/**
+ * Copyright (c) 2016-2021 mvs developers
+ *
+ * This file is part of metaverse-explorer.
+ *
+ * metaverse-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <metaverse/explorer/extensions/coin_selection.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <metaverse/explorer/extensions/exception.hpp>
+
+namespace libbitcoin {
+namespace explorer {
+namespace commands {
+
+// Bound on the branches visited before settling for largest first.
+static constexpr size_t branch_and_bound_tries = 100000;
+
+coin_selection to_coin_selection(const std::string& name)
+{
+    if (name == "history")
+        return coin_selection::history;
+    if (name == "largest")
+        return coin_selection::largest_first;
+    if (name == "oldest")
+        return coin_selection::oldest_first;
+    if (name == "bnb")
+        return coin_selection::branch_and_bound;
+
+    throw argument_legality_exception{"unknown utxo selection " + name
+        + ", expected history, largest, oldest or bnb."};
+}
+
+coin_selector::coin_selector(coin_selection strategy, uint64_t change_cost)
+  : strategy_(strategy), change_cost_(change_cost)
+{
+}
+
+coin_selector::indexes coin_selector::select(
+    const coin_candidate::list& candidates, uint64_t target) const
+{
+    std::vector<size_t> order(candidates.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    const auto larger = [&candidates](size_t left, size_t right)
+    {
+        return candidates[left].amount > candidates[right].amount;
+    };
+
+    // Unconfirmed outputs (height zero) sort after every confirmed output.
+    const auto older = [&candidates](size_t left, size_t right)
+    {
+        const auto left_height = candidates[left].height == 0 ?
+            std::numeric_limits<uint64_t>::max() : candidates[left].height;
+        const auto right_height = candidates[right].height == 0 ?
+            std::numeric_limits<uint64_t>::max() : candidates[right].height;
+
+        if (left_height != right_height)
+            return left_height < right_height;
+
+        return candidates[left].amount > candidates[right].amount;
+    };
+
+    switch (strategy_)
+    {
+        case coin_selection::history:
+            break;
+        case coin_selection::oldest_first:
+            std::stable_sort(order.begin(), order.end(), older);
+            break;
+        case coin_selection::branch_and_bound:
+        {
+            auto exact = branch_and_bound(candidates, target);
+            if (!exact.empty())
+                return exact;
+
+            std::stable_sort(order.begin(), order.end(), larger);
+            break;
+        }
+        case coin_selection::largest_first:
+        default:
+            std::stable_sort(order.begin(), order.end(), larger);
+            break;
+    }
+
+    return accumulate(candidates, std::move(order), target);
+}
+
+// private
+coin_selector::indexes coin_selector::accumulate(
+    const coin_candidate::list& candidates, std::vector<size_t>&& order,
+    uint64_t target) const
+{
+    indexes selected;
+    uint64_t total = 0;
+
+    for (const auto position: order)
+    {
+        if (total >= target)
+            break;
+
+        total += candidates[position].amount;
+        selected.push_back(candidates[position].index);
+    }
+
+    if (total < target)
+        selected.clear();
+
+    return selected;
+}
+
+// Depth first search over include/omit decisions in descending amount,
+// pruning branches that cannot reach or that overshoot the target. Among
+// solutions the smallest excess wins, then the fewest inputs.
+coin_selector::indexes coin_selector::branch_and_bound(
+    const coin_candidate::list& candidates, uint64_t target) const
+{
+    std::vector<uint64_t> amounts;
+    std::vector<size_t> origin;
+    amounts.reserve(candidates.size());
+    origin.reserve(candidates.size());
+
+    std::vector<size_t> order(candidates.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [&candidates](size_t left, size_t right)
+        {
+            return candidates[left].amount > candidates[right].amount;
+        });
+
+    uint64_t available = 0;
+    for (const auto position: order)
+    {
+        // Zero amounts never help and only widen the search.
+        if (candidates[position].amount == 0)
+            continue;
+
+        amounts.push_back(candidates[position].amount);
+        origin.push_back(candidates[position].index);
+        available += candidates[position].amount;
+    }
+
+    if (target == 0 || available < target)
+        return {};
+
+    const auto ceiling = target > max_uint64 - change_cost_ ? max_uint64 :
+        target + change_cost_;
+
+    std::vector<size_t> current;
+    std::vector<size_t> best;
+    auto best_excess = max_uint64;
+    uint64_t value = 0;
+    size_t next = 0;
+
+    for (size_t tries = 0; tries < branch_and_bound_tries; ++tries)
+    {
+        auto backtrack = false;
+
+        if (value + available < target || value > ceiling)
+        {
+            backtrack = true;
+        }
+        else if (value >= target)
+        {
+            const auto excess = value - target;
+            if (excess < best_excess ||
+                (excess == best_excess && current.size() < best.size()))
+            {
+                best = current;
+                best_excess = excess;
+            }
+
+            backtrack = true;
+        }
+
+        if (backtrack)
+        {
+            if (current.empty())
+                break;
+
+            // Restore the omitted amounts to the lookahead, then take the
+            // omission branch of the most recently included amount.
+            for (--next; next > current.back(); --next)
+                available += amounts[next];
+
+            value -= amounts[next];
+            current.pop_back();
+        }
+        else
+        {
+            available -= amounts[next];
+
+            // Including an amount equal to one just omitted repeats a branch.
+            const auto duplicate = !current.empty() &&
+                current.back() != next - 1 && amounts[next] == amounts[next - 1];
+
+            if (!duplicate)
+            {
+                current.push_back(next);
+                value += amounts[next];
+            }
+        }
+
+        ++next;
+    }
+
+    indexes selected;
+    for (const auto position: best)
+        selected.push_back(origin[position]);
+
+    return selected;
+}
+
+} // namespace commands
+} // namespace explorer
+} // namespace libbitcoin
@@ -29,11 +29,13 @@
 #include <metaverse/explorer/extensions/command_extension.hpp>
 #include <metaverse/explorer/extensions/command_extension_func.hpp>
 #include <metaverse/explorer/extensions/commands/shutdown.hpp>
+#include <metaverse/explorer/extensions/commands/snapshot.hpp>
 #include <metaverse/explorer/extensions/commands/stopmining.hpp>
 #include <metaverse/explorer/extensions/commands/startmining.hpp>
 #include <metaverse/explorer/extensions/commands/getinfo.hpp>
 #include <metaverse/explorer/extensions/commands/getheight.hpp>
 #include <metaverse/explorer/extensions/commands/getpeerinfo.hpp>
+#include <metaverse/explorer/extensions/commands/getpeerstats.hpp>
 #include <metaverse/explorer/extensions/commands/getrandom.hpp>
 #include <metaverse/explorer/extensions/commands/verifyrandom.hpp>
 #include <metaverse/explorer/extensions/commands/getaddressetp.hpp>
@@ -131,9 +133,11 @@ void broadcast_extension(const function<void(shared_ptr<command>)> func, std::os
     os <<"\r\n";
     // system
     func(make_shared<shutdown>());
+    func(make_shared<snapshot>());
     func(make_shared<getinfo>());
     func(make_shared<addnode>());
     func(make_shared<getpeerinfo>());
+    func(make_shared<getpeerstats>());
     func(make_shared<getrandom>());
     func(make_shared<verifyrandom>());
 
@@ -251,12 +255,16 @@ shared_ptr<command> find_extension(const string& symbol)
     // system
     if (symbol == shutdown::symbol())
         return make_shared<shutdown>();
+    if (symbol == snapshot::symbol())
+        return make_shared<snapshot>();
     if (symbol == getinfo::symbol())
         return make_shared<getinfo>();
     if (symbol == addnode::symbol())
         return make_shared<addnode>();
     if (symbol == getpeerinfo::symbol())
         return make_shared<getpeerinfo>();
+    if (symbol == getpeerstats::symbol())
+        return make_shared<getpeerstats>();
     if (symbol == getrandom::symbol())
         return make_shared<getrandom>();
     if (symbol == verifyrandom::symbol())
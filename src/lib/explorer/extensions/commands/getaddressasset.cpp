@@ -46,8 +46,8 @@ static Json::Value to_json_value(const utxo_balance& balance)
     return json_balance;
 }
 
-console_result getaddressasset::invoke(Json::Value& jv_output,
-    libbitcoin::server::server_node& node)
+void getaddressasset::list(libbitcoin::server::server_node& node,
+    const item_handler& item)
 {
     auto& blockchain = node.chain_impl();
     const auto address = get_address(argument_.address, blockchain);
@@ -58,13 +58,9 @@ console_result getaddressasset::invoke(Json::Value& jv_output,
         check_asset_symbol(option_.symbol);
     }
 
-    std::string json_key;
-    Json::Value json_value;
     auto json_helper = config::json_helper(get_api_version());;
 
     if (option_.is_cert) { // only get asset certs
-        json_key = "assetcerts";
-
         auto sh_vec = std::make_shared<chain::asset_cert::list>();
         sync_fetch_asset_cert_balance(address, "", blockchain, sh_vec);
         std::sort(sh_vec->begin(), sh_vec->end());
@@ -73,12 +69,10 @@ console_result getaddressasset::invoke(Json::Value& jv_output,
                 continue;
 
             Json::Value asset_cert = json_helper.prop_list(elem);
-            json_value.append(asset_cert);
+            item(std::move(asset_cert));
         }
     }
     else if (option_.deposited) {
-        json_key = "assets";
-
         auto sh_vec = std::make_shared<chain::asset_deposited_balance::list>();
         sync_fetch_asset_deposited_balance(address, blockchain, sh_vec);
         std::sort(sh_vec->begin(), sh_vec->end());
@@ -94,12 +88,10 @@ console_result getaddressasset::invoke(Json::Value& jv_output,
 
             Json::Value asset_data = json_helper.prop_list(elem, *issued_asset);
             asset_data["status"] = "unspent";
-            json_value.append(asset_data);
+            item(std::move(asset_data));
         }
     }
     else if (!option_.utxo) {
-        json_key = "assets";
-
         auto sh_vec = std::make_shared<chain::asset_balances::list>();
         sync_fetch_asset_balance(address, true, blockchain, sh_vec);
         std::sort(sh_vec->begin(), sh_vec->end());
@@ -113,12 +105,10 @@ console_result getaddressasset::invoke(Json::Value& jv_output,
             }
             Json::Value asset_data = json_helper.prop_list(elem, *issued_asset);
             asset_data["status"] = "unspent";
-            json_value.append(asset_data);
+            item(std::move(asset_data));
         }
     }
     else {
-        json_key = "assets";
-
         // range check
         if (!option_.range.is_valid()) {
             throw argument_legality_exception("invalid range option! "
@@ -136,10 +126,21 @@ console_result getaddressasset::invoke(Json::Value& jv_output,
                     continue;
                 }
 
-                json_value.append(to_json_value(balance));
+                item(to_json_value(balance));
             }
         }
     }
+}
+
+console_result getaddressasset::invoke(Json::Value& jv_output,
+    libbitcoin::server::server_node& node)
+{
+    const std::string json_key = option_.is_cert ? "assetcerts" : "assets";
+    Json::Value json_value;
+
+    list(node, [&json_value](Json::Value&& asset) {
+        json_value.append(asset);
+    });
 
     if (get_api_version() == 1 && json_value.isNull()) { //compatible for v1
         jv_output[json_key] = "";
@@ -157,6 +158,43 @@ console_result getaddressasset::invoke(Json::Value& jv_output,
     return console_result::okay;
 }
 
+console_result getaddressasset::invoke(config::json_emitter& out,
+    libbitcoin::server::server_node& node)
+{
+    const auto version = get_api_version();
+    auto listed = false;
+
+    if (version <= 2)
+        out.begin_object();
+
+    list(node, [this, &out, &listed, version](Json::Value&& asset) {
+        if (!listed) {
+            if (version <= 2)
+                out.key(option_.is_cert ? "assetcerts" : "assets");
+
+            out.begin_array();
+            listed = true;
+        }
+
+        out.value(asset);
+    });
+
+    if (listed) {
+        out.end_array();
+    }
+    else if (version <= 2) {
+        out.member(option_.is_cert ? "assetcerts" : "assets", Json::nullValue);
+    }
+    else {
+        out.value(Json::arrayValue);
+    }
+
+    if (version <= 2)
+        out.end_object();
+
+    return console_result::okay;
+}
+
 
 } // namespace commands
 } // namespace explorer
@@ -32,68 +32,96 @@ namespace commands {
 
 /************************ getblock *************************/
 
+static chain::block::ptr fetch(const std::string& hash_or_height,
+    libbitcoin::server::server_node& node)
+{
+    std::promise<code> p;
+    chain::block::ptr result;
+    auto& blockchain = node.chain_impl();
+    const auto handler = [&p, &result](const code & ec, chain::block::ptr block) {
+        result = block;
+        p.set_value(ec);
+    };
+
+    // uint64_t max length
+    if (hash_or_height.size() < 18) {
+        // fetch_block via height
+        auto block_height = to_uint64_throw(hash_or_height, "wrong block height!");
+        blockchain.fetch_block(block_height, handler);
+    }
+    else {
+        // fetch_block via hash
+        bc::config::hash256 block_hash(hash_or_height);
+        blockchain.fetch_block(block_hash, handler);
+    }
+
+    auto ec = p.get_future().get();
+    if (ec) {
+        throw block_height_get_exception{ ec.message() };
+    }
+
+    return result;
+}
+
 console_result getblock::invoke(Json::Value& jv_output,
                                 libbitcoin::server::server_node& node)
 {
-    auto json = option_.json;
-    auto tx_json = option_.tx_json;
+    const auto block = fetch(argument_.hash_or_height, node);
+    auto json_helper = config::json_helper(get_api_version());
 
-    // uint64_t max length
-    if (argument_.hash_or_height.size() < 18) {
+    if (option_.json) {
+        jv_output = json_helper.prop_tree(*block, true, option_.tx_json);
+    }
+    else {
+        jv_output = json_helper.prop_tree(*block, false, false);
+    }
 
-        // fetch_block via height
-        auto block_height = to_uint64_throw(argument_.hash_or_height, "wrong block height!");
-
-        std::promise<code> p;
-        auto& blockchain = node.chain_impl();
-        blockchain.fetch_block(block_height, [&p, &jv_output, json, tx_json, this](const code & ec, chain::block::ptr block) {
-            if (ec) {
-                p.set_value(ec);
-                return;
-            }
-
-            if (json) {
-                jv_output =  config::json_helper(get_api_version()).prop_tree(*block, json, tx_json);
-            }
-            else {
-                jv_output =  config::json_helper(get_api_version()).prop_tree(*block, false, false);
-            }
-            p.set_value(error::success);
-        });
-
-        auto result = p.get_future().get();
-        if (result) {
-            throw block_height_get_exception{ result.message() };
-        }
+    return console_result::okay;
+}
+
+// Writes the same document as above without building the transaction list.
+console_result getblock::invoke(config::json_emitter& out,
+                                libbitcoin::server::server_node& node)
+{
+    const auto block = fetch(argument_.hash_or_height, node);
+    auto json_helper = config::json_helper(get_api_version());
+
+    if (!option_.json) {
+        out.value(json_helper.prop_tree(*block, false, false));
+        return console_result::okay;
     }
 
+    out.begin_object();
+
+    if (get_api_version() <= 2) {
+        out.member("header", json_helper.prop_tree(block->header));
+        out.key("txs");
+        out.begin_object();
+    }
     else {
-        // fetch_block via hash
-        bc::config::hash256 block_hash(argument_.hash_or_height);
-
-        std::promise<code> p;
-        auto& blockchain = node.chain_impl();
-        blockchain.fetch_block(block_hash, [&p, &jv_output, json, tx_json, this](const code & ec, chain::block::ptr block) {
-            if (ec) {
-                p.set_value(ec);
-                return;
-            }
-
-            if (json) {
-                jv_output =  config::json_helper(get_api_version()).prop_tree(*block, json, tx_json);
-            }
-            else {
-                jv_output =  config::json_helper(get_api_version()).prop_tree(*block, false, false);
-            }
-            p.set_value(error::success);
-        });
-
-        auto result = p.get_future().get();
-        if (result) {
-            throw block_height_get_exception{ result.message() };
-        }
+        const auto header = json_helper.prop_tree(block->header);
+        for (auto it = header.begin(); it != header.end(); ++it)
+            out.member(it.name(), *it);
+    }
+
+    out.key("transactions");
+    out.begin_array();
+    for (const auto& tx: block->transactions)
+        out.value(json_helper.prop_list(tx, option_.tx_json));
+    out.end_array();
+
+    if (get_api_version() <= 2) {
+        out.end_object();
+    }
+    else if (block->is_proof_of_stake()) {
+        out.member("blocksig", encode_base16(block->blocksig));
+    }
+    else if (block->is_proof_of_dpos()) {
+        out.member("blocksig", encode_base16(block->blocksig));
+        out.member("public_key", encode_base16(block->public_key));
     }
 
+    out.end_object();
     return console_result::okay;
 }
 
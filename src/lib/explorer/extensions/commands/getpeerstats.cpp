@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2016-2021 mvs developers
+ *
+ * This file is part of metaverse-explorer.
+ *
+ * metaverse-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <metaverse/node/p2p_node.hpp>
+#include <metaverse/explorer/dispatch.hpp>
+#include <metaverse/explorer/extensions/commands/getpeerstats.hpp>
+#include <metaverse/explorer/extensions/command_extension_func.hpp>
+#include <metaverse/explorer/extensions/command_assistant.hpp>
+#include <metaverse/explorer/extensions/node_method_wrapper.hpp>
+
+namespace libbitcoin {
+namespace explorer {
+namespace commands {
+using namespace bc::explorer::config;
+
+/************************ getpeerstats *************************/
+
+namespace {
+
+Json::Value to_json(const network::channel_metrics::totals& totals)
+{
+    Json::Value out;
+    out["received_messages"] = Json::UInt64(totals.received_messages);
+    out["received_bytes"] = Json::UInt64(totals.received_bytes);
+    out["sent_messages"] = Json::UInt64(totals.sent_messages);
+    out["sent_bytes"] = Json::UInt64(totals.sent_bytes);
+    out["dispatch_us"] = Json::UInt64(totals.dispatch_microseconds);
+    return out;
+}
+
+} // namespace
+
+console_result getpeerstats::invoke(Json::Value& jv_output,
+                                    libbitcoin::server::server_node& node)
+{
+    administrator_required_checker(node, auth_.name, auth_.auth);
+
+    Json::Value array;
+    for (const auto& peer : node.connections_ptr()->channel_metrics_list()) {
+        const auto& authority = peer.first;
+        const auto& snapshot = peer.second;
+
+        // invalid authority
+        if (authority.to_hostname() == "[::]" && authority.port() == 0)
+            continue;
+
+        Json::Value messages;
+        for (size_t index = 0; index < snapshot.types.size(); ++index) {
+            const auto& totals = snapshot.types[index];
+            if (totals.received_messages == 0 && totals.sent_messages == 0)
+                continue;
+
+            const auto type = static_cast<message::message_type>(index);
+            messages[message::heading::to_command(type)] = to_json(totals);
+        }
+
+        if (messages.isNull())
+            messages = Json::objectValue;
+
+        Json::Value item;
+        item["address"] = authority.to_string();
+        item["uptime"] = Json::UInt64(snapshot.uptime_seconds);
+        item["queue_depth"] = Json::UInt64(snapshot.queue_depth);
+        item["peak_queue_depth"] = Json::UInt64(snapshot.peak_queue_depth);
+        item["total"] = to_json(snapshot.total());
+        item["messages"] = messages;
+        array.append(item);
+    }
+
+    if (array.isNull())
+        array.resize(0);
+
+    jv_output = array;
+
+    return console_result::okay;
+}
+
+} // namespace commands
+} // namespace explorer
+} // namespace libbitcoin
+
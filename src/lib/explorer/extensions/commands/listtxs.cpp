@@ -65,8 +65,8 @@ private:
 
 /************************ listtxs *************************/
 
-console_result listtxs::invoke(Json::Value& jv_output,
-                               libbitcoin::server::server_node& node)
+void listtxs::list(libbitcoin::server::server_node& node,
+    const page_handler& page, const item_handler& item)
 {
     using namespace libbitcoin::config; // for hash256
     auto& blockchain = node.chain_impl();
@@ -100,9 +100,6 @@ console_result listtxs::invoke(Json::Value& jv_output,
             throw asset_symbol_notfound_exception{argument_.symbol + std::string(" not exist!")};
     }
 
-    auto& aroot = jv_output;
-    Json::Value balances;
-
     auto sort_by_height = [](const tx_block_info & lhs, const tx_block_info & rhs)->bool {
         return const_cast<tx_block_info&>(lhs).get_height() > const_cast<tx_block_info&>(rhs).get_height();
     };
@@ -147,6 +144,8 @@ console_result listtxs::invoke(Json::Value& jv_output,
         throw argument_legality_exception{"invalid limit or index parameter"};
     }
 
+    page(total_page, tx_count);
+
     auto json_helper = config::json_helper(get_api_version());
 
     // sort by height
@@ -295,19 +294,32 @@ console_result listtxs::invoke(Json::Value& jv_output,
 
         // 3. all address clear
         vec_ip_addr.clear();
-        balances.append(tx_item);
+        item(std::move(tx_item));
     }
+}
 
-    if (get_api_version() == 1) {
-        aroot["total_page"] += total_page;
-        aroot["current_page"] += argument_.index;
-        aroot["transaction_count"] += tx_count;
-    }
-    else {
-        aroot["total_page"] = total_page;
-        aroot["current_page"] = argument_.index;
-        aroot["transaction_count"] = tx_count;
-    }
+console_result listtxs::invoke(Json::Value& jv_output,
+                               libbitcoin::server::server_node& node)
+{
+    auto& aroot = jv_output;
+    Json::Value balances;
+
+    const auto page = [this, &aroot](uint64_t total_page, uint64_t tx_count) {
+        if (get_api_version() == 1) {
+            aroot["total_page"] += total_page;
+            aroot["current_page"] += argument_.index;
+            aroot["transaction_count"] += tx_count;
+        }
+        else {
+            aroot["total_page"] = total_page;
+            aroot["current_page"] = argument_.index;
+            aroot["transaction_count"] = tx_count;
+        }
+    };
+
+    list(node, page, [&balances](Json::Value&& tx_item) {
+        balances.append(tx_item);
+    });
 
     if (get_api_version() == 1 && balances.isNull()) { // compatible for v1
         aroot["transactions"] = "";
@@ -324,6 +336,44 @@ console_result listtxs::invoke(Json::Value& jv_output,
 
     return console_result::okay;
 }
+
+// The page summary is known before the transactions are fetched, so each
+// transaction is written as soon as it is built.
+console_result listtxs::invoke(config::json_emitter& out,
+                               libbitcoin::server::server_node& node)
+{
+    auto listed = false;
+    out.begin_object();
+
+    const auto page = [this, &out](uint64_t total_page, uint64_t tx_count) {
+        out.member("total_page", total_page);
+        out.member("current_page", argument_.index);
+        out.member("transaction_count", tx_count);
+    };
+
+    list(node, page, [&out, &listed](Json::Value&& tx_item) {
+        if (!listed) {
+            out.key("transactions");
+            out.begin_array();
+            listed = true;
+        }
+
+        out.value(tx_item);
+    });
+
+    if (listed) {
+        out.end_array();
+    }
+    else if (get_api_version() <= 2) {
+        out.member("transactions", Json::nullValue);
+    }
+    else {
+        out.member("transactions", Json::arrayValue);
+    }
+
+    out.end_object();
+    return console_result::okay;
+}
 } // namespace commands
 } // namespace explorer
 } // namespace libbitcoin
@@ -73,6 +73,7 @@ console_result send::invoke(Json::Value& jv_output,
                            option_.fee, option_.locktime,
                            std::make_pair(option_.exclude.first(), option_.exclude.second()));
 
+    send_helper.set_coin_selection(to_coin_selection(option_.selection));
     send_helper.exec();
 
     // json output
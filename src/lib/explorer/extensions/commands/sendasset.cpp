@@ -64,6 +64,7 @@ console_result sendasset::invoke(Json::Value& jv_output,
             std::move(option_.memo),
             std::move(change_address));
 
+    send_helper.set_coin_selection(to_coin_selection(option_.selection));
     send_helper.exec();
 
     // json output
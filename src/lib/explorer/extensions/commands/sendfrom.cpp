@@ -70,6 +70,7 @@ console_result sendfrom::invoke(Json::Value& jv_output,
         option_.locktime,
         std::make_pair(option_.exclude.first(), option_.exclude.second()));
 
+    send_helper.set_coin_selection(to_coin_selection(option_.selection));
     send_helper.exec();
 
     // json output
@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) 2016-2021 mvs developers
+ *
+ * This file is part of metaverse-explorer.
+ *
+ * metaverse-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <boost/filesystem.hpp>
+#include <metaverse/explorer/dispatch.hpp>
+#include <metaverse/explorer/extensions/commands/snapshot.hpp>
+#include <metaverse/explorer/extensions/command_extension_func.hpp>
+#include <metaverse/explorer/extensions/command_assistant.hpp>
+#include <metaverse/explorer/extensions/node_method_wrapper.hpp>
+#include <metaverse/explorer/extensions/exception.hpp>
+
+namespace libbitcoin {
+namespace explorer {
+namespace commands {
+
+
+/************************ snapshot *************************/
+
+console_result snapshot::invoke(Json::Value& jv_output,
+    libbitcoin::server::server_node& node)
+{
+    auto& blockchain = node.chain_impl();
+
+    administrator_required_checker(node, auth_.name, auth_.auth);
+
+    const boost::filesystem::path directory(argument_.directory);
+    if (!directory.is_absolute()) {
+        throw argument_legality_exception{"snapshot directory must be an absolute path."};
+    }
+
+    if (boost::filesystem::exists(directory)) {
+        throw argument_legality_exception{"snapshot directory " + argument_.directory + " already exists."};
+    }
+
+    uint64_t height = 0;
+    if (!blockchain.snapshot(directory, height)) {
+        throw unknown_error_exception{"snapshot to " + argument_.directory + " failed, see log."};
+    }
+
+    jv_output["directory"] = argument_.directory;
+    jv_output["height"] = height;
+
+    return console_result::okay;
+}
+
+
+} // namespace commands
+} // namespace explorer
+} // namespace libbitcoin
+
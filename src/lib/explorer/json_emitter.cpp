@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2016-2021 mvs developers
+ *
+ * This file is part of metaverse-explorer.
+ *
+ * metaverse-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <metaverse/explorer/json_emitter.hpp>
+
+namespace libbitcoin {
+namespace explorer {
+namespace config {
+
+static constexpr size_t indent_width = 3;
+
+json_emitter::json_emitter(std::ostream& stream, bool compact)
+  : stream_(stream), compact_(compact), keyed_(false)
+{
+}
+
+void json_emitter::begin_object()
+{
+    separate();
+    open('{', false);
+}
+
+void json_emitter::end_object()
+{
+    close('}');
+}
+
+void json_emitter::begin_array()
+{
+    separate();
+    open('[', true);
+}
+
+void json_emitter::end_array()
+{
+    close(']');
+}
+
+void json_emitter::key(const std::string& name)
+{
+    BITCOIN_ASSERT(!scopes_.empty() && !scopes_.back().array);
+    separate();
+    stream_ << Json::valueToQuotedString(name.c_str());
+    stream_ << (compact_ ? ":" : " : ");
+    keyed_ = true;
+}
+
+void json_emitter::value(const Json::Value& value)
+{
+    separate();
+    write(value);
+}
+
+void json_emitter::member(const std::string& name, const Json::Value& value)
+{
+    key(name);
+    json_emitter::value(value);
+}
+
+void json_emitter::open(char token, bool array)
+{
+    stream_ << token;
+    scopes_.push_back({ array, true });
+}
+
+void json_emitter::close(char token)
+{
+    BITCOIN_ASSERT(!scopes_.empty() && !keyed_);
+    const auto empty = scopes_.back().empty;
+    scopes_.pop_back();
+
+    // Empty containers close on the same line, as the Json writer does.
+    if (!empty)
+        indent();
+
+    stream_ << token;
+}
+
+// A value follows its key directly, otherwise it begins a new element.
+void json_emitter::separate()
+{
+    if (keyed_)
+    {
+        keyed_ = false;
+        return;
+    }
+
+    if (scopes_.empty())
+        return;
+
+    auto& scope = scopes_.back();
+    if (!scope.empty)
+        stream_ << ',';
+
+    scope.empty = false;
+    indent();
+}
+
+void json_emitter::indent()
+{
+    if (compact_)
+        return;
+
+    stream_ << '\n' << std::string(indent_width * scopes_.size(), ' ');
+}
+
+void json_emitter::write(const Json::Value& value)
+{
+    switch (value.type())
+    {
+        case Json::nullValue:
+            stream_ << "null";
+            break;
+        case Json::intValue:
+            stream_ << Json::valueToString(value.asLargestInt());
+            break;
+        case Json::uintValue:
+            stream_ << Json::valueToString(value.asLargestUInt());
+            break;
+        case Json::realValue:
+            stream_ << Json::valueToString(value.asDouble());
+            break;
+        case Json::stringValue:
+            stream_ << Json::valueToQuotedString(value.asCString());
+            break;
+        case Json::booleanValue:
+            stream_ << Json::valueToString(value.asBool());
+            break;
+        case Json::arrayValue:
+            open('[', true);
+            for (const auto& element: value)
+                json_emitter::value(element);
+            close(']');
+            break;
+        case Json::objectValue:
+            open('{', false);
+            for (auto it = value.begin(); it != value.end(); ++it)
+                member(it.name(), *it);
+            close('}');
+            break;
+    }
+}
+
+} // namespace config
+} // namespace explorer
+} // namespace libbitcoin
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <metaverse/network/buffer_pool.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <metaverse/bitcoin.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+// The smallest slab is 4KiB, the largest covers a maximal payload.
+static constexpr size_t minimum_slab_bits = 12;
+static constexpr size_t maximum_slab_bits = 25;
+
+// Retain up to 64MiB of free slabs across all channels.
+static constexpr size_t default_retained = 64u * 1024u * 1024u;
+
+buffer_pool& buffer_pool::instance()
+{
+    static buffer_pool instance(default_retained);
+    return instance;
+}
+
+buffer_pool::buffer_pool(size_t maximum_retained)
+  : maximum_retained_(maximum_retained),
+    retained_(0),
+    free_(maximum_slab_bits - minimum_slab_bits + 1)
+{
+}
+
+buffer_pool::~buffer_pool()
+{
+    for (auto& slabs: free_)
+        for (const auto slab: slabs)
+            delete slab;
+}
+
+size_t buffer_pool::slab_class(size_t size)
+{
+    size_t bits = minimum_slab_bits;
+    while (bits < maximum_slab_bits && (size_t(1) << bits) < size)
+        ++bits;
+
+    return bits - minimum_slab_bits;
+}
+
+buffer_pool::slab_ptr buffer_pool::acquire(size_t size)
+{
+    const auto index = slab_class(size);
+    const auto slab_size = size_t(1) << (index + minimum_slab_bits);
+    const auto deleter = [this](data_chunk* slab)
+    {
+        release(slab);
+    };
+
+    // Oversized requests are not pooled.
+    if (size > slab_size)
+        return slab_ptr(new data_chunk(size));
+
+    data_chunk* slab = nullptr;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    mutex_.lock();
+
+    auto& slabs = free_[index];
+    if (!slabs.empty())
+    {
+        slab = slabs.back();
+        slabs.pop_back();
+        retained_ -= slab_size;
+    }
+
+    mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    // The slab is sized once so that reuse never fills or reallocates.
+    if (slab == nullptr)
+        slab = new data_chunk(slab_size);
+
+    return slab_ptr(slab, deleter);
+}
+
+void buffer_pool::release(data_chunk* slab)
+{
+    const auto slab_size = slab->size();
+    const auto index = slab_class(slab_size);
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    mutex_.lock();
+
+    if (retained_ + slab_size <= maximum_retained_)
+    {
+        free_[index].push_back(slab);
+        retained_ += slab_size;
+        slab = nullptr;
+    }
+
+    mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    delete slab;
+}
+
+size_t buffer_pool::retained() const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(mutex_);
+
+    return retained_;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+} // namespace network
+} // namespace libbitcoin
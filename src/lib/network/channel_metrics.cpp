@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <metaverse/network/channel_metrics.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <metaverse/bitcoin.hpp>
+
+namespace libbitcoin {
+namespace network {
+
+using namespace message;
+static constexpr auto relaxed = std::memory_order_relaxed;
+
+channel_metrics::channel_metrics()
+  : started_(std::chrono::steady_clock::now()),
+    queue_depth_(0),
+    peak_queue_depth_(0)
+{
+    for (auto& type: types_)
+    {
+        type.received_messages.store(0, relaxed);
+        type.received_bytes.store(0, relaxed);
+        type.sent_messages.store(0, relaxed);
+        type.sent_bytes.store(0, relaxed);
+        type.dispatch_microseconds.store(0, relaxed);
+    }
+}
+
+size_t channel_metrics::to_index(message_type type)
+{
+    const auto index = static_cast<size_t>(type);
+    return index < type_count ? index : static_cast<size_t>(
+        message_type::unknown);
+}
+
+void channel_metrics::received(message_type type, size_t bytes,
+    uint64_t dispatch_microseconds)
+{
+    auto& counters = types_[to_index(type)];
+    counters.received_messages.fetch_add(1, relaxed);
+    counters.received_bytes.fetch_add(bytes, relaxed);
+    counters.dispatch_microseconds.fetch_add(dispatch_microseconds, relaxed);
+}
+
+void channel_metrics::sent(message_type type, size_t bytes)
+{
+    auto& counters = types_[to_index(type)];
+    counters.sent_messages.fetch_add(1, relaxed);
+    counters.sent_bytes.fetch_add(bytes, relaxed);
+}
+
+void channel_metrics::set_queue_depth(size_t depth)
+{
+    queue_depth_.store(depth, relaxed);
+
+    // Raise the peak without a lock, losing a race only to a larger value.
+    auto peak = peak_queue_depth_.load(relaxed);
+    while (depth > peak &&
+        !peak_queue_depth_.compare_exchange_weak(peak, depth, relaxed));
+}
+
+channel_metrics::snapshot channel_metrics::to_snapshot() const
+{
+    snapshot out;
+
+    for (size_t index = 0; index < type_count; ++index)
+    {
+        const auto& counters = types_[index];
+        auto& totals = out.types[index];
+        totals.received_messages = counters.received_messages.load(relaxed);
+        totals.received_bytes = counters.received_bytes.load(relaxed);
+        totals.sent_messages = counters.sent_messages.load(relaxed);
+        totals.sent_bytes = counters.sent_bytes.load(relaxed);
+        totals.dispatch_microseconds =
+            counters.dispatch_microseconds.load(relaxed);
+    }
+
+    out.queue_depth = queue_depth_.load(relaxed);
+    out.peak_queue_depth = peak_queue_depth_.load(relaxed);
+    out.uptime_seconds = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now() - started_).count();
+    return out;
+}
+
+channel_metrics::totals channel_metrics::snapshot::total() const
+{
+    totals sum{ 0, 0, 0, 0, 0 };
+
+    for (const auto& type: types)
+    {
+        sum.received_messages += type.received_messages;
+        sum.received_bytes += type.received_bytes;
+        sum.sent_messages += type.sent_messages;
+        sum.sent_bytes += type.sent_bytes;
+        sum.dispatch_microseconds += type.dispatch_microseconds;
+    }
+
+    return sum;
+}
+
+} // namespace network
+} // namespace libbitcoin
@@ -114,6 +114,18 @@ config::authority::list connections::authority_list()
     return address_list;
 }
 
+connections::metrics_list connections::channel_metrics_list() const
+{
+    metrics_list out;
+
+    // Snapshots are taken outside of the pool lock.
+    for (const auto& channel: safe_copy())
+        out.emplace_back(channel->authority(),
+            channel->metrics().to_snapshot());
+
+    return out;
+}
+
 bool connections::safe_remove(channel::ptr channel)
 {
     // Critical Section
@@ -29,35 +29,46 @@ namespace network {
 
 const_buffer::const_buffer()
   : data_(std::make_shared<data_chunk>()),
-    buffer_(boost::asio::buffer(*data_))
+    buffers_{ boost::asio::buffer(*data_) },
+    count_(1)
 {
 }
 
 const_buffer::const_buffer(data_chunk&& data)
   : data_(std::make_shared<data_chunk>(std::forward<data_chunk>(data))),
-    buffer_(boost::asio::buffer(*data_))
+    buffers_{ boost::asio::buffer(*data_) },
+    count_(1)
 {
 }
 
 const_buffer::const_buffer(const data_chunk& data)
   : data_(std::make_shared<data_chunk>(data)),
-    buffer_(boost::asio::buffer(*data_))
+    buffers_{ boost::asio::buffer(*data_) },
+    count_(1)
+{
+}
+
+const_buffer::const_buffer(data_chunk&& heading, data_chunk&& payload)
+  : data_(std::make_shared<data_chunk>(std::forward<data_chunk>(heading))),
+    payload_(std::make_shared<data_chunk>(std::forward<data_chunk>(payload))),
+    buffers_{ boost::asio::buffer(*data_), boost::asio::buffer(*payload_) },
+    count_(2)
 {
 }
 
 size_t const_buffer::size() const
 {
-    return data_->size();
+    return data_->size() + (payload_ ? payload_->size() : 0);
 }
 
 const_buffer::const_iterator const_buffer::begin() const
 {
-    return &buffer_;
+    return buffers_;
 }
 
 const_buffer::const_iterator const_buffer::end() const
 {
-    return &buffer_ + 1;
+    return buffers_ + count_;
 }
 
 } // namespace network
@@ -22,6 +22,7 @@
 
 #define BOOST_BIND_NO_PLACEHOLDERS
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
@@ -89,7 +90,6 @@ proxy::proxy(threadpool& pool, socket::ptr socket, uint32_t protocol_magic,
     protocol_version_(protocol_version),
     authority_(socket->get_authority()),
     heading_buffer_(heading::maximum_size()),
-    payload_buffer_(heading::maximum_payload_size(protocol_version_)),
     dispatch_{pool, "proxy"},
     socket_(socket),
     stopped_(true),
@@ -127,6 +127,11 @@ void proxy::set_version(message::version::ptr value)
     peer_protocol_version_.store(value->value);
 }
 
+const channel_metrics& proxy::metrics() const
+{
+    return metrics_;
+}
+
 // Start sequence.
 // ----------------------------------------------------------------------------
 
@@ -213,7 +218,7 @@ void proxy::handle_read_heading(const boost_code& ec, size_t)
         return;
     }
 
-    if (head.payload_size > payload_buffer_.capacity())
+    if (head.payload_size > heading::maximum_payload_size(protocol_version_))
     {
         log::warning(LOG_NETWORK)
             << "Oversized payload indicated by " << head.command
@@ -232,8 +237,8 @@ void proxy::read_payload(const heading& head)
     if (stopped())
         return;
 
-    // This does not cause a reallocation.
-    payload_buffer_.resize(head.payload_size);
+    // The slab is pooled, so this does not cause an allocation or a fill.
+    payload_buffer_ = buffer_pool::instance().acquire(head.payload_size);
 
     // The payload buffer is protected by ordering, not the critial section.
 
@@ -241,7 +246,7 @@ void proxy::read_payload(const heading& head)
     ///////////////////////////////////////////////////////////////////////////
     const auto socket = socket_->get_socket();
     using namespace boost::asio;
-    async_read(socket->get(), buffer(payload_buffer_, head.payload_size),
+    async_read(socket->get(), buffer(payload_buffer_->data(), head.payload_size),
         std::bind(&proxy::handle_read_payload,
             shared_from_this(), _1, _2, head));
     ///////////////////////////////////////////////////////////////////////////
@@ -250,6 +255,10 @@ void proxy::read_payload(const heading& head)
 void proxy::handle_read_payload(const boost_code& ec, size_t payload_size,
     const heading& head)
 {
+    // Return the slab to the pool once the payload is parsed.
+    buffer_pool::slab_ptr slab;
+    slab.swap(payload_buffer_);
+
     if (stopped())
         return;
 
@@ -264,10 +273,13 @@ void proxy::handle_read_payload(const boost_code& ec, size_t payload_size,
     }
 
 #ifndef NDEBUG
-    traffic::instance().rx(payload_buffer_.size());
+    traffic::instance().rx(head.payload_size);
 #endif
 
-    auto checksum = bitcoin_checksum(payload_buffer_);
+    // A view of the payload within the slab, deserialized without a copy.
+    const data_slice payload(slab->data(), slab->data() + head.payload_size);
+
+    auto checksum = bitcoin_checksum(payload);
     if (head.checksum != checksum)
     {
         log::trace(LOG_NETWORK)
@@ -277,29 +289,32 @@ void proxy::handle_read_payload(const boost_code& ec, size_t payload_size,
         return;
     }
 
-    ///////////////////////////////////////////////////////////////////////////
-    // TODO: we aren't getting a stream benefit if we read the full payload
-    // before parsing the message. Should just make this a message parse.
-    ///////////////////////////////////////////////////////////////////////////
-
-    handle_request(payload_buffer_, peer_protocol_version_.load(), head, payload_size);
+    handle_request(payload, peer_protocol_version_.load(), head);
+    slab.reset();
 
     handle_activity();
     read_heading();
 }
 
-void proxy::handle_request(data_chunk payload_buffer, uint32_t peer_protocol_version, heading head, size_t payload_size)
+void proxy::handle_request(data_slice payload, uint32_t peer_protocol_version,
+    const heading& head)
 {
-    bool succeed = false;
-
     // Notify subscribers of the new message.
-    payload_source source(payload_buffer);
+    payload_source source(payload);
     payload_stream istream(source);
     const auto version = peer_protocol_version;
+    const auto type = head.type();
+
+    // This times parsing and dispatch, relayed messages are handled later.
+    const auto start = std::chrono::steady_clock::now();
 
-    const auto code = message_subscriber_.load(head.type(), version, istream);
+    const auto code = message_subscriber_.load(type, version, istream);
 
     const auto consumed = istream.peek() == std::istream::traits_type::eof();
+    const auto elapsed = std::chrono::duration_cast<
+        std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    metrics_.received(type, heading::serialized_size() + payload.size(),
+        elapsed.count());
 
     if (code)
     {
@@ -321,8 +336,7 @@ void proxy::handle_request(data_chunk payload_buffer, uint32_t peer_protocol_ver
 
     log::trace(LOG_NETWORK)
         << "Valid " << head.command << " payload from [" << authority()
-        << "] (" << payload_size << " bytes)";
-    succeed = true;
+        << "] (" << payload.size() << " bytes)";
 }
 
 // Message send sequence.
@@ -337,111 +351,120 @@ void proxy::do_send(const std::string& command, const_buffer buffer,
         return;
     }
 
-    if (command == "headers") {
-        log::trace(LOG_NETWORK) << "";
-    }
-
     //thin log network
     log::trace(LOG_NETWORK)
         << "Sending " << command << " to [" << authority() << "] ("
         << buffer.size() << " bytes)";
 
+    outbound_batch batch;
+    size_t outbound_size{0};
+    const auto type = heading::to_type(command);
+
     // Critical Section (protect socket)
     ///////////////////////////////////////////////////////////////////////////
-    // The socket is locked until async_write returns.
-#define QUEUE_REQUEST
-#ifdef QUEUE_REQUEST
-    bool is_ok_to_send{false};
-    uint32_t outbound_size{0};
-    request_callback h{nullptr};
     {
-        auto pThis = shared_from_this();
-        auto f = [this, pThis, buffer, handler](){
-            if (stopped())
-            {
-                handler(error::channel_stopped);
-                return;
-            }
-            const auto socket = socket_->get_socket();
-            auto& native_socket = socket->get();
-            async_write(native_socket, buffer,
-                    std::bind(&proxy::handle_send,
-                            shared_from_this(), _1, buffer, handler));
-        };
         const auto socket = socket_->get_socket();
         outbound_size = outbound_queue_.size();
-        bool is_empty{outbound_queue_.empty()};
-        bool in_sending{!has_sent_.load()};
-        is_ok_to_send = (is_empty && !in_sending);
-        if (is_ok_to_send)
+
+        // Write now if idle, otherwise gather with the next write.
+        if (outbound_queue_.empty() && has_sent_.load())
         {
-            h = std::move(f);
             has_sent_.store(false);
+            batch.push_back({ type, buffer, handler });
         }
-        else{
-            outbound_queue_.push(std::move(f));
+        else
+        {
+            outbound_queue_.push_back({ type, buffer, handler });
         }
+
+        metrics_.set_queue_depth(outbound_queue_.size());
     }
+    ///////////////////////////////////////////////////////////////////////////
 
     if (outbound_size > 500) {
         stop(error::size_limits);
         return;
     }
 
-    if (is_ok_to_send)
+    if (!batch.empty())
+        write(std::move(batch));
+}
+
+// Write all buffers of the batch with a single gather write.
+void proxy::write(outbound_batch&& batch)
+{
+    if (stopped())
     {
-        h();
+        for (const auto& item: batch)
+            item.handler(error::channel_stopped);
+
+        return;
     }
-#else
-    const auto socket = socket_->get_socket();
 
-    // The shared buffer is kept in scope until the handler is invoked.
-    using namespace boost::asio;
-    async_write(socket->get(), buffer,
+    std::vector<asio::const_buffer> buffers;
+    buffers.reserve(2 * batch.size());
+
+    for (const auto& item: batch)
+        buffers.insert(buffers.end(), item.buffer.begin(), item.buffer.end());
+
+    // The shared buffers are kept in scope until the handler is invoked.
+    // Critical Section (protect socket)
+    ///////////////////////////////////////////////////////////////////////////
+    const auto socket = socket_->get_socket();
+    async_write(socket->get(), buffers,
         std::bind(&proxy::handle_send,
-            shared_from_this(), _1, buffer, handler));
-#endif
-    // The shared buffer is kept in scope until the handler is invoked.
+            shared_from_this(), _1, std::move(batch)));
     ///////////////////////////////////////////////////////////////////////////
 }
 
-void proxy::handle_send(const boost_code& ec, const_buffer buffer,
-    result_handler handler)
+void proxy::handle_send(const boost_code& ec, outbound_batch batch)
 {
     const auto error = code(error::boost_to_error_code(ec));
 
-    if (error)
-        log::trace(LOG_NETWORK)
-            << "Failure sending " << buffer.size() << " byte message to ["
-            << authority() << "] " << error.message();
-    else{
+    for (const auto& item: batch)
+    {
+        if (error)
+            log::trace(LOG_NETWORK)
+                << "Failure sending " << item.buffer.size()
+                << " byte message to [" << authority() << "] "
+                << error.message();
+        else{
+            metrics_.sent(item.type, item.buffer.size());
 #ifndef NDEBUG
-        traffic::instance().tx(buffer.size());
+            traffic::instance().tx(item.buffer.size());
 #endif
-    }
+        }
 
-    handler(error);
-#ifdef QUEUE_REQUEST
-    if(error){
-        const auto socket = socket_->get_socket();
-        std::queue<request_callback>{}.swap(outbound_queue_);
-        return;
+        item.handler(error);
     }
 
-    has_sent_.store(true);
+    batch.clear();
 
-    request_callback h{nullptr};
+    // Critical Section (protect socket)
+    ///////////////////////////////////////////////////////////////////////////
     {
         const auto socket = socket_->get_socket();
-        if(outbound_queue_.empty())
+
+        if (error)
+        {
+            outbound_batch{}.swap(outbound_queue_);
+            metrics_.set_queue_depth(0);
             return;
+        }
+
+        has_sent_.store(true);
+        metrics_.set_queue_depth(outbound_queue_.size());
+
+        if (outbound_queue_.empty())
+            return;
+
         log::trace(LOG_NETWORK) << "channel:" << reinterpret_cast<int64_t>(this) << " outbound size," << outbound_queue_.size();
-        h = std::move(outbound_queue_.front());
-        outbound_queue_.pop();
+        batch.swap(outbound_queue_);
         has_sent_.store(false);
     }
-    h();
-#endif
+    ///////////////////////////////////////////////////////////////////////////
+
+    write(std::move(batch));
 }
 
 // Stop sequence.
@@ -469,7 +492,8 @@ void proxy::stop(const code& ec)
     handle_stopping();
     {
         const auto socket = socket_->get_socket();
-        std::queue<request_callback>{}.swap(outbound_queue_);
+        outbound_batch{}.swap(outbound_queue_);
+        metrics_.set_queue_depth(0);
     }
 
     // The socket_ is internally guarded against concurrent use.
@@ -35,6 +35,10 @@ configuration::configuration(bc::settings context)
     daemon{false},
     use_testnet_rules{false},
     upnp_map_port{true},
+    export_start(1),
+    export_stop(max_uint64),
+    import_batch(1000),
+    import_trusted(false),
     node(context),
     chain(context),
     database(context),
@@ -52,6 +56,13 @@ configuration::configuration(const configuration& other)
     use_testnet_rules{other.use_testnet_rules},
     upnp_map_port{other.upnp_map_port},
     file(other.file),
+    replay(other.replay),
+    export_file(other.export_file),
+    import_file(other.import_file),
+    export_start(other.export_start),
+    export_stop(other.export_stop),
+    import_batch(other.import_batch),
+    import_trusted(other.import_trusted),
     node(other.node),
     chain(other.chain),
     database(other.database),
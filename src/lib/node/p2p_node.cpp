@@ -43,8 +43,9 @@ using namespace std::placeholders;
 p2p_node::p2p_node(const configuration& configuration)
   : p2p(configuration.network),
     hashes_(configuration.chain.basic_checkpoints),
-    blockchain_(thread_pool(), configuration.chain, configuration.database),
-    settings_(configuration.node)
+    settings_(configuration.node),
+    blockchain_(p2p_node::block_executor(), p2p_node::transaction_executor(),
+        configuration.chain, configuration.database)
 {
 }
 
@@ -72,11 +73,26 @@ void p2p_node::start(result_handler handler)
         return;
     }
 
+    spawn_executors();
+
     // This is invoked on the same thread.
     // Stopped is true and no network threads until after this call.
     p2p::start(handler);
 }
 
+// Validation is kept below network priority so that validation backlog
+// cannot starve the channels that feed it.
+void p2p_node::spawn_executors()
+{
+    block_pool_.join();
+    block_pool_.spawn(settings_.block_threads, thread_priority::lowest,
+        settings_.block_processors);
+
+    transaction_pool_.join();
+    transaction_pool_.spawn(settings_.transaction_threads,
+        thread_priority::lowest, settings_.transaction_processors);
+}
+
 // Run sequence.
 // ----------------------------------------------------------------------------
 
@@ -190,6 +206,11 @@ bool p2p_node::handle_reorganized(const code& ec, size_t fork_point,
     BITCOIN_ASSERT(max_size_t - fork_point >= incoming.size());
     const auto height = fork_point + incoming.size();
     set_height(height);
+
+    log::debug(LOG_NODE)
+        << "Executor backlog network (" << thread_pool().backlog()
+        << ") block (" << block_executor().backlog()
+        << ") transaction (" << transaction_executor().backlog() << ").";
     return true;
 }
 
@@ -242,7 +263,17 @@ bool p2p_node::close()
         return false;
 
     // Join threads first so that there is no activity on the chain at close.
-    return p2p::close() && blockchain_.stop() && blockchain_.close();
+    const auto closed = p2p::close();
+    close_executors();
+    return closed && blockchain_.stop() && blockchain_.close();
+}
+
+void p2p_node::close_executors()
+{
+    block_pool_.shutdown();
+    transaction_pool_.shutdown();
+    block_pool_.join();
+    transaction_pool_.join();
 }
 
 // Properties.
@@ -268,6 +299,17 @@ transaction_pool& p2p_node::pool()
     return blockchain_.pool();
 }
 
+threadpool& p2p_node::block_executor()
+{
+    return settings_.block_threads == 0 ? thread_pool() : block_pool_;
+}
+
+threadpool& p2p_node::transaction_executor()
+{
+    return settings_.transaction_threads == 0 ? thread_pool() :
+        transaction_pool_;
+}
+
 // Subscriptions.
 // ----------------------------------------------------------------------------
 
@@ -142,7 +142,7 @@ options_metadata parser::load_settings()
     (
         "network.protocol",
         value<uint32_t>(&configured.network.protocol),
-        "The network protocol version, defaults to 70012."
+        "The network protocol version, defaults to 70014."
     )
     (
         "network.identifier",
@@ -318,6 +318,11 @@ options_metadata parser::load_settings()
         value<bool>(&configured.chain.collect_split_stake),
         "Use testnet rules for determination of work required, defaults to false."
     )
+    (
+        "blockchain.scheduler_threads",
+        value<uint32_t>(&configured.chain.scheduler_threads),
+        "The number of threads for fanning out independent validation and notification work, zero uses one per hardware thread, defaults to 0."
+    )
 
     /* [node] */
     (
@@ -334,6 +339,26 @@ options_metadata parser::load_settings()
         "node.transaction_pool_refresh",
         value<bool>(&configured.node.transaction_pool_refresh),
         "Refresh the transaction pool on reorganization and channel start, defaults to true."
+    )
+    (
+        "node.block_threads",
+        value<uint32_t>(&configured.node.block_threads),
+        "The number of threads dedicated to block validation, zero shares the network threads, defaults to 0."
+    )
+    (
+        "node.block_processors",
+        value<std::vector<uint32_t>>(&configured.node.block_processors),
+        "A processor to pin block validation threads to, multiple entries allowed, defaults to none."
+    )
+    (
+        "node.transaction_threads",
+        value<uint32_t>(&configured.node.transaction_threads),
+        "The number of threads dedicated to transaction pool validation, zero shares the network threads, defaults to 0."
+    )
+    (
+        "node.transaction_processors",
+        value<std::vector<uint32_t>>(&configured.node.transaction_processors),
+        "A processor to pin transaction pool threads to, multiple entries allowed, defaults to none."
     );
 
     return description;
@@ -41,16 +41,26 @@ using namespace std::placeholders;
 static constexpr auto perpetual_timer = true;
 static const auto get_blocks_interval = asio::seconds(100);
 
+// The compact block encoding version we request from peers.
+static constexpr uint64_t compact_block_version = 1;
+
 protocol_block_in::protocol_block_in(p2p& network, channel::ptr channel,
-    block_chain& blockchain)
+    block_chain& blockchain, transaction_pool& pool)
   : protocol_timer(network, channel, perpetual_timer, NAME),
     blockchain_(blockchain),
+    pool_(pool),
     last_locator_top_(null_hash),
     current_chain_top_(null_hash),
 
     // TODO: move send_headers to a derived class protocol_block_in_70012.
     headers_from_peer_(peer_version().value >= version::level::bip130),
+
+    // TODO: move compact blocks to a derived class protocol_block_in_70014.
+    compact_from_peer_(peer_version().value >= version::level::bip152 &&
+        network.network_settings().protocol >= version::level::bip152),
     headers_batch_size_{0},
+    locator_requested_(false),
+    continue_sync_(true),
 
     CONSTRUCT_TRACK(protocol_block_in)
 {
@@ -64,6 +74,13 @@ protocol_block_in::ptr protocol_block_in::do_subscribe()
     // TODO: move not_found to a derived class protocol_block_in_70001.
     SUBSCRIBE2(not_found, handle_receive_not_found, _1, _2);
 
+    if (compact_from_peer_)
+    {
+        SUBSCRIBE2(compact_block, handle_receive_compact_block, _1, _2);
+        SUBSCRIBE2(block_transactions, handle_receive_block_transactions,
+            _1, _2);
+    }
+
     SUBSCRIBE2(inventory, handle_receive_inventory, _1, _2);
     SUBSCRIBE2(block_message, handle_receive_block, _1, _2);
     protocol_timer::start(get_blocks_interval, BIND1(get_block_inventory, _1));
@@ -81,7 +98,15 @@ void protocol_block_in::start()
     if (headers_from_peer_)
     {
         // Allow peer to send headers vs. inventory block anncements.
-//        SEND2(send_headers(), handle_send, _1, send_headers::command);
+        SEND2(send_headers(), handle_send, _1, send_headers::command);
+    }
+
+    // TODO: move compact blocks to a derived class protocol_block_in_70014.
+    if (compact_from_peer_)
+    {
+        // Ask peer to push new blocks as compact blocks (high bandwidth).
+        const send_compact_blocks request{ true, compact_block_version };
+        SEND2(request, handle_send, _1, request.command);
     }
 
     // Subscribe to block acceptance notifications (for gap fill redundancy).
@@ -197,6 +222,9 @@ void protocol_block_in::handle_fetch_block_locator(const code& ec,
 
     // Save the locator top to prevent a redundant future request.
     last_locator_top_.store(locator.front());
+
+    // The next headers|inventory message is treated as the response.
+    locator_requested_.store(true);
 }
 
 // Receive headers|inventory sequence.
@@ -219,18 +247,63 @@ bool protocol_block_in::handle_receive_headers(const code& ec,
         return false;
     }
 
-    // There is no benefit to this use of headers, in fact it is suboptimal.
-    // In v3 headers will be used to build block tree before getting blocks.
+    if (!message->is_sequential())
+    {
+        log::debug(LOG_NODE)
+            << "Unlinked headers from [" << authority() << "]";
+        return !misbehaving(20);
+    }
+
+    // Only a locator response is followed by another locator request.
+    const auto response_to_locator = locator_requested_.exchange(false);
+    continue_sync_.store(response_to_locator);
+
     const auto response = std::make_shared<get_data>();
     message->to_inventory(response->inventories, inventory::type_id::block);
     log::trace(LOG_NODE) << "protocol_block_in handle_receive_headers size," << message->elements.size();
 
-    // Remove block hashes found in the orphan pool.
-    blockchain_.filter_orphans(response,
-        BIND2(handle_filter_orphans, _1, response));
+    if (response->inventories.empty())
+        return true;
+
+    if (response_to_locator)
+    {
+        // Remove block hashes found in the orphan pool.
+        blockchain_.filter_orphans(response,
+            BIND2(handle_filter_orphans, _1, response));
+        return true;
+    }
+
+    // An announcement is our heartbeat as much as a block is.
+    reset_timer();
+
+    // Fetch announced blocks directly if they connect to our chain.
+    const auto& parent = message->elements.front().previous_block_hash;
+    blockchain_.fetch_block_height(parent,
+        BIND3(handle_announced_parent, _1, _2, response));
     return true;
 }
 
+void protocol_block_in::handle_announced_parent(const code& ec,
+    uint64_t height, get_data_ptr message)
+{
+    if (stopped(ec))
+        return;
+
+    // The announcement does not connect, locate the gap from our top.
+    if (ec)
+    {
+        log::trace(LOG_NODE)
+            << "Unconnected headers announcement from [" << authority()
+            << "]";
+        send_get_blocks(null_hash);
+        return;
+    }
+
+    // Remove block hashes found in the orphan pool.
+    blockchain_.filter_orphans(message,
+        BIND2(handle_filter_orphans, _1, message));
+}
+
 // This originates from default annoucements and get_blocks requests.
 bool protocol_block_in::handle_receive_inventory(const code& ec,
     inventory_ptr message)
@@ -251,6 +324,9 @@ bool protocol_block_in::handle_receive_inventory(const code& ec,
 
     log::trace(LOG_NODE) << "protocol block in, handle receive inventory,size," << message->inventories.size() ;
 
+    // Only a locator response is followed by another locator request.
+    continue_sync_.store(locator_requested_.exchange(false));
+
     const auto response = std::make_shared<get_data>();
     message->reduce(response->inventories, inventory::type_id::block);
     if(response->inventories.empty())
@@ -358,7 +434,8 @@ bool protocol_block_in::handle_receive_block(const code& ec, block_ptr message)
 
     --headers_batch_size_;
 
-    if(!headers_batch_size_.load())
+    // Announced blocks need no follow up, the peer announces the next one.
+    if(!headers_batch_size_.load() && continue_sync_.load())
     {
         send_get_blocks(null_hash);
     }
@@ -417,6 +494,203 @@ void protocol_block_in::handle_store_block(const code& ec, block_ptr message)
 //    send_get_blocks(message->header.hash());
 }
 
+// Receive compact block sequence.
+//-----------------------------------------------------------------------------
+
+// TODO: move compact blocks to a derived class protocol_block_in_70014.
+bool protocol_block_in::handle_receive_compact_block(const code& ec,
+    compact_block_ptr message)
+{
+    if (stopped(ec))
+        return false;
+
+    if (ec)
+    {
+        log::trace(LOG_NODE)
+            << "Failure getting compact block from [" << authority() << "] "
+            << ec.message();
+        stop(ec);
+        return false;
+    }
+
+    // Reset the timer because we just received a block from this peer.
+    reset_timer();
+
+    const auto builder = std::make_shared<compact_block_builder>(*message);
+    const auto hash = builder->hash();
+
+    log::trace(LOG_NODE)
+        << "Compact block [" << encode_hash(hash) << "] from ["
+        << authority() << "] (" << message->transaction_count() << " txs, "
+        << message->transactions.size() << " prefilled)";
+
+    if (!builder->is_valid())
+    {
+        send_get_block(hash);
+        return true;
+    }
+
+    // Skip reconstruction of blocks we already have as orphans or in chain.
+    const auto request = std::make_shared<get_data>(hash_list{ hash },
+        inventory::type_id::block);
+    blockchain_.filter_orphans(request,
+        BIND3(handle_filter_compact_orphans, _1, request, builder));
+    return true;
+}
+
+void protocol_block_in::handle_filter_compact_orphans(const code& ec,
+    get_data_ptr message, builder_ptr builder)
+{
+    if (stopped(ec) || message->inventories.empty())
+        return;
+
+    if (ec)
+    {
+        log::error(LOG_NODE)
+            << "Internal failure locating compact block orphan for ["
+            << authority() << "] " << ec.message();
+        stop(ec);
+        return;
+    }
+
+    blockchain_.filter_blocks(message,
+        BIND3(handle_filter_compact_blocks, _1, message, builder));
+}
+
+void protocol_block_in::handle_filter_compact_blocks(const code& ec,
+    get_data_ptr message, builder_ptr builder)
+{
+    if (stopped(ec) || message->inventories.empty())
+        return;
+
+    if (ec)
+    {
+        log::error(LOG_NODE)
+            << "Internal failure locating compact block for ["
+            << authority() << "] " << ec.message();
+        stop(ec);
+        return;
+    }
+
+    pool_.fetch(BIND3(handle_fetch_pool, _1, _2, builder));
+}
+
+void protocol_block_in::handle_fetch_pool(const code& ec,
+    const std::vector<transaction_ptr>& transactions, builder_ptr builder)
+{
+    if (stopped(ec))
+        return;
+
+    if (ec)
+    {
+        log::error(LOG_NODE)
+            << "Internal failure fetching pool for compact block from ["
+            << authority() << "] " << ec.message();
+        send_get_block(builder->hash());
+        return;
+    }
+
+    builder->populate(transactions);
+
+    if (builder->is_complete())
+    {
+        store_compact_block(builder);
+        return;
+    }
+
+    const auto missing = builder->missing();
+
+    log::trace(LOG_NODE)
+        << "Compact block [" << encode_hash(builder->hash()) << "] missing "
+        << missing.size() << " txs, asking [" << authority() << "]";
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    pending_mutex_.lock();
+    pending_compact_ = builder;
+    pending_mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    const get_block_transactions request{ builder->hash(), missing };
+    SEND2(request, handle_send, _1, request.command);
+}
+
+// TODO: move compact blocks to a derived class protocol_block_in_70014.
+bool protocol_block_in::handle_receive_block_transactions(const code& ec,
+    block_transactions_ptr message)
+{
+    if (stopped(ec))
+        return false;
+
+    if (ec)
+    {
+        log::trace(LOG_NODE)
+            << "Failure getting block transactions from [" << authority()
+            << "] " << ec.message();
+        stop(ec);
+        return false;
+    }
+
+    builder_ptr builder;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    pending_mutex_.lock();
+
+    if (pending_compact_ && pending_compact_->hash() == message->block_hash)
+        builder.swap(pending_compact_);
+
+    pending_mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    // A response to a superseded request, the block arrives another way.
+    if (!builder)
+        return true;
+
+    if (!builder->populate(*message))
+    {
+        log::debug(LOG_NODE)
+            << "Invalid block transactions for ["
+            << encode_hash(message->block_hash) << "] from ["
+            << authority() << "]";
+        send_get_block(message->block_hash);
+        return true;
+    }
+
+    store_compact_block(builder);
+    return true;
+}
+
+void protocol_block_in::store_compact_block(builder_ptr builder)
+{
+    const auto block = builder->to_block();
+
+    // Fall back to the full block if a short id resolved to the wrong tx.
+    if (!block)
+    {
+        send_get_block(builder->hash());
+        return;
+    }
+
+    // We will pick this up in handle_reorganized.
+    block->set_originator(nonce());
+
+    log::trace(LOG_NODE)
+        << "from " << authority() << ",rebuilt compact block hash,"
+        << encode_hash(block->header.hash()) << ",tx-size,"
+        << block->header.transaction_count << ",number,"
+        << block->header.number;
+
+    blockchain_.store(block, BIND2(handle_store_block, _1, block));
+}
+
+void protocol_block_in::send_get_block(const hash_digest& hash)
+{
+    const auto request = std::make_shared<get_data>(hash_list{ hash },
+        inventory::type_id::block);
+    send_get_data(error::success, request);
+}
+
 // Subscription.
 //-----------------------------------------------------------------------------
 
@@ -52,22 +52,37 @@ protocol_block_out::protocol_block_out(p2p& network, channel::ptr channel,
     blockchain_(blockchain),
 
     // TODO: move send_headers to a derived class protocol_block_out_70012.
-    headers_to_peer_(network.network_settings().protocol >=
+    headers_to_peer_(false),
+    headers_enabled_(network.network_settings().protocol >=
         version::level::bip130),
 
+    // TODO: move compact blocks to a derived class protocol_block_out_70014.
+    compact_to_peer_(false),
+    compact_enabled_(network.network_settings().protocol >=
+        version::level::bip152),
+
     CONSTRUCT_TRACK(protocol_block_out)
 {
 }
 
 protocol_block_out::ptr protocol_block_out::do_subscribe()
 {
-    if (headers_to_peer_)
+    if (headers_enabled_)
     {
-        // Send headers vs. inventory anncements if headers_to_peer_ is set.
+        // Send headers vs. inventory anncements once the peer asks for them.
         log::trace(LOG_NODE) << "protocol block out headers to peer" ;
         SUBSCRIBE2(send_headers, handle_receive_send_headers, _1, _2);
     }
 
+    if (compact_enabled_)
+    {
+        // Send compact blocks vs. announcements if the peer asks for them.
+        SUBSCRIBE2(send_compact_blocks, handle_receive_send_compact_blocks,
+            _1, _2);
+        SUBSCRIBE2(get_block_transactions,
+            handle_receive_get_block_transactions, _1, _2);
+    }
+
     // TODO: move get_headers to a derived class protocol_block_out_31800.
     SUBSCRIBE2(get_headers, handle_receive_get_headers, _1, _2);
     SUBSCRIBE2(get_blocks, handle_receive_get_blocks, _1, _2);
@@ -119,6 +134,105 @@ bool protocol_block_out::handle_receive_send_headers(const code& ec,
     return false;
 }
 
+// Receive send_compact_blocks.
+//-----------------------------------------------------------------------------
+
+// TODO: move compact blocks to a derived class protocol_block_out_70014.
+bool protocol_block_out::handle_receive_send_compact_blocks(const code& ec,
+    send_compact_blocks_ptr message)
+{
+    if (stopped(ec))
+        return false;
+
+    if (ec)
+    {
+        log::trace(LOG_NODE)
+            << "Failure getting " << message->command << " from ["
+            << authority() << "] " << ec.message();
+        stop(ec);
+        return false;
+    }
+
+    // Only the first encoding version is supported, ignore others.
+    if (message->version != 1)
+        return true;
+
+    // Block annoucements will be compact blocks in high bandwidth mode.
+    compact_to_peer_.store(message->high_bandwidth_mode);
+
+    // The peer may toggle the mode at any time.
+    return true;
+}
+
+// Receive get_block_transactions sequence.
+//-----------------------------------------------------------------------------
+
+// TODO: move compact blocks to a derived class protocol_block_out_70014.
+bool protocol_block_out::handle_receive_get_block_transactions(
+    const code& ec, get_block_transactions_ptr message)
+{
+    if (stopped(ec))
+        return false;
+
+    if (ec)
+    {
+        log::trace(LOG_NODE)
+            << "Failure getting get_block_transactions from ["
+            << authority() << "] " << ec.message();
+        stop(ec);
+        return false;
+    }
+
+    blockchain_.fetch_block(message->block_hash,
+        BIND3(send_block_transactions, _1, _2, message));
+    return true;
+}
+
+void protocol_block_out::send_block_transactions(const code& ec,
+    chain::block::ptr block, get_block_transactions_ptr message)
+{
+    if (stopped(ec))
+        return;
+
+    // The block may have been reorganized out, the peer falls back to get_data.
+    if (ec.value() == error::not_found)
+    {
+        log::trace(LOG_NODE)
+            << "Block transactions requested by [" << authority()
+            << "] not found." << encode_hash(message->block_hash);
+        return;
+    }
+
+    if (ec)
+    {
+        log::error(LOG_NODE)
+            << "Internal failure locating block transactions requested by ["
+            << authority() << "] " << ec.message();
+        stop(ec);
+        return;
+    }
+
+    block_transactions response;
+    response.block_hash = message->block_hash;
+    response.transactions.reserve(message->indexes.size());
+
+    for (const auto index: message->indexes)
+    {
+        if (index >= block->transactions.size())
+        {
+            log::debug(LOG_NODE)
+                << "Invalid block transaction index (" << index
+                << ") requested by [" << authority() << "]";
+            stop(error::channel_stopped);
+            return;
+        }
+
+        response.transactions.push_back(block->transactions[index]);
+    }
+
+    SEND2(response, handle_send, _1, response.command);
+}
+
 // Receive get_headers sequence.
 //-----------------------------------------------------------------------------
 
@@ -133,6 +247,17 @@ size_t protocol_block_out::locator_limit() const
     return static_cast<size_t>(std::log2(height) + locator_allowance);
 }
 
+// Announcements are only useful to a peer that is near our top.
+bool protocol_block_out::peer_near_top()
+{
+    auto& blockchain = static_cast<block_chain_impl&>(blockchain_);
+    uint64_t top;
+    auto is_got = blockchain.get_last_height(top);
+    int64_t block_interval = 20000;
+    auto res = std::abs(static_cast<int64_t>(top) - static_cast<int64_t>(peer_start_height()));
+    return is_got && res <= block_interval;
+}
+
 // TODO: move get_headers to a derived class protocol_block_out_31800.
 bool protocol_block_out::handle_receive_get_headers(const code& ec,
     get_headers_ptr message)
@@ -417,28 +542,42 @@ bool protocol_block_out::handle_reorganized(const code& ec, size_t fork_point,
     BITCOIN_ASSERT(max_size_t - fork_point >= incoming.size());
     current_chain_height_.store(fork_point + incoming.size());
 
+    // TODO: move compact blocks to a derived class protocol_block_out_70014.
+    if (compact_to_peer_)
+    {
+        if (!peer_near_top())
+            return true;
+
+        for (const auto& block: incoming)
+        {
+            if (block->originator() == nonce())
+                continue;
+
+            const auto announcement = compact_block::factory_from_block(
+                *block, pseudo_random());
+            SEND2(announcement, handle_send, _1, announcement.command);
+        }
+
+        return true;
+    }
+
     // TODO: move announce headers to a derived class protocol_block_in_70012.
     if (headers_to_peer_)
     {
         headers announcement;
 
-        for (const auto& block: incoming)
-            if (block->originator() != nonce())
-                announcement.elements.push_back(block->header);
-
-        if (!announcement.elements.empty())
+        // Keep the announcement linked, the peer rejects gaps in headers.
+        const auto is_new = [this](const block_ptr& block)
         {
-            auto& blockchain = static_cast<block_chain_impl&>(blockchain_);
-            uint64_t top;
-            auto is_got = blockchain.get_last_height(top);
-            int64_t block_interval = 20000;
-            auto res = std::abs(static_cast<int64_t>(top) - static_cast<int64_t>(peer_start_height()));
-            if (!is_got || res > block_interval)
-            {
-                return true;
-            }
+            return block->originator() != nonce();
+        };
+
+        for (auto it = std::find_if(incoming.begin(), incoming.end(), is_new);
+            it != incoming.end(); ++it)
+            announcement.elements.push_back((*it)->header);
+
+        if (!announcement.elements.empty() && peer_near_top())
             SEND2(announcement, handle_send, _1, announcement.command);
-        }
         return true;
     }
 
@@ -449,19 +588,8 @@ bool protocol_block_out::handle_reorganized(const code& ec, size_t fork_point,
         if (block->originator() != nonce())
             announcement.inventories.push_back( { id, block->header.hash() });
 
-    if (!announcement.inventories.empty())
-    {
-        auto& blockchain = static_cast<block_chain_impl&>(blockchain_);
-        uint64_t top;
-        auto is_got = blockchain.get_last_height(top);
-        int64_t block_interval = 20000;
-        auto res = std::abs(static_cast<int64_t>(top) - static_cast<int64_t>(peer_start_height()));
-        if (!is_got || res > block_interval)
-        {
-            return true;
-        }
+    if (!announcement.inventories.empty() && peer_near_top())
         SEND2(announcement, handle_send, _1, announcement.command);
-    }
     return true;
 }
 
@@ -127,18 +127,10 @@ bool protocol_block_sync::handle_receive(const code& ec, block_ptr message,
         return false;
     }
 
-    // Add the block to the blockchain store.
+    // Queue the block for the blockchain store.
     reservation_->import(message);
 
-    if (reservation_->toggle_partitioned())
-    {
-        log::trace(LOG_NODE)
-            << "Restarting partitioned slot (" << reservation_->slot() << ").";
-        complete(error::channel_stopped);
-        return false;
-    }
-
-    // Request more blocks if our reservation has been expanded.
+    // Slide the window, or request blocks if our reservation was expanded.
     send_get_blocks(complete, false);
     return true;
 }
@@ -167,6 +159,9 @@ void protocol_block_sync::handle_event(const code& ec, event_handler complete)
         return;
     }
 
+    // Duplicated stragglers may have been received from another channel.
+    reservation_->populate();
+
     // This results from other channels taking this channel's hashes in
     // combination with this channel's peer not responding to the last request.
     // Causing a successful stop here prevents channel startup just to stop.
@@ -185,7 +180,9 @@ void protocol_block_sync::handle_event(const code& ec, event_handler complete)
         complete(error::channel_timeout);
         return;
     }
-    complete(ec);
+
+    // Refill the window if it was held back by the import queue.
+    send_get_blocks(complete, false);
 }
 
 void protocol_block_sync::blocks_complete(const code& ec,
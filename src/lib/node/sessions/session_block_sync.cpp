@@ -51,7 +51,7 @@ session_block_sync::session_block_sync(p2p& network, header_queue& hashes,
     blockchain_(chain),
     reservations_count_{0},
     settings_(settings),
-    reservations_(hashes, chain, settings),
+    reservations_(pool_, hashes, chain, settings),
     CONSTRUCT_TRACK(session_block_sync)
 {
 }
@@ -88,7 +88,8 @@ void session_block_sync::handle_started(const code& ec, result_handler handler)
         << "Getting blocks.";
     const auto connector = create_connector();
     reservations_count_ = table.size();
-    const auto complete = synchronize(handler, table.size(), NAME);
+    const auto complete = synchronize(BIND2(handle_synchronized, _1, handler),
+        table.size(), NAME);
     std::function<void(const code&)> func = complete;
     // This is the end of the start sequence.
     for (const auto& row: table)
@@ -102,6 +103,20 @@ void session_block_sync::handle_started(const code& ec, result_handler handler)
     ////reset_timer(connector);
 }
 
+// Imports are queued behind the channels, so completion waits on the queue.
+// This holds on failure too, the queue references blocks owned by this session.
+void session_block_sync::handle_synchronized(const code& ec,
+    result_handler handler)
+{
+    log::info(LOG_NODE)
+        << "Writing queued blocks.";
+
+    reservations_.drain([handler, ec]()
+    {
+        handler(ec);
+    });
+}
+
 // Block sync sequence.
 // ----------------------------------------------------------------------------
 
@@ -27,7 +27,9 @@ namespace node {
 settings::settings()
   : block_timeout_seconds(5),
     download_connections(8),
-    transaction_pool_refresh(true)
+    transaction_pool_refresh(true),
+    block_threads(0),
+    transaction_threads(0)
 {
 }
 
@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <metaverse/node/utility/compact_block_builder.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <metaverse/blockchain.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace bc::chain;
+using namespace bc::message;
+
+// A serialized transaction cannot be smaller than this, bounds allocation.
+static constexpr size_t minimum_transaction_size = 60;
+
+static uint64_t to_number(const compact_block::short_id& id)
+{
+    uint64_t value = 0;
+    for (size_t byte = 0; byte < id.size(); ++byte)
+        value |= static_cast<uint64_t>(id[byte]) << (8 * byte);
+
+    return value;
+}
+
+compact_block_builder::compact_block_builder(const compact_block& block)
+  : valid_(true),
+    header_(block.header),
+    blocksig_(block.blocksig),
+    public_key_(block.public_key),
+    short_ids_(block.short_ids),
+    key_(block.short_id_key())
+{
+    const auto count = block.transaction_count();
+
+    if (count == 0 ||
+        count > blockchain::max_block_size / minimum_transaction_size)
+    {
+        valid_ = false;
+        return;
+    }
+
+    transactions_.resize(count);
+    populated_.assign(count, false);
+
+    for (const auto& prefilled: block.transactions)
+    {
+        if (prefilled.index >= count || populated_[prefilled.index])
+        {
+            valid_ = false;
+            return;
+        }
+
+        transactions_[prefilled.index] = prefilled.transaction;
+        populated_[prefilled.index] = true;
+    }
+
+    // Short ids fill the remaining slots in block order.
+    short_id_slots_.reserve(short_ids_.size());
+    for (size_t slot = 0; slot < count; ++slot)
+        if (!populated_[slot])
+            short_id_slots_.push_back(slot);
+
+    BITCOIN_ASSERT(short_id_slots_.size() == short_ids_.size());
+
+    // Duplicate short ids cannot be resolved, the full block is required.
+    std::vector<uint64_t> sorted;
+    sorted.reserve(short_ids_.size());
+    for (const auto& id: short_ids_)
+        sorted.push_back(to_number(id));
+
+    std::sort(sorted.begin(), sorted.end());
+    valid_ = std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end();
+}
+
+bool compact_block_builder::is_valid() const
+{
+    return valid_;
+}
+
+bool compact_block_builder::is_complete() const
+{
+    return valid_ &&
+        std::find(populated_.begin(), populated_.end(), false) ==
+            populated_.end();
+}
+
+hash_digest compact_block_builder::hash() const
+{
+    return header_.hash();
+}
+
+void compact_block_builder::populate(const transaction_ptr_list& pool)
+{
+    if (!valid_)
+        return;
+
+    std::unordered_map<uint64_t, size_t> positions;
+    positions.reserve(short_ids_.size());
+    for (size_t position = 0; position < short_ids_.size(); ++position)
+        if (!populated_[short_id_slots_[position]])
+            positions.emplace(to_number(short_ids_[position]), position);
+
+    // Count matches so that pool collisions are left for the peer to fill.
+    std::vector<size_t> matches(short_ids_.size(), 0);
+
+    for (const auto& tx: pool)
+    {
+        const auto id = compact_block::to_short_id(key_, tx->hash());
+        const auto it = positions.find(to_number(id));
+
+        if (it == positions.end())
+            continue;
+
+        const auto slot = short_id_slots_[it->second];
+        if (++matches[it->second] == 1)
+            transactions_[slot] = *tx;
+    }
+
+    for (size_t position = 0; position < matches.size(); ++position)
+        if (matches[position] == 1)
+            populated_[short_id_slots_[position]] = true;
+}
+
+bool compact_block_builder::populate(const block_transactions& response)
+{
+    const auto slots = missing();
+
+    if (!valid_ || response.block_hash != hash() ||
+        response.transactions.size() != slots.size())
+        return false;
+
+    for (size_t index = 0; index < slots.size(); ++index)
+    {
+        transactions_[slots[index]] = response.transactions[index];
+        populated_[slots[index]] = true;
+    }
+
+    return true;
+}
+
+std::vector<uint64_t> compact_block_builder::missing() const
+{
+    std::vector<uint64_t> indexes;
+    for (size_t slot = 0; slot < populated_.size(); ++slot)
+        if (!populated_[slot])
+            indexes.push_back(slot);
+
+    return indexes;
+}
+
+block_message::ptr compact_block_builder::to_block() const
+{
+    if (!is_complete())
+        return nullptr;
+
+    // A short id collision with an unrelated transaction shows up here.
+    if (block::generate_merkle_root(transactions_) != header_.merkle)
+        return nullptr;
+
+    const auto block = std::make_shared<block_message>(header_,
+        transactions_);
+    block->header.transaction_count = transactions_.size();
+    block->blocksig = blocksig_;
+    block->public_key = public_key_;
+    return block;
+}
+
+} // namespace node
+} // namespace libbitcoin
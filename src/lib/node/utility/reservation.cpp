@@ -19,10 +19,12 @@
  */
 #include <metaverse/node/utility/reservation.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <string>
 #include <utility>
 #include <boost/format.hpp>
 #include <metaverse/bitcoin.hpp>
@@ -35,29 +37,35 @@ namespace node {
 using namespace std::chrono;
 using namespace bc::chain;
 
-// The allowed number of standard deviations below the norm.
-// With 1 channel this multiple is irrelevant, no channels are dropped.
-// With 2 channels a < 1.0 multiple will drop a channel on every test.
-// With 2 channels a 1.0 multiple will fluctuate based on rounding deviations.
-// With 2 channels a > 1.0 multiple will prevent all channel drops.
-// With 3+ channels the multiple determines allowed deviation from the norm.
-static constexpr float multiple = 1.01f;
+// A channel is dropped if its rate is below this fraction of the mean rate.
+// Moderately slow channels are not dropped, their unrequested hashes are
+// taken by faster channels as those run out of work.
+static constexpr double slow_fraction = 0.25;
 
 // The minimum amount of block history to move the state from idle.
 static constexpr size_t minimum_history = 3;
 
+// The bounds of the in-flight window, and its size before a rate is known.
+static constexpr size_t minimum_window = 16;
+static constexpr size_t initial_window = 64;
+static constexpr size_t maximum_window = 1024;
+
+// The window covers this multiple of the bandwidth-delay product.
+static constexpr size_t window_multiple = 2;
+
 // Simple conversion factor, since we trace in micro and report in seconds.
 static constexpr size_t micro_per_second = 1000 * 1000;
 
 reservation::reservation(reservations& reservations, size_t slot,
     uint32_t block_timeout_seconds)
-  : rate_({ true, 0, 0, 0 }),
+  : reservations_(reservations),
+    rate_({ true, 0, 0, 0 }),
+    latency_(microseconds::max()),
     stopped_(false),
     pending_(true),
-    partitioned_(false),
-    reservations_(reservations),
     slot_(slot),
-    rate_window_(minimum_history * block_timeout_seconds * micro_per_second)
+    rate_window_(minimum_history * block_timeout_seconds * micro_per_second),
+    stall_timeout_(block_timeout_seconds * micro_per_second)
 {
 }
 
@@ -95,11 +103,18 @@ high_resolution_clock::time_point reservation::now() const
 // Rate methods.
 //-----------------------------------------------------------------------------
 
-// Clears rate/history but leaves hashes unchanged.
+// Clears rate/history/latency but leaves hashes unchanged.
 void reservation::reset()
 {
     set_rate({ true, 0, 0, 0 });
     clear_history();
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(rate_mutex_);
+
+    latency_ = microseconds::max();
+    ///////////////////////////////////////////////////////////////////////////
 }
 
 // Shortcut for rate().idle call.
@@ -133,31 +148,76 @@ performance reservation::rate() const
     ///////////////////////////////////////////////////////////////////////////
 }
 
+// The minimum response time, an estimate of latency free of peer queueing.
+void reservation::update_latency(const microseconds& latency)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(rate_mutex_);
+
+    latency_ = std::min(latency_, latency);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// Size the window to the bandwidth-delay product of the peer.
+size_t reservation::window() const
+{
+    performance record;
+    microseconds latency;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    rate_mutex_.lock_shared();
+    record = rate_;
+    latency = latency_;
+    rate_mutex_.unlock_shared();
+    ///////////////////////////////////////////////////////////////////////////
+
+    if (record.idle || latency == microseconds::max())
+        return initial_window;
+
+    // Blocks per microsecond times microseconds of latency.
+    const auto product = record.normal() * latency.count();
+    const auto window = static_cast<size_t>(std::ceil(product)) *
+        window_multiple;
+
+    return std::max(minimum_window, std::min(maximum_window, window));
+}
+
 // Ignore idleness here, called only from an active channel, avoiding a race.
 bool reservation::expired() const
 {
-    const auto record = rate();
-    const auto normal_rate = record.normal();
+    const auto oldest = now() - stall_timeout_;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    hash_mutex_.lock_shared();
+
+    const auto stalled = std::any_of(requested_.begin(), requested_.end(),
+        [oldest](const request_times::value_type& request)
+        {
+            return request.second < oldest;
+        });
+
+    hash_mutex_.unlock_shared();
+    ///////////////////////////////////////////////////////////////////////////
+
+    if (stalled)
+    {
+        log::debug(LOG_NODE)
+            << "Stalled slot (" << slot() << ") with " << in_flight()
+            << " blocks in flight.";
+        return true;
+    }
+
+    // A single channel is never slow relative to the others.
     const auto statistics = reservations_.rates();
-    const auto deviation = normal_rate - statistics.arithmentic_mean;
-    const auto absolute_deviation = std::fabs(deviation);
-    const auto allowed_deviation = multiple * statistics.standard_deviation;
-    const auto outlier = absolute_deviation > allowed_deviation;
-    const auto below_average = deviation < 0;
-    const auto expired = below_average && outlier;
+    if (statistics.active_count < 2)
+        return false;
 
-    ////log::debug(LOG_NODE)
-    ////    << "Statistics for slot (" << slot() << ")"
-    ////    << " adj:" << (normal_rate * micro_per_second)
-    ////    << " avg:" << (statistics.arithmentic_mean * micro_per_second)
-    ////    << " dev:" << (deviation * micro_per_second)
-    ////    << " sdv:" << (statistics.standard_deviation * micro_per_second)
-    ////    << " cnt:" << (statistics.active_count)
-    ////    << " neg:" << (below_average ? "T" : "F")
-    ////    << " out:" << (outlier ? "T" : "F")
-    ////    << " exp:" << (expired ? "T" : "F");
-
-    return expired;
+    const auto record = rate();
+    const auto threshold = slow_fraction * statistics.arithmentic_mean;
+    return !record.idle && record.normal() < threshold;
 }
 
 void reservation::clear_history()
@@ -251,6 +311,26 @@ size_t reservation::size() const
     ///////////////////////////////////////////////////////////////////////////
 }
 
+size_t reservation::unrequested() const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(hash_mutex_);
+
+    return heights_.size() - requested_.size();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+size_t reservation::in_flight() const
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    shared_lock lock(hash_mutex_);
+
+    return requested_.size();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
 bool reservation::stopped() const
 {
     // Critical Section (stop)
@@ -261,7 +341,8 @@ bool reservation::stopped() const
     ///////////////////////////////////////////////////////////////////////////
 }
 
-// Obtain and clear the outstanding blocks request.
+// Obtain the lowest unrequested hashes that fit in the in-flight window.
+// The window is refilled in batches of half its size unless hashes are new.
 message::get_data reservation::request(bool new_channel)
 {
     message::get_data packet;
@@ -270,28 +351,46 @@ message::get_data reservation::request(bool new_channel)
     if (new_channel)
         reset();
 
+    // Leave blocks with the peer while the import queue drains.
+    else if (reservations_.saturated())
+        return packet;
+
+    const auto limit = window();
+    const auto time = now();
+
     // Critical Section
     ///////////////////////////////////////////////////////////////////////////
     hash_mutex_.lock_upgrade();
 
-    if (!new_channel && !pending_)
+    // Anything in flight on a prior channel will not arrive, request again.
+    const auto flight = new_channel ? 0 : requested_.size();
+    const auto capacity = flight < limit ? limit - flight : 0;
+
+    if (capacity == 0 || (!new_channel && !pending_ && capacity < limit / 2))
     {
         hash_mutex_.unlock_upgrade();
         //---------------------------------------------------------------------
         return packet;
     }
 
-    // Build get_blocks request message.
-    for (auto height = heights_.right.begin(); height != heights_.right.end();
-        ++height)
+    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+    hash_mutex_.unlock_upgrade_and_lock();
+
+    if (new_channel)
+        requested_.clear();
+
+    // Build get_blocks request message in height order.
+    for (auto height = heights_.right.begin(); height != heights_.right.end()
+        && packet.inventories.size() < capacity; ++height)
     {
+        if (!requested_.emplace(height->second, time).second)
+            continue;
+
         static const auto id = message::inventory::type_id::block;
         const message::inventory_vector inventory{ id, height->second };
         packet.inventories.emplace_back(inventory);
     }
 
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-    hash_mutex_.unlock_upgrade_and_lock();
     pending_ = false;
     hash_mutex_.unlock();
     ///////////////////////////////////////////////////////////////////////////
@@ -318,13 +417,26 @@ void reservation::insert(const hash_digest& hash, size_t height)
     ///////////////////////////////////////////////////////////////////////////
 }
 
+void reservation::erase(const hash_digest& hash)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    unique_lock lock(hash_mutex_);
+
+    heights_.left.erase(hash);
+    requested_.erase(hash);
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// The rate measures receipt from the peer, the import is queued.
 void reservation::import(block::ptr block)
 {
     uint32_t height;
+    microseconds latency;
     const auto hash = block->header.hash();
     const auto encoded = encode_hash(hash);
 
-    if (!find_height_and_erase(hash, height))
+    if (!find_height_and_erase(hash, height, latency))
     {
         log::debug(LOG_NODE)
             << "Ignoring unsolicited block (" << slot() << ") ["
@@ -332,35 +444,42 @@ void reservation::import(block::ptr block)
         return;
     }
 
-    bool success;
-    const auto importer = [this, &block, &height, &success]()
-    {
-        success = reservations_.import(block, height);
-    };
-
-    // Do the block import with timer.
-    const auto cost = timer<microseconds>::duration(importer);
+    static const auto unit_size = 1u;
+    update_rate(unit_size, microseconds(0));
+    update_latency(latency);
 
-    if (success)
+    // A straggler requested from more than one peer is imported once.
+    if (reservations_.claim(hash, shared_from_this()))
     {
-        static const auto unit_size = 1u;
-        update_rate(unit_size, cost);
-        const auto record = rate();
-        static const auto formatter =
-            "Imported block #%06i (%02i) [%s] %06.2f %05.2f%%";
-
-        log::info(LOG_NODE)
-            << boost::format(formatter) % height % slot() % encoded %
-            (record.total() * micro_per_second) % (record.ratio() * 100);
+        const auto self = shared_from_this();
+        reservations_.import(block, height,
+            [self, height, encoded](bool success, const microseconds& cost)
+            {
+                self->handle_import(success, cost, height, encoded);
+            });
     }
-    else
+
+    populate();
+}
+
+void reservation::handle_import(bool success, const microseconds& cost,
+    size_t height, const std::string& encoded)
+{
+    if (!success)
     {
         log::debug(LOG_NODE)
             << "Stopped before importing block (" << slot() << ") ["
             << encoded << "]";
+        return;
     }
 
-    populate();
+    const auto record = rate();
+    static const auto formatter =
+        "Imported block #%06i (%02i) [%s] %06.2f %06.2fms";
+
+    log::info(LOG_NODE)
+        << boost::format(formatter) % height % slot() % encoded %
+        (record.normal() * micro_per_second) % (cost.count() / 1000.0);
 }
 
 void reservation::populate()
@@ -383,84 +502,114 @@ void reservation::populate()
     ///////////////////////////////////////////////////////////////////////////
 }
 
-bool reservation::toggle_partitioned()
-{
-    // Critical Section
-    ///////////////////////////////////////////////////////////////////////////
-    hash_mutex_.lock_upgrade();
-
-    if (partitioned_)
-    {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock();
-        partitioned_ = false;
-        pending_ = true;
-        hash_mutex_.unlock();
-        //---------------------------------------------------------------------
-        return true;
-    }
-
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return false;
-}
-
-// Give the minimal row ~ half of our hashes, return false if minimal is empty.
+// Give the minimal row a rate-weighted share of our unrequested hashes,
+// taken from the top so our in-flight requests are undisturbed. Return false
+// if minimal is empty.
 bool reservation::partition(reservation::ptr minimal)
 {
     // This assumes that partition has been called under a table mutex.
     if (!minimal->empty())
         return true;
 
+    // Split in proportion to rates, or evenly if either rate is unknown.
+    const auto own_rate = rate();
+    const auto other_rate = minimal->rate();
+    const auto known = !own_rate.idle && !other_rate.idle &&
+        own_rate.normal() > 0 && other_rate.normal() > 0;
+    const auto share = known ? other_rate.normal() /
+        (own_rate.normal() + other_rate.normal()) : 0.5;
+
+    entries moved;
+
     // Critical Section (hash)
     ///////////////////////////////////////////////////////////////////////////
     hash_mutex_.lock_upgrade();
 
-    // Take half of the maximal reservation, rounding up to get last entry.
-    const auto own_size = heights_.size();
-    BITCOIN_ASSERT(own_size < max_size_t && (own_size + 1) / 2 <= max_uint32);
-    const auto offset = static_cast<uint32_t>(own_size + 1) / 2;
-    auto it = heights_.right.begin();
-
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-    hash_mutex_.unlock_upgrade_and_lock();
+    // Round up to get the last unrequested entry.
+    const auto movable = heights_.size() - requested_.size();
+    const auto offset = std::min(movable, static_cast<size_t>(
+        std::ceil(share * movable)));
 
-    // TODO: move the range in a single command.
-    for (size_t index = 0; index < offset; ++index)
+    if (offset == 0)
     {
-        minimal->heights_.right.insert(std::move(*it));
-        it = heights_.right.erase(it);
+        hash_mutex_.unlock_upgrade();
+        //---------------------------------------------------------------------
+        return false;
     }
 
-    partitioned_ = !heights_.empty();
-    const auto populated = !minimal->empty();
-    minimal->pending_ = populated;
+    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+    hash_mutex_.unlock_upgrade_and_lock();
 
-    if (!partitioned_)
+    moved.reserve(offset);
+    auto it = heights_.right.end();
+
+    while (moved.size() < offset && it != heights_.right.begin())
     {
-        // Critical Section (stop)
-        ///////////////////////////////////////////////////////////////////////
-        unique_lock lock(stop_mutex_);
+        --it;
+
+        if (requested_.find(it->second) != requested_.end())
+            continue;
 
-        // If the channel has been emptied it will not repopulate.
-        stopped_ = true;
-        ///////////////////////////////////////////////////////////////////////
+        moved.emplace_back(it->second, it->first);
+        it = heights_.right.erase(it);
     }
 
     hash_mutex_.unlock();
     ///////////////////////////////////////////////////////////////////////////
 
+    for (const auto& entry: moved)
+        minimal->insert(entry.first, entry.second);
+
+    const auto populated = !minimal->empty();
+
     if (populated)
         log::debug(LOG_NODE)
-            << "Moved [" << minimal->size() << "] blocks from slot (" << slot()
+            << "Moved [" << moved.size() << "] blocks from slot (" << slot()
             << ") to (" << minimal->slot() << ") leaving [" << size() << "].";
 
     return populated;
 }
 
+reservation::entries reservation::stragglers(size_t limit) const
+{
+    entries out;
+    std::vector<std::pair<time_point, entry>> aged;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    hash_mutex_.lock_shared();
+
+    aged.reserve(requested_.size());
+
+    for (const auto& request: requested_)
+    {
+        const auto it = heights_.left.find(request.first);
+
+        if (it != heights_.left.end())
+            aged.push_back({ request.second, { it->first, it->second } });
+    }
+
+    hash_mutex_.unlock_shared();
+    ///////////////////////////////////////////////////////////////////////////
+
+    const auto older = [](const std::pair<time_point, entry>& left,
+        const std::pair<time_point, entry>& right)
+    {
+        return left.first < right.first;
+    };
+
+    const auto count = std::min(limit, aged.size());
+    std::partial_sort(aged.begin(), aged.begin() + count, aged.end(), older);
+    out.reserve(count);
+
+    for (size_t index = 0; index < count; ++index)
+        out.push_back(aged[index].second);
+
+    return out;
+}
+
 bool reservation::find_height_and_erase(const hash_digest& hash,
-    uint32_t& out_height)
+    uint32_t& out_height, microseconds& out_latency)
 {
     // Critical Section
     ///////////////////////////////////////////////////////////////////////////
@@ -476,10 +625,18 @@ bool reservation::find_height_and_erase(const hash_digest& hash,
     }
 
     out_height = it->second;
+    const auto request = requested_.find(hash);
+    const auto requested = request != requested_.end();
+    out_latency = requested ? duration_cast<microseconds>(now() -
+        request->second) : microseconds::max();
 
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
     hash_mutex_.unlock_upgrade_and_lock();
     heights_.left.erase(it);
+
+    if (requested)
+        requested_.erase(request);
+
     hash_mutex_.unlock();
     ///////////////////////////////////////////////////////////////////////////
 
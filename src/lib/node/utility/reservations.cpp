@@ -20,8 +20,10 @@
 #include <metaverse/node/utility/reservations.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <utility>
@@ -34,26 +36,102 @@
 namespace libbitcoin {
 namespace node {
 
+using namespace std::chrono;
 using namespace bc::blockchain;
 using namespace bc::chain;
 
+#define NAME "reservations"
+
 // The protocol maximum size of get data block requests.
 static constexpr size_t max_block_request = 50000;
 
-reservations::reservations(header_queue& hashes, simple_chain& chain,
-    const settings& settings)
+// The number of received blocks queued for import before requests pause.
+static constexpr size_t maximum_backlog = 2000;
+
+reservations::reservations(threadpool& pool, header_queue& hashes,
+    simple_chain& chain, const settings& settings)
   : hashes_(hashes),
     blockchain_(chain),
-    max_request_(max_block_request),
-    timeout_(settings.block_timeout_seconds)
+    endgame_(false),
+    dispatch_(pool, NAME),
+    timeout_(settings.block_timeout_seconds),
+    max_request_(max_block_request)
 {
     initialize(settings.download_connections);
 }
 
-bool reservations::import(block::ptr block, size_t height)
+// Import methods.
+//-----------------------------------------------------------------------------
+
+// The job does not reference this object, which may not outlive the queue.
+void reservations::import(block::ptr block, size_t height,
+    import_handler handler)
+{
+    auto& chain = blockchain_;
+    const auto importer = [&chain, block, height, handler]()
+    {
+        bool success;
+        const auto cost = timer<microseconds>::duration([&]()
+        {
+            // Thread safe.
+            success = chain.import(block, height);
+        });
+
+        handler(success, cost);
+    };
+
+    dispatch_.ordered(importer);
+}
+
+bool reservations::saturated()
+{
+    return dispatch_.ordered_backlog() >= maximum_backlog;
+}
+
+// The job follows every queued import on the strand, so it runs last.
+void reservations::drain(drain_handler handler)
+{
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    claim_mutex_.lock();
+    duplicates_.clear();
+    endgame_ = false;
+    claim_mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    dispatch_.ordered(handler);
+}
+
+bool reservations::claim(const hash_digest& hash, reservation::ptr owner)
 {
-    // Thread safe.
-    return blockchain_.import(block, height);
+    if (!endgame_)
+        return true;
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    claim_mutex_.lock_upgrade();
+
+    const auto it = duplicates_.find(hash);
+
+    if (it == duplicates_.end() || it->second)
+    {
+        claim_mutex_.unlock_upgrade();
+        //---------------------------------------------------------------------
+        return it == duplicates_.end();
+    }
+
+    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+    claim_mutex_.unlock_upgrade_and_lock();
+    it->second = true;
+    claim_mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    // The other holders no longer need the block.
+    for (const auto& row: table())
+        if (row != owner)
+            row->erase(hash);
+
+    return true;
 }
 
 // Rate methods.
@@ -215,8 +293,10 @@ bool reservations::populate(reservation::ptr minimal)
     ///////////////////////////////////////////////////////////////////////////
     mutex_.lock();
 
-    // Take from unallocated or allocated hashes, true if minimal not empty.
-    const auto populated = reserve(minimal) || partition(minimal);
+    // Take from unallocated, unrequested or in-flight hashes in that order,
+    // true if minimal not empty.
+    const auto populated = reserve(minimal) || partition(minimal) ||
+        duplicate(minimal);
 
     mutex_.unlock();
     ///////////////////////////////////////////////////////////////////////////
@@ -232,22 +312,89 @@ bool reservations::populate(reservation::ptr minimal)
 // This can cause reduction of an active reservation.
 bool reservations::partition(reservation::ptr minimal)
 {
-    const auto maximal = find_maximal();
-    return maximal && maximal != minimal && maximal->partition(minimal);
+    const auto slowest = find_slowest(minimal);
+    return slowest && slowest->partition(minimal);
 }
 
-reservation::ptr reservations::find_maximal()
+// Near the tip there is nothing left to move, so the blocks that are holding
+// up completion are requested again from the minimal row's peer.
+bool reservations::duplicate(reservation::ptr minimal)
 {
-    if (table_.empty())
-        return nullptr;
+    if (!minimal->empty())
+        return true;
+
+    reservation::ptr delayed;
+    size_t most = 0;
 
-    // The maximal row is that with the most block hashes reserved.
-    const auto comparer = [](reservation::ptr left, reservation::ptr right)
+    // The delayed row is that with the most blocks in flight.
+    for (const auto& row: table_)
     {
-        return left->size() < right->size();
-    };
+        const auto flight = row->in_flight();
+
+        if (row != minimal && flight > most)
+        {
+            most = flight;
+            delayed = row;
+        }
+    }
+
+    if (!delayed)
+        return false;
+
+    const auto entries = delayed->stragglers(minimal->window());
+
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    claim_mutex_.lock();
+
+    for (const auto& entry: entries)
+    {
+        // Each straggler is duplicated once, to a single other peer.
+        if (duplicates_.emplace(entry.first, false).second)
+            minimal->insert(entry.first, entry.second);
+    }
+
+    endgame_ = true;
+    claim_mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    const auto populated = !minimal->empty();
+
+    if (populated)
+        log::debug(LOG_NODE)
+            << "Duplicated [" << minimal->size() << "] blocks from slot ("
+            << delayed->slot() << ") to (" << minimal->slot() << ").";
+
+    return populated;
+}
+
+reservation::ptr reservations::find_slowest(reservation::ptr minimal)
+{
+    reservation::ptr slowest;
+    auto longest = 0.0;
+
+    // The slowest row is that expected to take longest to receive its
+    // unrequested hashes at its current rate, an idle row never finishes.
+    for (const auto& row: table_)
+    {
+        const auto remaining = row->unrequested();
+
+        if (row == minimal || remaining == 0)
+            continue;
+
+        const auto record = row->rate();
+        const auto rate = record.idle ? 0.0 : record.normal();
+        const auto duration = rate > 0 ? remaining / rate :
+            std::numeric_limits<double>::max();
+
+        if (!slowest || duration > longest)
+        {
+            longest = duration;
+            slowest = row;
+        }
+    }
 
-    return *std::max_element(table_.begin(), table_.end(), comparer);
+    return slowest;
 }
 
 // Return false if minimal is empty.
@@ -167,6 +167,162 @@ bool executor::do_initchain()
     return false;
 }
 
+// Emit to the log.
+bool executor::do_replay()
+{
+    const auto& config = metadata_.configured;
+
+    if (boost::filesystem::equivalent(config.replay, config.database.directory))
+    {
+        log::error(LOG_SERVER) << format(BS_REPLAY_SAME_DIRECTORY) % config.replay;
+        return false;
+    }
+
+    // A directory is replayed from its database, anything else is taken to
+    // be a block export.
+    const auto make_source = [&config](uint64_t start_height)
+        -> bc::blockchain::block_source::ptr
+    {
+        if (!boost::filesystem::is_directory(config.replay))
+            return std::make_shared<bc::blockchain::file_block_source>(
+                config.replay, start_height);
+
+        auto source_settings = config.database;
+        source_settings.directory = config.replay;
+        return std::make_shared<bc::blockchain::database_block_source>(
+            source_settings, start_height);
+    };
+
+    return replay(make_source, 1, false);
+}
+
+// Emit to the log.
+bool executor::do_import()
+{
+    const auto& config = metadata_.configured;
+    const auto make_source = [&config](uint64_t start_height)
+        -> bc::blockchain::block_source::ptr
+    {
+        return std::make_shared<bc::blockchain::file_block_source>(
+            config.import_file, start_height);
+    };
+
+    return replay(make_source, config.import_batch, config.import_trusted);
+}
+
+// Emit to the log.
+bool executor::do_export()
+{
+    const auto& config = metadata_.configured;
+    const auto& directory = config.database.directory;
+
+    bc::blockchain::database_block_source source(config.database,
+        config.export_start, config.export_stop);
+    bc::blockchain::block_file_writer writer(config.export_file);
+
+    if (!source.open())
+    {
+        log::error(LOG_SERVER) << format(BS_REPLAY_START_FAIL) % directory;
+        return false;
+    }
+
+    if (!writer.open())
+    {
+        log::error(LOG_SERVER) << format(BS_EXPORT_FAILED) % config.export_file;
+        source.close();
+        return false;
+    }
+
+    log::info(LOG_SERVER) << format(BS_EXPORT_STARTING) % directory %
+        config.export_file;
+
+    data_chunk block;
+    uint64_t height;
+    uint64_t count = 0;
+    auto success = true;
+
+    while (success)
+    {
+        const auto read = source.next(block, height);
+        if (read.value() == bc::error::not_found)
+            break;
+
+        success = !read && writer.write(block, height);
+        if (success)
+            ++count;
+    }
+
+    source.close();
+    success = writer.close() && success;
+
+    if (!success)
+    {
+        log::error(LOG_SERVER) << format(BS_EXPORT_FAILED) % config.export_file;
+        return false;
+    }
+
+    log::info(LOG_SERVER) << format(BS_EXPORT_COMPLETE) % count;
+    return true;
+}
+
+bool executor::replay(source_factory make_source, size_t sync_interval,
+    bool trust_checkpoints)
+{
+    const auto& config = metadata_.configured;
+    const auto& directory = config.database.directory;
+
+    // The chain is only written by the replay, so no network threads.
+    threadpool pool(1);
+    bc::blockchain::block_chain_impl chain(pool, config.chain, config.database);
+
+    uint64_t top;
+    if (!chain.start() || !chain.get_last_height(top))
+    {
+        log::error(LOG_SERVER) << format(BS_REPLAY_START_FAIL) % directory;
+        return false;
+    }
+
+    // Resume above the destination top, which is genesis when fresh.
+    const auto source = make_source(top + 1);
+    bc::blockchain::block_replayer replayer(chain, sync_interval,
+        trust_checkpoints);
+
+    log::info(LOG_SERVER) << format(BS_REPLAY_STARTING) % directory % (top + 1);
+    const auto ec = replayer.replay(*source);
+
+    const auto& totals = replayer.totals();
+    const auto blocks = std::max(totals.blocks, uint64_t(1));
+    const auto report = [blocks](const char* stage,
+        const bc::blockchain::block_replayer::duration& elapsed)
+    {
+        const auto ms = elapsed.count() / 1000.0;
+        log::info(LOG_SERVER) << format(BS_REPLAY_STAGE) % stage % ms %
+            (ms / blocks);
+    };
+
+    log::info(LOG_SERVER) << format(BS_REPLAY_COMPLETE) % totals.blocks %
+        totals.transactions % totals.inputs % totals.trusted;
+    report("deserialize", totals.deserialize);
+    report("check", totals.check);
+    report("accept", totals.accept);
+    report("connect", totals.connect);
+    report("store", totals.store);
+    report("sync", totals.sync);
+
+    chain.stop();
+    pool.shutdown();
+    pool.join();
+    chain.close();
+
+    if (ec)
+    {
+        log::error(LOG_SERVER) << format(BS_REPLAY_FAILED) % ec.message();
+        return false;
+    }
+
+    return true;
+}
+
 // Menu selection.
 // ----------------------------------------------------------------------------
 
@@ -216,6 +372,21 @@ bool executor::menu()
         {
             return result;
         }
+
+        if (!config.replay.empty())
+        {
+            return do_replay();
+        }
+
+        if (!config.import_file.empty())
+        {
+            return do_import();
+        }
+
+        if (!config.export_file.empty())
+        {
+            return do_export();
+        }
     }
     catch(const std::exception& e){ // initialize failed
         //log::error(LOG_SERVER) << format(BS_INITCHAIN_EXISTS) % data_path;
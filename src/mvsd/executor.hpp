@@ -53,6 +53,9 @@ private:
     void do_settings();
     void do_version();
     bool do_initchain();
+    bool do_replay();
+    bool do_import();
+    bool do_export();
     void set_admin();
     void set_blackhole_did();
 
@@ -61,6 +64,11 @@ private:
     void set_minimum_threadpool_size();
     bool run();
 
+    typedef std::function<bc::blockchain::block_source::ptr(uint64_t)>
+        source_factory;
+    bool replay(source_factory make_source, size_t sync_interval,
+        bool trust_checkpoints);
+
     // Termination state.
     static std::promise<code> stopping_;
 
@@ -92,6 +100,25 @@ private:
 #define BS_INITCHAIN_COMPLETE \
     "Completed initialization."
 
+#define BS_REPLAY_SAME_DIRECTORY \
+    "Replay source %1% must differ from the configured directory."
+#define BS_REPLAY_START_FAIL \
+    "Failed to start the blockchain in %1%."
+#define BS_REPLAY_STARTING \
+    "Replaying blocks into %1% from height %2%..."
+#define BS_REPLAY_FAILED \
+    "Replay stopped with error, %1%."
+#define BS_REPLAY_COMPLETE \
+    "Replayed (%1%) blocks, (%2%) txs and (%3%) inputs, (%4%) blocks trusted."
+#define BS_EXPORT_STARTING \
+    "Exporting blocks of %1% to %2%..."
+#define BS_EXPORT_FAILED \
+    "Failed to write block export %1%."
+#define BS_EXPORT_COMPLETE \
+    "Exported (%1%) blocks."
+#define BS_REPLAY_STAGE \
+    "  %-11s %10.1f ms (%.3f ms/block)"
+
 #define BS_NODE_INTERRUPT \
     "Press CTRL-C to stop the server."
 #define BS_NODE_STARTING \
@@ -16,11 +16,15 @@
  */
 #include <exception>
 #include <functional> //hash
+#include <memory>
+#include <sstream>
 
 #include <metaverse/mgbubble/HttpServ.hpp>
 #include <metaverse/mgbubble/exception/Instances.hpp>
 #include <metaverse/mgbubble/utility/Stream_buf.hpp>
 
+#include <metaverse/explorer/dispatch.hpp>
+#include <metaverse/explorer/json_emitter.hpp>
 #include <metaverse/explorer/extensions/command_extension_func.hpp>
 #include <metaverse/explorer/extensions/exception.hpp>
 #include <metaverse/server/server_node.hpp>
@@ -40,6 +44,41 @@ std::string get_remote_address_from_nc(mg_connection& nc)
     return dst;
 }
 
+// Writers are stateless between calls, so each thread builds one per style.
+Json::StreamWriter& get_json_writer(bool compact)
+{
+    static thread_local std::unique_ptr<Json::StreamWriter> styled;
+    static thread_local std::unique_ptr<Json::StreamWriter> compacted;
+
+    auto& writer = compact ? compacted : styled;
+    if (!writer) {
+        Json::StreamWriterBuilder builder;
+        builder["commentStyle"] = "None";
+        builder["indentation"] = compact ? "" : "   ";
+        writer.reset(builder.newStreamWriter());
+    }
+
+    return *writer;
+}
+
+void HttpServ::write_json(const Json::Value& value)
+{
+    const auto compact = node_.server_settings().rpc_compact_json;
+    get_json_writer(compact).write(value, &out_);
+    if (!compact)
+        out_ << '\n';
+}
+
+std::string HttpServ::to_json_string(const Json::Value& value)
+{
+    const auto compact = node_.server_settings().rpc_compact_json;
+    std::ostringstream stream;
+    get_json_writer(compact).write(value, &stream);
+    if (!compact)
+        stream << '\n';
+    return stream.str();
+}
+
 void HttpServ::reset(HttpMessage& data) noexcept
 {
     state_ = 0;
@@ -70,6 +109,9 @@ void HttpServ::rpc_request(mg_connection& nc, HttpMessage data, uint8_t rpc_vers
     out_.rdbuf(&buf);
     out_.reset(200, "OK");
 
+    const auto compact = node_.server_settings().rpc_compact_json;
+    std::unique_ptr<explorer::config::json_emitter> emitter;
+
     try {
         check_rpc_client_addresses(nc);
 
@@ -77,8 +119,21 @@ void HttpServ::rpc_request(mg_connection& nc, HttpMessage data, uint8_t rpc_vers
 
         Json::Value jv_output;
 
+        // Large v2 results are written into the envelope as they are produced.
+        explorer::emitter_source begin_stream;
+        if (rpc_version != 1) {
+            begin_stream = [&]() -> explorer::config::json_emitter& {
+                emitter.reset(new explorer::config::json_emitter(out_, compact));
+                emitter->begin_object();
+                emitter->member("id", data.jsonrpc_id());
+                emitter->member("jsonrpc", "2.0");
+                emitter->key("result");
+                return *emitter;
+            };
+        }
+
         auto retcode = explorer::dispatch_command(data.argc(), const_cast<const char**>(data.argv()),
-                       jv_output, node_, rpc_version);
+                       jv_output, begin_stream, node_, rpc_version);
 
         if (retcode == console_result::failure) { // only orignal command
             if (rpc_version == 1 && !jv_output.isObject() && !jv_output.isArray()) {
@@ -88,9 +143,14 @@ void HttpServ::rpc_request(mg_connection& nc, HttpMessage data, uint8_t rpc_vers
         }
 
         if (retcode == console_result::okay) {
-            if (rpc_version == 1) {
+            if (emitter) {
+                emitter->end_object();
+                if (!compact)
+                    out_ << '\n';
+            }
+            else if (rpc_version == 1) {
                 if (jv_output.isObject() || jv_output.isArray())
-                    out_ << jv_output.toStyledString();
+                    write_json(jv_output);
                 else
                     out_ << jv_output.asString();
             }
@@ -98,13 +158,18 @@ void HttpServ::rpc_request(mg_connection& nc, HttpMessage data, uint8_t rpc_vers
                 Json::Value jv_root;
                 jv_root["jsonrpc"] = "2.0";
                 jv_root["id"] = data.jsonrpc_id();
-                jv_root["result"] = jv_output;
+                // Move the result into the envelope rather than copying it.
+                jv_root["result"].swap(jv_output);
 
-                out_ << jv_root.toStyledString();
+                write_json(jv_root);
             }
         }
     }
     catch (const libbitcoin::explorer::explorer_exception& e) {
+        // Discard any partially streamed result.
+        if (emitter)
+            out_.reset(200, "OK");
+
         if (rpc_version == 1) {
             out_ << e;
         }
@@ -115,10 +180,14 @@ void HttpServ::rpc_request(mg_connection& nc, HttpMessage data, uint8_t rpc_vers
             root["error"]["code"] = (int32_t)e.code();
             root["error"]["message"] = e.what();
 
-            out_ << root.toStyledString();
+            write_json(root);
         }
     }
     catch (const std::exception& e) {
+        // Discard any partially streamed result.
+        if (emitter)
+            out_.reset(200, "OK");
+
         if (rpc_version == 1) {
             libbitcoin::explorer::explorer_exception ex(1000, e.what());
             out_ << ex;
@@ -130,7 +199,7 @@ void HttpServ::rpc_request(mg_connection& nc, HttpMessage data, uint8_t rpc_vers
             root["error"]["code"] = 1000;
             root["error"]["message"] = e.what();
 
-            out_ << root.toStyledString();
+            write_json(root);
         }
     }
     out_.setContentLength();
@@ -157,7 +226,7 @@ void HttpServ::ws_request(mg_connection& nc, WebsocketMessage ws)
     }
 
     if (jv_output.isObject() || jv_output.isArray())
-        send_frame(nc, jv_output.toStyledString());
+        send_frame(nc, to_json_string(jv_output));
     else
         send_frame(nc, jv_output.asString());
 }
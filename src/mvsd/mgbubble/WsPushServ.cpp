@@ -15,6 +15,7 @@
 * 02110-1301, USA.
 */
 
+#include <algorithm>
 #include <thread>
 #include <sstream>
 #include <metaverse/explorer/json_helper.hpp>
@@ -51,6 +52,36 @@ explorer::config::json_helper get_json_helper()
     return explorer::config::json_helper(JSON_FORMAT_VERSION);
 }
 
+std::string to_compact_string(const Json::Value& value)
+{
+    Json::StreamWriterBuilder builder;
+    builder["commentStyle"] = "None";
+    builder["indentation"] = "";
+    return Json::writeString(builder, value);
+}
+
+// Compose a publish frame around an already serialized result.
+std::string to_publish_frame(const std::string& channel,
+    const std::string& topic, const std::string& result)
+{
+    std::string frame;
+    frame.reserve(result.size() + topic.size() + 64);
+    frame += "{\"event\":\"";
+    frame += EV_PUBLISH;
+    frame += "\",\"channel\":\"";
+    frame += channel;
+    frame += "\",";
+    if (!topic.empty()) {
+        frame += "\"topic\":";
+        frame += topic;
+        frame += ",";
+    }
+    frame += "\"result\":";
+    frame += result;
+    frame += "}";
+    return frame;
+}
+
 void WsPushServ::run() {
     using namespace std::placeholders;
     log::info(NAME) << "Websocket Service listen on " << node_.server_settings().websocket_listen;
@@ -149,122 +180,96 @@ void WsPushServ::notify_block(uint32_t height, const block::ptr block)
 
 void WsPushServ::notify_block_impl(uint32_t height, const bc::chain::block::ptr block)
 {
-    connection_string_map subscribers;
+    std::vector<std::shared_ptr<mg_connection>> block_cons;
+    std::vector<std::shared_ptr<mg_connection>> height_cons;
     {
         std::lock_guard<std::mutex> guard(block_subscribers_lock_);
-        if (block_subscribers_.size() == 0) {
+        if (block_subscribers_.empty()) {
             return;
         }
 
-        for (auto& con : block_subscribers_) {
-            if (!con.first.expired()) {
-                subscribers.insert(con);
-            }
-        }
+        std::vector<connection_ptr> stale;
+        const auto collect = [this, &stale](const std::string& channel,
+            std::vector<std::shared_ptr<mg_connection>>& out)
+        {
+            const auto it = channel_index_.find(channel);
+            if (it == channel_index_.end())
+                return;
 
-        if (subscribers.size() != block_subscribers_.size()) {
-            block_subscribers_ = subscribers;
-        }
-    }
+            for (const auto& con : it->second) {
+                auto shared_con = con.lock();
+                if (shared_con)
+                    out.push_back(shared_con);
+                else
+                    stale.push_back(con);
+            }
+        };
 
-    std::vector<std::weak_ptr<mg_connection>> notify_block_cons;
-    std::vector<std::weak_ptr<mg_connection>> notify_height_cons;
-    for (auto& sub : subscribers) {
-        auto& params = sub.second;
-        if (params.end() != std::find(params.begin(), params.end(), CH_HEIGHT)) {
-            notify_height_cons.push_back(sub.first);
-        }
+        collect(CH_BLOCK, block_cons);
+        collect(CH_HEIGHT, height_cons);
 
-        if (params.end() != std::find(params.begin(), params.end(), CH_BLOCK)) {
-            notify_block_cons.push_back(sub.first);
+        for (const auto& con : stale) {
+            remove_channel_subscriber(con);
         }
     }
 
-    if (notify_block_cons.size() > 0) {
-        Json::Value root;
-        root["event"] = EV_PUBLISH;
-        root["channel"] = CH_BLOCK;
-        root["result"] = get_json_helper().prop_tree(*block, true, true);
+    notification_list notifications;
 
-        // log::info(NAME) << " ******** notify_block: height [" << height << "]  ******** ";
+    if (!block_cons.empty()) {
+        const auto block_json = get_json_helper().prop_tree(*block, true, true);
+        const auto payload = std::make_shared<const std::string>(
+            to_publish_frame(CH_BLOCK, "", to_compact_string(block_json)));
 
-        do_notify(notify_block_cons, root);
+        for (const auto& con : block_cons) {
+            notifications.emplace_back(con, payload);
+        }
     }
 
-    if (notify_height_cons.size() > 0) {
-        Json::Value root;
-        root["event"] = EV_PUBLISH;
-        root["channel"] = CH_HEIGHT;
-        root["result"] = height;
-
-        // log::info(NAME) << " ******** notify_height: height [" << height << "]  ******** ";
+    if (!height_cons.empty()) {
+        const auto payload = std::make_shared<const std::string>(
+            to_publish_frame(CH_HEIGHT, "", std::to_string(height)));
 
-        do_notify(notify_height_cons, root);
+        for (const auto& con : height_cons) {
+            notifications.emplace_back(con, payload);
+        }
     }
+
+    do_notify(notifications);
 }
 
-void WsPushServ::do_notify(
-    const std::vector<std::weak_ptr<mg_connection>>& notify_cons,
-    Json::Value& root,
-    std::shared_ptr<connection_string_map> topic_map)
+void WsPushServ::do_notify(const notification_list& notifications)
 {
-    auto orignal_rep = root.toStyledString();
+    if (notifications.empty()) {
+        return;
+    }
 
-    for (auto& con : notify_cons)
-    {
-        auto shared_con = con.lock();
-        if (!shared_con) {
-            continue;
+    // A single pass over the mongoose connections delivers every frame.
+    spawn_to_mongoose([this, notifications](uint64_t id) {
+        // A connection may be due several frames, e.g. both block and height.
+        std::unordered_map<mg_connection*, std::vector<const std::string*>> targets;
+        for (const auto& notification : notifications) {
+            targets[notification.first.get()].push_back(notification.second.get());
         }
 
-        std::string rep;
-        if (topic_map != nullptr) {
-            auto iter = topic_map->find(con);
-            if (iter != topic_map->end()) {
-                auto& topics = iter->second;
-                if (topics.end() != std::find(topics.begin(), topics.end(), CH_ALL)) {
-                    root["topic"] = CH_ALL;
-                }
-                else if (topics.size() == 1) {
-                    root["topic"] = topics[0];
-                }
-                else {
-                    Json::Value value;
-                    for (auto& topic : topics) {
-                        value.append(topic);
-                    }
-                    if (value.isNull())
-                        value.resize(0);
-
-                    root["topic"] = value;
+        size_t active_connections = 0;
+        auto* mgr = &this->mg_mgr();
+        for (auto* nc = mg_next(mgr, NULL); nc != NULL; nc = mg_next(mgr, nc)) {
+            if (!is_websocket(*nc) || is_listen_socket(*nc) || is_notify_socket(*nc))
+                continue;
+            ++active_connections;
+
+            const auto it = targets.find(nc);
+            if (it != targets.end()) {
+                for (const auto* payload : it->second) {
+                    send_frame(*nc, *payload);
                 }
-
-                rep = root.toStyledString();
             }
         }
 
-        if (rep.empty()) {
-            rep = orignal_rep;
+        if (active_connections != map_connections_.size()) {
+            refresh_connections();
         }
-
-        spawn_to_mongoose([this, shared_con, rep](uint64_t id) {
-            size_t active_connections = 0;
-            auto* mgr = &this->mg_mgr();
-            auto* notify_nc = shared_con.get();
-            for (auto* nc = mg_next(mgr, NULL); nc != NULL; nc = mg_next(mgr, nc)) {
-                if (!is_websocket(*nc) || is_listen_socket(*nc) || is_notify_socket(*nc))
-                    continue;
-                ++active_connections;
-                if (notify_nc == nc) {
-                    send_frame(*nc, rep);
-                }
-            }
-
-            if (active_connections != map_connections_.size()) {
-                refresh_connections();
-            }
-        });
-    }
+    });
 }
 
 void WsPushServ::notify_transaction(uint32_t height, const hash_digest& block_hash, const transaction& tx)
@@ -273,22 +278,11 @@ void WsPushServ::notify_transaction(uint32_t height, const hash_digest& block_ha
         return;
     }
 
-    connection_string_map subscribers;
     {
         std::lock_guard<std::mutex> guard(subscribers_lock_);
-        if (subscribers_.size() == 0) {
+        if (subscribers_.empty()) {
             return;
         }
-
-        for (auto& con : subscribers_) {
-            if (!con.first.expired()) {
-                subscribers.insert(con);
-            }
-        }
-
-        if (subscribers.size() != subscribers_.size()) {
-            subscribers_ = subscribers;
-        }
     }
 
     /* ---------- may has subscribers ---------- */
@@ -297,59 +291,196 @@ void WsPushServ::notify_transaction(uint32_t height, const hash_digest& block_ha
     for (const auto& input : tx.inputs) {
         const auto address = wallet::payment_address::extract(input.script);
         if (address) {
-            auto addr_hash = address.encoded();
-            if (tx_addrs.end() == std::find(tx_addrs.begin(), tx_addrs.end(), addr_hash)) {
-                tx_addrs.push_back(addr_hash);
-            }
+            tx_addrs.push_back(address.encoded());
         }
     }
 
     for (const auto& output : tx.outputs) {
         const auto address = wallet::payment_address::extract(output.script);
         if (address) {
-            auto addr_hash = address.encoded();
-            if (tx_addrs.end() == std::find(tx_addrs.begin(), tx_addrs.end(), addr_hash)) {
-                tx_addrs.push_back(addr_hash);
-            }
+            tx_addrs.push_back(address.encoded());
         }
     }
 
-    std::shared_ptr<connection_string_map> topic_map = std::make_shared<connection_string_map>();
+    std::sort(tx_addrs.begin(), tx_addrs.end());
+    tx_addrs.erase(std::unique(tx_addrs.begin(), tx_addrs.end()), tx_addrs.end());
 
-    std::vector<std::weak_ptr<mg_connection>> notify_cons;
-    for (auto& sub : subscribers)
+    // Route through the index, in time proportional to the tx addresses.
+    std::map<std::shared_ptr<mg_connection>, string_vector> topic_map;
     {
-        string_vector topics;
-        auto& sub_addrs = sub.second;
-        if (sub_addrs.empty()) {
-            topics.push_back(CH_ALL);
+        std::lock_guard<std::mutex> guard(subscribers_lock_);
+
+        std::vector<connection_ptr> stale;
+        for (const auto& con : all_subscribers_) {
+            auto shared_con = con.lock();
+            if (shared_con)
+                topic_map[shared_con].push_back(CH_ALL);
+            else
+                stale.push_back(con);
         }
-        else {
-            for (auto& addr_hash : sub_addrs) {
-                if (tx_addrs.end() != std::find(tx_addrs.begin(), tx_addrs.end(), addr_hash)) {
-                    topics.push_back(addr_hash);
-                }
+
+        for (const auto& addr_hash : tx_addrs) {
+            const auto it = address_index_.find(addr_hash);
+            if (it == address_index_.end())
+                continue;
+
+            for (const auto& con : it->second) {
+                auto shared_con = con.lock();
+                if (shared_con)
+                    topic_map[shared_con].push_back(addr_hash);
+                else
+                    stale.push_back(con);
             }
         }
 
-        if (!topics.empty()) {
-            topic_map->insert({sub.first, topics});
-            notify_cons.push_back(sub.first);
+        for (const auto& con : stale) {
+            remove_address_subscriber(con);
         }
     }
 
-    if (notify_cons.size() == 0) {
+    if (topic_map.empty()) {
         return;
     }
 
     // log::info(NAME) << " ******** notify_transaction: height [" << height << "]  ******** ";
 
-    Json::Value root;
-    root["event"] = EV_PUBLISH;
-    root["channel"] = CH_TRANSACTION;
-    root["result"] = get_json_helper().prop_list(tx, height, true);
+    const auto result = to_compact_string(
+        get_json_helper().prop_list(tx, height, true));
+
+    // Recipients with the same topic share one serialized frame.
+    std::unordered_map<std::string, payload_ptr> payloads;
+    notification_list notifications;
+    for (const auto& entry : topic_map) {
+        const auto& topics = entry.second;
+        std::string topic;
+        if (topics.front() == CH_ALL) {
+            topic = Json::valueToQuotedString(CH_ALL);
+        }
+        else if (topics.size() == 1) {
+            topic = Json::valueToQuotedString(topics.front().c_str());
+        }
+        else {
+            topic = "[";
+            for (const auto& each : topics) {
+                if (topic.size() > 1)
+                    topic += ",";
+                topic += Json::valueToQuotedString(each.c_str());
+            }
+            topic += "]";
+        }
 
-    do_notify(notify_cons, root, topic_map);
+        auto& payload = payloads[topic];
+        if (!payload) {
+            payload = std::make_shared<const std::string>(
+                to_publish_frame(CH_TRANSACTION, topic, result));
+        }
+
+        notifications.emplace_back(entry.first, payload);
+    }
+
+    do_notify(notifications);
+}
+
+void WsPushServ::subscribe_addresses(const connection_ptr& con,
+    const string_vector& addresses)
+{
+    std::lock_guard<std::mutex> guard(subscribers_lock_);
+    auto& sub_list = subscribers_[con];
+
+    if (addresses.empty()) {
+        for (const auto& address : sub_list) {
+            auto it = address_index_.find(address);
+            if (it != address_index_.end()) {
+                it->second.erase(con);
+                if (it->second.empty())
+                    address_index_.erase(it);
+            }
+        }
+
+        sub_list.clear();
+        all_subscribers_.insert(con);
+        return;
+    }
+
+    if (sub_list.empty()) {
+        all_subscribers_.erase(con);
+    }
+
+    for (const auto& address : addresses) {
+        if (address_index_[address].insert(con).second) {
+            sub_list.push_back(address);
+        }
+    }
+}
+
+void WsPushServ::unsubscribe_addresses(const connection_ptr& con)
+{
+    std::lock_guard<std::mutex> guard(subscribers_lock_);
+    remove_address_subscriber(con);
+}
+
+void WsPushServ::subscribe_channel(const connection_ptr& con,
+    const std::string& channel)
+{
+    std::lock_guard<std::mutex> guard(block_subscribers_lock_);
+    if (channel_index_[channel].insert(con).second) {
+        block_subscribers_[con].push_back(channel);
+    }
+}
+
+void WsPushServ::unsubscribe_channel(const connection_ptr& con,
+    const std::string& channel)
+{
+    std::lock_guard<std::mutex> guard(block_subscribers_lock_);
+    auto iter = block_subscribers_.find(con);
+    if (iter == block_subscribers_.end()) {
+        return;
+    }
+
+    auto& params = iter->second;
+    auto chit = std::find(params.begin(), params.end(), channel);
+    if (chit != params.end()) {
+        params.erase(chit);
+        channel_index_[channel].erase(con);
+    }
+
+    if (params.empty()) {
+        block_subscribers_.erase(iter);
+    }
+}
+
+void WsPushServ::remove_address_subscriber(const connection_ptr& con)
+{
+    auto iter = subscribers_.find(con);
+    if (iter == subscribers_.end()) {
+        return;
+    }
+
+    for (const auto& address : iter->second) {
+        auto it = address_index_.find(address);
+        if (it != address_index_.end()) {
+            it->second.erase(con);
+            if (it->second.empty())
+                address_index_.erase(it);
+        }
+    }
+
+    all_subscribers_.erase(con);
+    subscribers_.erase(iter);
+}
+
+void WsPushServ::remove_channel_subscriber(const connection_ptr& con)
+{
+    auto iter = block_subscribers_.find(con);
+    if (iter == block_subscribers_.end()) {
+        return;
+    }
+
+    for (const auto& channel : iter->second) {
+        channel_index_[channel].erase(con);
+    }
+
+    block_subscribers_.erase(iter);
 }
 
 void WsPushServ::send_bad_response(struct mg_connection& nc, const char* message, int code, Json::Value data)
@@ -390,8 +521,16 @@ void WsPushServ::refresh_connections()
     for (auto* nc = mg_next(mgr, NULL); nc != NULL; nc = mg_next(mgr, nc)) {
         if (!is_websocket(*nc) || is_listen_socket(*nc) || is_notify_socket(*nc))
             continue;
+
+        // Keep live handles so that their subscriptions stay indexed.
+        auto it = map_connections_.find(nc);
+        if (it != map_connections_.end()) {
+            swap.emplace(nc, it->second);
+            continue;
+        }
+
         std::shared_ptr<struct mg_connection> con(nc, [](struct mg_connection * ptr) { (void)(ptr); });
-        swap.emplace(&nc, con);
+        swap.emplace(nc, con);
     }
     map_connections_.swap(swap);
 }
@@ -506,37 +645,8 @@ void WsPushServ::on_ws_frame_handler(struct mg_connection& nc, websocket_message
 
             auto it = map_connections_.find(&nc);
             if (it != map_connections_.end()) {
-                std::lock_guard<std::mutex> guard(subscribers_lock_);
-                std::weak_ptr<struct mg_connection> week_con(it->second);
-                auto sub_it = subscribers_.find(week_con);
-                if (sub_it != subscribers_.end()) {
-                    auto& sub_list = sub_it->second;
-
-                    if (addresses.empty()) {
-                        sub_list.clear();
-                        send_response(nc, EV_SUBSCRIBED, channel);
-                        return;
-                    }
-
-                    for (const auto& address : addresses) {
-                        if (sub_list.end() == std::find(sub_list.begin(), sub_list.end(), address)) {
-                            sub_list.push_back(address);
-                        }
-                    }
-
-                    send_response(nc, EV_SUBSCRIBED, channel);
-                }
-                else {
-                    string_vector sub_list;
-                    for (const auto& address : addresses) {
-                        if (sub_list.end() == std::find(sub_list.begin(), sub_list.end(), address)) {
-                            sub_list.push_back(address);
-                        }
-                    }
-
-                    subscribers_.insert({ week_con, sub_list });
-                    send_response(nc, EV_SUBSCRIBED, channel);
-                }
+                subscribe_addresses(it->second, addresses);
+                send_response(nc, EV_SUBSCRIBED, channel);
             }
             else {
                 send_bad_response(nc, "connection lost.");
@@ -545,9 +655,7 @@ void WsPushServ::on_ws_frame_handler(struct mg_connection& nc, websocket_message
         else if ((event == EV_UNSUBSCRIBE) && (channel == CH_TRANSACTION)) {
             auto it = map_connections_.find(&nc);
             if (it != map_connections_.end()) {
-                std::lock_guard<std::mutex> guard(subscribers_lock_);
-                std::weak_ptr<struct mg_connection> week_con(it->second);
-                subscribers_.erase(week_con);
+                unsubscribe_addresses(it->second);
                 send_response(nc, EV_UNSUBSCRIBED, channel);
             }
             else {
@@ -559,25 +667,8 @@ void WsPushServ::on_ws_frame_handler(struct mg_connection& nc, websocket_message
             if (event == EV_SUBSCRIBE) {
                 auto it = map_connections_.find(&nc);
                 if (it != map_connections_.end()) {
-                    std::lock_guard<std::mutex> guard(block_subscribers_lock_);
-                    std::weak_ptr<struct mg_connection> week_con(it->second);
-
-                    auto iter = block_subscribers_.find(week_con);
-                    if (iter != block_subscribers_.end()) {
-                        auto& sub_list = iter->second;
-                        if (sub_list.end() == std::find(sub_list.begin(), sub_list.end(), channel)) {
-                            sub_list.push_back(channel);
-                        }
-
-                        send_response(nc, EV_SUBSCRIBED, channel);
-                    }
-                    else {
-                        string_vector sub_list;
-                        sub_list.push_back(channel);
-
-                        block_subscribers_.insert({ week_con, sub_list });
-                        send_response(nc, EV_SUBSCRIBED, channel);
-                    }
+                    subscribe_channel(it->second, channel);
+                    send_response(nc, EV_SUBSCRIBED, channel);
                 }
                 else {
                     send_bad_response(nc, "connection lost.");
@@ -586,22 +677,7 @@ void WsPushServ::on_ws_frame_handler(struct mg_connection& nc, websocket_message
             else if (event == EV_UNSUBSCRIBE) {
                 auto it = map_connections_.find(&nc);
                 if (it != map_connections_.end()) {
-                    std::lock_guard<std::mutex> guard(block_subscribers_lock_);
-                    std::weak_ptr<struct mg_connection> week_con(it->second);
-
-                    auto iter = block_subscribers_.find(week_con);
-                    if (iter != block_subscribers_.end()) {
-                        auto& params = iter->second;
-                        auto chit = std::find(params.begin(), params.end(), channel);
-                        if (chit != params.end()) {
-                            params.erase(chit);
-                        }
-
-                        if (params.empty()) {
-                            subscribers_.erase(week_con);
-                        }
-                    }
-
+                    unsubscribe_channel(it->second, channel);
                     send_response(nc, EV_UNSUBSCRIBED, channel);
                 }
                 else {
@@ -639,7 +715,19 @@ void WsPushServ::on_close_handler(struct mg_connection& nc)
 {
     if (is_websocket(nc))
     {
-        map_connections_.erase(&nc);
+        auto it = map_connections_.find(&nc);
+        if (it != map_connections_.end()) {
+            const connection_ptr con(it->second);
+            {
+                std::lock_guard<std::mutex> guard(subscribers_lock_);
+                remove_address_subscriber(con);
+            }
+            {
+                std::lock_guard<std::mutex> guard(block_subscribers_lock_);
+                remove_channel_subscriber(con);
+            }
+            map_connections_.erase(it);
+        }
     }
 }
 
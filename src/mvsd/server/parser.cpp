@@ -75,6 +75,44 @@ options_metadata parser::load_options()
             default_value(false)->zero_tokens(),
         "Initialize blockchain in the configured directory."
     )
+    (
+        "replay",
+        value<path>(&configured.replay),
+        "Replay the blocks of the database directory or block export at the given path into the configured (fresh) directory, without networking, and report stage timings."
+    )
+    (
+        "export",
+        value<path>(&configured.export_file),
+        "Export the blocks of the configured directory to a block file at the given path."
+    )
+    (
+        "export-start",
+        value<uint64_t>(&configured.export_start)->
+            default_value(1),
+        "The first block height to export, defaults to 1."
+    )
+    (
+        "export-stop",
+        value<uint64_t>(&configured.export_stop),
+        "The last block height to export, defaults to the top block."
+    )
+    (
+        "import",
+        value<path>(&configured.import_file),
+        "Import a block file at the given path into the configured directory, without networking."
+    )
+    (
+        "import-batch",
+        value<uint32_t>(&configured.import_batch)->
+            default_value(1000),
+        "The number of imported blocks to commit per flush, defaults to 1000."
+    )
+    (
+        "import-trusted",
+        value<bool>(&configured.import_trusted)->
+            default_value(false)->zero_tokens(),
+        "Skip script and spend checks of imported blocks at or below the last checkpoint."
+    )
     (
         BS_SETTINGS_VARIABLE ",s",
         value<bool>(&configured.settings)->
@@ -159,7 +197,7 @@ options_metadata parser::load_settings()
     (
         "network.protocol",
         value<uint32_t>(&configured.network.protocol),
-        "The network protocol version, defaults to 70012."
+        "The network protocol version, defaults to 70014."
     )
     (
         "network.identifier",
@@ -303,6 +341,31 @@ options_metadata parser::load_settings()
         value<path>(&configured.database.directory),
         "The blockchain database directory, defaults to 'mainnet'."
     )
+    (
+        "database.file_access",
+        value<std::string>(&configured.database.file_access),
+        "The expected access pattern of the database files [random|normal|sequential|willneed], defaults to random. Use sequential or willneed for initial sync and import."
+    )
+    (
+        "database.huge_page_file",
+        value<std::vector<std::string>>(&configured.database.huge_page_files),
+        "A database file (e.g. transaction_table) to back with transparent huge pages, multiple entries allowed."
+    )
+    (
+        "database.locked_header_file",
+        value<std::vector<std::string>>(&configured.database.locked_header_files),
+        "A database file (e.g. spend_table) whose hash table buckets are locked in memory, multiple entries allowed."
+    )
+    (
+        "database.preallocate_files",
+        value<bool>(&configured.database.preallocate_files),
+        "Allocate disk blocks when database files grow instead of extending them sparsely, defaults to false."
+    )
+    (
+        "database.file_growth_rate",
+        value<uint32_t>(&configured.database.file_growth_rate),
+        "The size of a grown database file as a percentage of the size required, defaults to 150."
+    )
 
     /* [blockchain] */
     (
@@ -335,6 +398,11 @@ options_metadata parser::load_settings()
         value<bool>(&configured.chain.collect_split_stake),
         "Automatically collect or split utxos for pos stake, defaults to true."
     )
+    (
+        "blockchain.scheduler_threads",
+        value<uint32_t>(&configured.chain.scheduler_threads),
+        "The number of threads for fanning out independent validation and notification work, zero uses one per hardware thread, defaults to 0."
+    )
 
     /* [node] */
     (
@@ -352,6 +420,26 @@ options_metadata parser::load_settings()
         value<bool>(&configured.node.transaction_pool_refresh),
         "Refresh the transaction pool on reorganization and channel start, defaults to true."
     )
+    (
+        "node.block_threads",
+        value<uint32_t>(&configured.node.block_threads),
+        "The number of threads dedicated to block validation, zero shares the network threads, defaults to 0."
+    )
+    (
+        "node.block_processors",
+        value<std::vector<uint32_t>>(&configured.node.block_processors),
+        "A processor to pin block validation threads to, multiple entries allowed, defaults to none."
+    )
+    (
+        "node.transaction_threads",
+        value<uint32_t>(&configured.node.transaction_threads),
+        "The number of threads dedicated to transaction pool validation, zero shares the network threads, defaults to 0."
+    )
+    (
+        "node.transaction_processors",
+        value<std::vector<uint32_t>>(&configured.node.transaction_processors),
+        "A processor to pin transaction pool threads to, multiple entries allowed, defaults to none."
+    )
 
     /* [server] */
     (
@@ -374,6 +462,26 @@ options_metadata parser::load_settings()
         value<uint16_t>(&configured.server.query_workers),
         "The number of query worker threads per endpoint, defaults to 1."
     )
+    (
+        "server.query_pipeline",
+        value<uint16_t>(&configured.server.query_pipeline),
+        "The maximum number of queries in flight per query worker, zero executes each query on the worker thread, defaults to 64."
+    )
+    (
+        "server.query_batch",
+        value<uint16_t>(&configured.server.query_batch),
+        "The maximum number of queued queries dispatched together, defaults to 16."
+    )
+    (
+        "server.query_threads",
+        value<uint16_t>(&configured.server.query_threads),
+        "The number of threads dedicated to executing queries, zero shares the network threads, defaults to 0."
+    )
+    (
+        "server.query_processors",
+        value<std::vector<uint32_t>>(&configured.server.query_processors),
+        "A processor to pin query threads to, multiple entries allowed, defaults to none."
+    )
     (
         "server.heartbeat_interval_seconds",
         value<uint32_t>(&configured.server.heartbeat_interval_seconds),
@@ -399,6 +507,11 @@ options_metadata parser::load_settings()
         value<std::string>(&configured.server.rpc_version),
         "Server RPC version, defaults to empty string, only used by mvs-cli."
     )
+    (
+        "server.rpc_compact_json",
+        value<bool>(&configured.server.rpc_compact_json),
+        "Write RPC responses as compact rather than indented JSON, defaults to false."
+    )
     (
         "server.secure_only",
         value<bool>(&configured.server.secure_only),
@@ -82,6 +82,12 @@ const settings& server_node::server_settings() const
     return configuration_.server;
 }
 
+threadpool& server_node::query_executor()
+{
+    return configuration_.server.query_threads == 0 ? thread_pool() :
+        query_pool_;
+}
+
 bool server_node::is_use_testnet_rules() const
 {
     return configuration_.use_testnet_rules;
@@ -95,6 +101,11 @@ void server_node::start(result_handler handler)
         return;
     }
 
+    // Queries run at normal priority, ahead of network and validation work.
+    query_pool_.join();
+    query_pool_.spawn(configuration_.server.query_threads,
+        thread_priority::normal, configuration_.server.query_processors);
+
     p2p_node::start(handler);
 
     if (!rest_server_->start() || !push_server_->start())
@@ -167,8 +178,12 @@ bool server_node::stop()
 // This must be called from the thread that constructed this class (see join).
 bool server_node::close()
 {
-    // Invoke own stop to signal work suspension, then close node and join.
-    return server_node::stop() && p2p_node::close();
+    // Invoke own stop to signal work suspension, then join queries so that
+    // none is reading the chain when the node closes it.
+    const auto stopped = server_node::stop();
+    query_pool_.shutdown();
+    query_pool_.join();
+    return stopped && p2p_node::close();
 }
 
 /// Get miner.
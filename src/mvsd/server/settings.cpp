@@ -28,6 +28,9 @@ using namespace asio;
 
 settings::settings()
   : query_workers(1),
+    query_pipeline(64),
+    query_batch(16),
+    query_threads(0),
     heartbeat_interval_seconds(5),
     subscription_expiration_minutes(10),
     subscription_limit(100000000),
@@ -37,6 +40,7 @@ settings::settings()
     log_level("DEBUG"),
     rpc_version(""),
     secure_only(false),
+    rpc_compact_json(false),
     query_service_enabled(true),
     heartbeat_service_enabled(false),
     block_service_enabled(false),
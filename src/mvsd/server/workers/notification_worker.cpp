@@ -375,7 +375,6 @@ void notification_worker::subscribe_address(const route& reply_to, uint32_t id,
 {
     static const auto error_code = error::channel_stopped;
     const auto& duration = settings_.subscription_expiration();
-    const address_key key(reply_to, prefix_filter);
 
     switch (type)
     {
@@ -387,8 +386,8 @@ void notification_worker::subscribe_address(const route& reply_to, uint32_t id,
                 std::bind(&notification_worker::handle_payment,
                     this, _1, _2, _3, _4, _5, reply_to, id, prefix_filter);
 
-            payment_subscriber_->subscribe(handler, key, duration, error_code,
-                {}, 0, {}, {});
+            payment_subscriber_->subscribe(handler, reply_to, prefix_filter,
+                duration, error_code, {}, 0, {}, {});
             break;
         }
 
@@ -400,8 +399,8 @@ void notification_worker::subscribe_address(const route& reply_to, uint32_t id,
                 std::bind(&notification_worker::handle_stealth,
                     this, _1, _2, _3, _4, _5, reply_to, id, prefix_filter);
 
-            stealth_subscriber_->subscribe(handler, key, duration, error_code,
-                0, 0, {}, {});
+            stealth_subscriber_->subscribe(handler, reply_to, prefix_filter,
+                duration, error_code, 0, 0, {}, {});
             break;
         }
 
@@ -418,8 +417,8 @@ void notification_worker::subscribe_address(const route& reply_to, uint32_t id,
                     sequence);
 
             // v3
-            address_subscriber_->subscribe(handler, key, duration, error_code,
-                {}, 0, {}, {});
+            address_subscriber_->subscribe(handler, reply_to, prefix_filter,
+                duration, error_code, {}, 0, {}, {});
             break;
         }
 
@@ -433,7 +432,8 @@ void notification_worker::subscribe_address(const route& reply_to, uint32_t id,
             // opposed to error::channel_timeout.
 
             // v3
-            address_subscriber_->unsubscribe(key, error_code, {}, 0, {}, {});
+            address_subscriber_->unsubscribe(reply_to, prefix_filter,
+                error_code, {}, 0, {}, {});
             break;
         }
     }
@@ -612,7 +612,7 @@ void notification_worker::notify_transaction(uint32_t height,
         {
             const binary field(address_bits, address.hash());
             notify_address(field, height, block_hash, tx);
-            notify_payment(address, height, block_hash, tx);
+            notify_payment(field, address, height, block_hash, tx);
         }
     }
 
@@ -626,7 +626,7 @@ void notification_worker::notify_transaction(uint32_t height,
         {
             const binary field(address_bits, address.hash());
             notify_address(field, height, block_hash, tx);
-            notify_payment(address, height, block_hash, tx);
+            notify_payment(field, address, height, block_hash, tx);
         }
     }
 
@@ -644,25 +644,27 @@ void notification_worker::notify_transaction(uint32_t height,
         {
             const binary field(prefix_bits, to_little_endian(prefix));
             notify_address(field, height, block_hash, tx);
-            notify_stealth(prefix, height, block_hash, tx);
+            notify_stealth(field, prefix, height, block_hash, tx);
         }
     }
 }
 
 // v2/v3 (deprecated)
-void notification_worker::notify_payment(const payment_address& address,
-    uint32_t height, const hash_digest& block_hash, const transaction& tx)
+void notification_worker::notify_payment(const binary& field,
+    const payment_address& address, uint32_t height,
+    const hash_digest& block_hash, const transaction& tx)
 {
     static const auto code = error::success;
-    payment_subscriber_->relay(code, address, height, block_hash, tx);
+    payment_subscriber_->relay(field, code, address, height, block_hash, tx);
 }
 
 // v2/v3 (deprecated)
-void notification_worker::notify_stealth(uint32_t prefix, uint32_t height,
-    const hash_digest& block_hash, const transaction& tx)
+void notification_worker::notify_stealth(const binary& field,
+    uint32_t prefix, uint32_t height, const hash_digest& block_hash,
+    const transaction& tx)
 {
     static const auto code = error::success;
-    stealth_subscriber_->relay(code, prefix, height, block_hash, tx);
+    stealth_subscriber_->relay(field, code, prefix, height, block_hash, tx);
 }
 
 // v3
@@ -670,7 +672,7 @@ void notification_worker::notify_address(const binary& field, uint32_t height,
     const hash_digest& block_hash, const transaction& tx)
 {
     static const auto code = error::success;
-    address_subscriber_->relay(code, field, height, block_hash, tx);
+    address_subscriber_->relay(field, code, field, height, block_hash, tx);
 }
 
 // v3.x
@@ -20,8 +20,11 @@
  */
 #include <metaverse/server/workers/query_worker.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <string>
+#include <utility>
 #include <metaverse/protocol.hpp>
 #include <metaverse/server/define.hpp>
 #include <metaverse/server/interface/address.hpp>
@@ -34,21 +37,34 @@
 namespace libbitcoin {
 namespace server {
 
+#define NAME "query_worker"
+
 using namespace std::placeholders;
 using namespace bc::protocol;
 
+// A query unanswered for this long is presumed dropped by its handler and is
+// no longer counted as pending. A late response is still sent.
+static const asio::seconds abandoned_query_timeout(60);
+
 query_worker::query_worker(zmq::authenticator& authenticator,
     server_node& node, bool secure)
   : worker(node.thread_pool()),
     secure_(secure),
     settings_(node.server_settings()),
     node_(node),
-    authenticator_(authenticator)
+    authenticator_(authenticator),
+    dispatch_(node.query_executor(), NAME),
+    pending_(0)
 {
     // The same interface is attached to the secure and public interfaces.
     attach_interface();
 }
 
+size_t query_worker::pending() const
+{
+    return pending_;
+}
+
 // Implement worker as a router to the query service.
 // v2 libbitcoin-client DEALER does not add delimiter frame.
 // The router drops messages for lost peers (query service) and high water.
@@ -60,17 +76,83 @@ void query_worker::work()
     if (!started(connect(router)))
         return;
 
+    // Handlers signal queued responses over an inproc pair to this thread.
+    zmq::socket wakeup(authenticator_, zmq::socket::role::pair);
+    const config::endpoint signal_endpoint("inproc://query_worker_" +
+        std::to_string(reinterpret_cast<uintptr_t>(this)));
+
+    if (!started(open_signal(wakeup, signal_endpoint)))
+        return;
+
     zmq::poller poller;
     poller.add(router);
+    poller.add(wakeup);
+    auto timeout = expire();
 
     while (!poller.terminated() && !stopped())
     {
-        if (poller.wait().contains(router.id()))
-            query(router);
+        // Block until a query, a response or the next abandon deadline.
+        const auto signaled = timeout < 0 ? poller.wait() :
+            poller.wait(timeout);
+
+        if (signaled.contains(wakeup.id()))
+        {
+            // One signal is sent for each batch of queued responses.
+            zmq::message signal;
+            signal.receive(wakeup);
+        }
+
+        if (signaled.contains(router.id()))
+            query(router, poller);
+
+        respond(router);
+        timeout = expire();
     }
 
+    close_signal();
+
     // Disconnect the socket and exit this thread.
-    finished(disconnect(router));
+    finished(disconnect(router) && wakeup.stop());
+}
+
+// The worker side is bound before the handler side connects (inproc).
+bool query_worker::open_signal(zmq::socket& wakeup,
+    const config::endpoint& endpoint)
+{
+    auto signal = std::make_shared<zmq::socket>(authenticator_,
+        zmq::socket::role::pair);
+
+    const auto ec = wakeup.bind(endpoint);
+    const auto connected = !ec && !signal->connect(endpoint);
+
+    if (!connected)
+    {
+        log::error(LOG_SERVER)
+            << "Failed to open query worker signal " << endpoint;
+        return false;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
+
+    signal_ = signal;
+    return true;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// Handlers may complete after the worker exits, they then signal nothing.
+void query_worker::close_signal()
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
+
+    if (signal_)
+        signal_->stop();
+
+    signal_.reset();
+    ///////////////////////////////////////////////////////////////////////////
 }
 
 // Connect/Disconnect.
@@ -114,15 +196,52 @@ bool query_worker::disconnect(zmq::socket& router)
 //-----------------------------------------------------------------------------
 
 // Because the socket is a router we may simply drop invalid queries.
-// As a single thread worker this router should not reach high water.
-// If we implemented as a replier we would need to always provide a response.
-void query_worker::query(zmq::socket& router)
+// Queries already queued on the socket are taken with the first, up to the
+// batch limit, and dispatched as one job. The job runs inline when the
+// pipeline is disabled or full, which pushes back on the clients.
+void query_worker::query(zmq::socket& router, zmq::poller& poller)
 {
     if (stopped())
         return;
 
-    // TODO: rewrite the serial blockchain interface to avoid callbacks.
-    // We are using a closure vs. bind to take advantage of move arg syntax.
+    const size_t limit = std::max<size_t>(settings_.query_batch, 1);
+    query_batch batch;
+    batch.reserve(limit);
+
+    if (!receive(router, batch))
+        return;
+
+    while (batch.size() < limit && poller.wait(0).contains(router.id()))
+        if (!receive(router, batch))
+            break;
+
+    if (batch.empty())
+        return;
+
+    const auto in_flight = pending_.load();
+    pending_ += batch.size();
+
+    const auto expiry = asio::steady_clock::now() + abandoned_query_timeout;
+    for (const auto& task: batch)
+        outstanding_.push_back({ expiry, task.answered });
+
+    log::debug(LOG_SERVER)
+        << "Query batch (" << batch.size() << ") with (" << in_flight
+        << ") in flight.";
+
+    if (in_flight + batch.size() > settings_.query_pipeline)
+    {
+        execute(batch);
+        respond(router);
+        return;
+    }
+
+    dispatch_.concurrent(&query_worker::execute, this, std::move(batch));
+}
+
+// Invalid and unknown queries are answered directly, false if stopped.
+bool query_worker::receive(zmq::socket& router, query_batch& batch)
+{
     const auto sender = [&router](message&& response)
     {
         const auto ec = response.send(router);
@@ -137,7 +256,7 @@ void query_worker::query(zmq::socket& router)
     const auto ec = request.receive(router);
 
     if (ec.value() == error::service_stopped)
-        return;
+        return false;
 
     if (ec)
     {
@@ -147,7 +266,7 @@ void query_worker::query(zmq::socket& router)
 
         // Because the query did not parse this is likely to be misaddressed.
         sender(message(request, ec));
-        return;
+        return true;
     }
 
     // Locate the request handler for this command.
@@ -159,7 +278,7 @@ void query_worker::query(zmq::socket& router)
             << "Invalid query command from " << request.route().display();
 
         sender(message(request, error::not_found));
-        return;
+        return true;
     }
 
     log::debug(LOG_SERVER)
@@ -167,12 +286,108 @@ void query_worker::query(zmq::socket& router)
         << request.route().display();
 
     // The query executor is the delegate bound by the attach method.
-    const auto& query_execute = handler->second;
+    batch.push_back({ std::move(request), handler->second,
+        std::make_shared<std::atomic<bool>>(false) });
+    return true;
+}
+
+// Execute each request, responses are queued for the worker thread.
+// Example: address.renew(node_, request, sender);
+// Example: blockchain.fetch_history(node_, request, sender);
+void query_worker::execute(const query_batch& batch)
+{
+    for (const auto& task: batch)
+    {
+        const auto answered = task.answered;
+        const auto sender = [this, answered](message&& response)
+        {
+            complete(std::move(response), answered);
+        };
+
+        task.execute(task.request, sender);
+    }
+}
+
+// Only the first response (or expiry) of a query releases it.
+void query_worker::complete(message&& response, answer_ptr answered)
+{
+    if (!answered->exchange(true))
+        --pending_;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    // The signal socket is used by any thread, but only under this lock.
+    unique_lock lock(mutex_);
+
+    const auto idle = responses_.empty();
+    responses_.push_back(std::move(response));
+
+    // The worker swaps out all queued responses on each signal.
+    if (idle && signal_)
+    {
+        zmq::message signal;
+        signal.enqueue();
+        signal.send(*signal_);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+// Release queries that were answered or have expired, oldest first.
+// Returns the milliseconds to the next expiry, negative if none is due.
+int32_t query_worker::expire()
+{
+    const auto now = asio::steady_clock::now();
 
-    // Execute the request and forward result to queue.
-    // Example: address.renew(node_, request, sender);
-    // Example: blockchain.fetch_history(node_, request, sender);
-    query_execute(request, sender);
+    while (!outstanding_.empty())
+    {
+        const auto& front = outstanding_.front();
+
+        if (!front.answered->load())
+        {
+            if (front.expiry > now)
+                break;
+
+            if (!front.answered->exchange(true))
+            {
+                --pending_;
+                log::warning(LOG_SERVER)
+                    << "Query abandoned without a response.";
+            }
+        }
+
+        outstanding_.pop_front();
+    }
+
+    if (outstanding_.empty())
+        return -1;
+
+    // Round up so that the wait does not end just short of the deadline.
+    const auto remaining = std::chrono::duration_cast<asio::milliseconds>(
+        outstanding_.front().expiry - now) + asio::milliseconds(1);
+    return static_cast<int32_t>(remaining.count());
+}
+
+// Send queued responses, only the worker thread may use the socket.
+void query_worker::respond(zmq::socket& router)
+{
+    std::vector<message> responses;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    mutex_.lock();
+    responses.swap(responses_);
+    mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    for (auto& response: responses)
+    {
+        const auto ec = response.send(router);
+
+        if (ec && ec.value() != error::service_stopped)
+            log::warning(LOG_SERVER)
+                << "Failed to send query response to "
+                << response.route().display() << " " << ec.message();
+    }
 }
 
 // Query Interface.
@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MVS_TEST_BENCH_HPP
+#define MVS_TEST_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/// Timing state handed to a benchmark. Setup done before start() and
+/// teardown after stop() are excluded from the measurement.
+class state
+{
+public:
+    typedef std::chrono::steady_clock clock;
+
+    explicit state(size_t iterations)
+      : iterations_(iterations), items_(iterations), elapsed_(0)
+    {
+    }
+
+    size_t iterations() const
+    {
+        return iterations_;
+    }
+
+    void start()
+    {
+        started_ = clock::now();
+    }
+
+    void stop()
+    {
+        elapsed_ += clock::now() - started_;
+    }
+
+    /// Items processed, when an iteration handles more than one.
+    void set_items(size_t items)
+    {
+        items_ = items;
+    }
+
+    size_t items() const
+    {
+        return items_;
+    }
+
+    clock::duration elapsed() const
+    {
+        return elapsed_;
+    }
+
+private:
+    const size_t iterations_;
+    size_t items_;
+    clock::time_point started_;
+    clock::duration elapsed_;
+};
+
+typedef std::function<void(state&)> handler;
+
+struct benchmark
+{
+    std::string name;
+    handler run;
+};
+
+/// Benchmarks register themselves at static initialization.
+std::vector<benchmark>& registry();
+
+struct registrar
+{
+    registrar(const std::string& name, handler run)
+    {
+        registry().push_back({ name, run });
+    }
+};
+
+} // namespace bench
+
+#define BENCHMARK_CASE(group, name) \
+    static void group##_##name(bench::state& state); \
+    static const bench::registrar group##_##name##_registrar( \
+        #group "/" #name, group##_##name); \
+    static void group##_##name(bench::state& state)
+
+#endif
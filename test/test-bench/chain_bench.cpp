@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <metaverse/bitcoin.hpp>
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+using namespace libbitcoin;
+using namespace libbitcoin::chain;
+
+// Serialization.
+// ----------------------------------------------------------------------------
+
+BENCHMARK_CASE(chain, transaction_to_data)
+{
+    const auto tx = bench::make_transaction(1);
+    size_t bytes = 0;
+
+    state.start();
+    for (size_t i = 0; i < state.iterations(); ++i)
+        bytes += tx.to_data().size();
+    state.stop();
+
+    BITCOIN_ASSERT(bytes != 0);
+}
+
+BENCHMARK_CASE(chain, transaction_from_data)
+{
+    const auto data = bench::make_transaction(1).to_data();
+    transaction tx;
+
+    state.start();
+    for (size_t i = 0; i < state.iterations(); ++i)
+        tx.from_data(data);
+    state.stop();
+}
+
+BENCHMARK_CASE(chain, block_round_trip)
+{
+    static const size_t transactions = 1000;
+
+    block original;
+    for (size_t tx = 0; tx < transactions; ++tx)
+        original.transactions.push_back(bench::make_transaction(tx));
+
+    const auto iterations = std::max<size_t>(1, state.iterations() / 100);
+    block copy;
+
+    state.start();
+    for (size_t i = 0; i < iterations; ++i)
+        copy.from_data(original.to_data());
+    state.stop();
+
+    state.set_items(iterations * transactions);
+}
+
+// Signatures.
+// ----------------------------------------------------------------------------
+
+BENCHMARK_CASE(chain, generate_signature_hash)
+{
+    const auto spend = bench::make_signed_spend(1);
+
+    state.start();
+    for (size_t i = 0; i < state.iterations(); ++i)
+        script::generate_signature_hash(spend.tx, 0, spend.prevout_script,
+            signature_hash_algorithm::all);
+    state.stop();
+}
+
+BENCHMARK_CASE(chain, script_verify)
+{
+    const auto spend = bench::make_signed_spend(1);
+    const auto& input_script = spend.tx.inputs[0].script;
+    size_t valid = 0;
+
+    state.start();
+    for (size_t i = 0; i < state.iterations(); ++i)
+        valid += script::verify(input_script, spend.prevout_script, spend.tx,
+            0, script_context::all_enabled) ? 1 : 0;
+    state.stop();
+
+    BITCOIN_ASSERT(valid == state.iterations());
+}
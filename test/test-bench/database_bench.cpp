@@ -0,0 +1,202 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <metaverse/bitcoin.hpp>
+#include <metaverse/database.hpp>
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+using namespace libbitcoin;
+using namespace libbitcoin::chain;
+using namespace libbitcoin::database;
+
+namespace {
+
+BC_CONSTEXPR size_t buckets = 100000;
+BC_CONSTEXPR size_t value_size = 64;
+
+// A standalone record or slab hash table over its own scratch file.
+template <typename Header, typename Manager, typename Table>
+struct table_fixture
+{
+    template <typename... Args>
+    table_fixture(const std::string& name, size_t header_size, Args... args)
+      : file(bench::make_directory(name) / "table"),
+        header(file, buckets),
+        manager(file, header_size, args...),
+        table(header, manager)
+    {
+        file.start();
+        file.resize(header_size + minimum_slabs_size);
+        header.create();
+        manager.create();
+        header.start();
+        manager.start();
+    }
+
+    memory_map file;
+    Header header;
+    Manager manager;
+    Table table;
+};
+
+typedef table_fixture<slab_hash_table_header, slab_manager,
+    slab_hash_table<hash_digest>> slab_fixture;
+
+typedef table_fixture<record_hash_table_header, record_manager,
+    record_hash_table<hash_digest>> record_fixture;
+
+const auto write_value = [](memory_ptr data)
+{
+    auto serial = make_serializer(REMAP_ADDRESS(data));
+    serial.write_data(data_chunk(value_size, 0x42));
+};
+
+} // namespace
+
+// Hash tables.
+// ----------------------------------------------------------------------------
+
+BENCHMARK_CASE(database, slab_hash_table_store)
+{
+    slab_fixture fixture("slab-store", slab_hash_table_header_size(buckets));
+
+    state.start();
+    for (size_t i = 0; i < state.iterations(); ++i)
+        fixture.table.store(bench::make_hash(i), write_value, value_size);
+    state.stop();
+}
+
+BENCHMARK_CASE(database, slab_hash_table_find)
+{
+    slab_fixture fixture("slab-find", slab_hash_table_header_size(buckets));
+    for (size_t i = 0; i < state.iterations(); ++i)
+        fixture.table.store(bench::make_hash(i), write_value, value_size);
+
+    size_t found = 0;
+    state.start();
+    for (size_t i = 0; i < state.iterations(); ++i)
+        found += fixture.table.find(bench::make_hash(i)) ? 1 : 0;
+    state.stop();
+
+    BITCOIN_ASSERT(found == state.iterations());
+}
+
+BENCHMARK_CASE(database, record_hash_table_store)
+{
+    record_fixture fixture("record-store",
+        record_hash_table_header_size(buckets),
+        hash_table_record_size<hash_digest>(value_size));
+
+    state.start();
+    for (size_t i = 0; i < state.iterations(); ++i)
+        fixture.table.store(bench::make_hash(i), write_value);
+    state.stop();
+}
+
+BENCHMARK_CASE(database, record_hash_table_find)
+{
+    record_fixture fixture("record-find",
+        record_hash_table_header_size(buckets),
+        hash_table_record_size<hash_digest>(value_size));
+    for (size_t i = 0; i < state.iterations(); ++i)
+        fixture.table.store(bench::make_hash(i), write_value);
+
+    size_t found = 0;
+    state.start();
+    for (size_t i = 0; i < state.iterations(); ++i)
+        found += fixture.table.find(bench::make_hash(i)) ? 1 : 0;
+    state.stop();
+
+    BITCOIN_ASSERT(found == state.iterations());
+}
+
+// Databases.
+// ----------------------------------------------------------------------------
+
+BENCHMARK_CASE(database, transaction_database_store)
+{
+    const auto directory = bench::make_directory("tx-store");
+    transaction_database transactions(directory / "tx_table");
+    transactions.create();
+
+    transaction::list txs;
+    for (size_t i = 0; i < state.iterations(); ++i)
+        txs.push_back(bench::make_transaction(i));
+
+    state.start();
+    for (size_t i = 0; i < txs.size(); ++i)
+        transactions.store(i, 0, txs[i]);
+    transactions.sync();
+    state.stop();
+}
+
+BENCHMARK_CASE(database, transaction_database_get)
+{
+    const auto directory = bench::make_directory("tx-get");
+    transaction_database transactions(directory / "tx_table");
+    transactions.create();
+
+    std::vector<hash_digest> hashes;
+    for (size_t i = 0; i < state.iterations(); ++i)
+    {
+        const auto tx = bench::make_transaction(i);
+        transactions.store(i, 0, tx);
+        hashes.push_back(tx.hash());
+    }
+
+    size_t found = 0;
+    state.start();
+    for (const auto& hash: hashes)
+    {
+        const auto result = transactions.get(hash);
+        found += result && result.transaction().is_valid() ? 1 : 0;
+    }
+    state.stop();
+
+    BITCOIN_ASSERT(found == hashes.size());
+}
+
+BENCHMARK_CASE(database, history_database_get)
+{
+    // Each address carries a realistic wallet-sized history.
+    static const size_t rows_per_address = 100;
+
+    const auto directory = bench::make_directory("history-get");
+    history_database history(directory / "history_table",
+        directory / "history_rows");
+    history.create();
+
+    const auto addresses = std::max<size_t>(1,
+        state.iterations() / rows_per_address);
+    for (size_t address = 0; address < addresses; ++address)
+        for (size_t row = 0; row < rows_per_address; ++row)
+            history.add_output(bench::make_short_hash(address),
+                { bench::make_hash(row), 0 }, static_cast<uint32_t>(row),
+                row);
+    history.sync();
+
+    size_t rows = 0;
+    state.start();
+    for (size_t address = 0; address < addresses; ++address)
+        rows += history.get(bench::make_short_hash(address), 0, 0).size();
+    state.stop();
+
+    state.set_items(rows);
+}
@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "fixtures.hpp"
+
+namespace bench {
+
+using namespace libbitcoin;
+using namespace libbitcoin::chain;
+
+hash_digest make_hash(uint64_t seed)
+{
+    return sha256_hash(to_chunk(to_little_endian(seed)));
+}
+
+short_hash make_short_hash(uint64_t seed)
+{
+    return ripemd160_hash(to_chunk(to_little_endian(seed)));
+}
+
+transaction make_transaction(uint64_t seed, size_t inputs, size_t outputs)
+{
+    transaction tx;
+    tx.version = 1;
+    tx.locktime = 0;
+
+    for (size_t index = 0; index < inputs; ++index)
+    {
+        input in;
+        in.previous_output = output_point(make_hash(seed + index),
+            static_cast<uint32_t>(index));
+        in.script.operations.push_back({ opcode::special,
+            data_chunk(72, static_cast<uint8_t>(seed)) });
+        in.script.operations.push_back({ opcode::special,
+            data_chunk(33, static_cast<uint8_t>(index)) });
+        in.sequence = max_input_sequence;
+        tx.inputs.push_back(in);
+    }
+
+    for (size_t index = 0; index < outputs; ++index)
+    {
+        output out;
+        out.value = seed + index;
+        out.script.operations = operation::to_pay_key_hash_pattern(
+            make_short_hash(seed + index));
+        tx.outputs.push_back(out);
+    }
+
+    return tx;
+}
+
+signed_spend make_signed_spend(uint64_t seed)
+{
+    const auto secret = make_hash(seed);
+    ec_compressed point;
+    secret_to_public(point, secret);
+
+    signed_spend spend;
+    spend.prevout_script.operations = operation::to_pay_key_hash_pattern(
+        bitcoin_short_hash(point));
+
+    spend.tx = make_transaction(seed, 1, 1);
+    endorsement signature;
+    script::create_endorsement(signature, secret, spend.prevout_script,
+        spend.tx, 0, signature_hash_algorithm::all);
+
+    auto& operations = spend.tx.inputs[0].script.operations;
+    operations.clear();
+    operations.push_back({ opcode::special, signature });
+    operations.push_back({ opcode::special, to_chunk(point) });
+    return spend;
+}
+
+boost::filesystem::path make_directory(const std::string& name)
+{
+    const auto directory = boost::filesystem::temp_directory_path() /
+        ("mvs-bench-" + name);
+    boost::filesystem::remove_all(directory);
+    boost::filesystem::create_directories(directory);
+    return directory;
+}
+
+} // namespace bench
@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MVS_TEST_BENCH_FIXTURES_HPP
+#define MVS_TEST_BENCH_FIXTURES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <boost/filesystem.hpp>
+#include <metaverse/bitcoin.hpp>
+
+namespace bench {
+
+/// Deterministic pseudo-random hash for a seed.
+libbitcoin::hash_digest make_hash(uint64_t seed);
+
+/// Deterministic pseudo-random short hash for a seed.
+libbitcoin::short_hash make_short_hash(uint64_t seed);
+
+/// A pay-to-key-hash transaction with the given shape.
+libbitcoin::chain::transaction make_transaction(uint64_t seed,
+    size_t inputs=2, size_t outputs=2);
+
+/// A signed spend of a pay-to-key-hash output and the spent script.
+struct signed_spend
+{
+    libbitcoin::chain::transaction tx;
+    libbitcoin::chain::script prevout_script;
+};
+
+signed_spend make_signed_spend(uint64_t seed);
+
+/// An empty scratch directory, recreated on each call.
+boost::filesystem::path make_directory(const std::string& name);
+
+} // namespace bench
+
+#endif
@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "bench.hpp"
+
+// Runs the registered benchmarks and prints one result per line, as json
+// (default) or csv, so that runs can be collected and compared over time.
+//
+//   bench [--filter=<substring>] [--iterations=<count>] [--format=json|csv]
+
+namespace bench {
+
+std::vector<benchmark>& registry()
+{
+    static std::vector<benchmark> benchmarks;
+    return benchmarks;
+}
+
+} // namespace bench
+
+namespace {
+
+bool starts_with(const std::string& value, const std::string& prefix)
+{
+    return value.compare(0, prefix.size(), prefix) == 0;
+}
+
+void report(const std::string& format, const std::string& name,
+    const bench::state& state)
+{
+    const auto nanoseconds = std::chrono::duration_cast<
+        std::chrono::nanoseconds>(state.elapsed()).count();
+    const auto items = state.items() == 0 ? 1 : state.items();
+    const auto per_item = static_cast<double>(nanoseconds) / items;
+    const auto per_second = nanoseconds == 0 ? 0.0 :
+        items * 1e9 / static_cast<double>(nanoseconds);
+
+    if (format == "csv")
+    {
+        std::cout << name << "," << state.iterations() << "," << items << ","
+            << nanoseconds << "," << per_item << "," << per_second
+            << std::endl;
+        return;
+    }
+
+    std::cout << "{\"name\":\"" << name << "\""
+        << ",\"iterations\":" << state.iterations()
+        << ",\"items\":" << items
+        << ",\"total_ns\":" << nanoseconds
+        << ",\"ns_per_item\":" << per_item
+        << ",\"items_per_second\":" << per_second
+        << "}" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::string filter;
+    std::string format = "json";
+    size_t iterations = 10000;
+
+    for (auto i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        if (starts_with(arg, "--filter="))
+            filter = arg.substr(9);
+        else if (starts_with(arg, "--iterations="))
+            iterations = std::strtoull(arg.substr(13).c_str(), nullptr, 10);
+        else if (starts_with(arg, "--format="))
+            format = arg.substr(9);
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--filter=<substring>]"
+                " [--iterations=<count>] [--format=json|csv]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (iterations == 0 || (format != "json" && format != "csv"))
+    {
+        std::cerr << "invalid iterations or format" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (format == "csv")
+        std::cout << "name,iterations,items,total_ns,ns_per_item,"
+            "items_per_second" << std::endl;
+
+    for (const auto& benchmark: bench::registry())
+    {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos)
+            continue;
+
+        bench::state state(iterations);
+        benchmark.run(state);
+        report(format, benchmark.name, state);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <metaverse/bitcoin.hpp>
+#include <metaverse/blockchain/block_detail.hpp>
+#include <metaverse/blockchain/orphan_pool.hpp>
+
+using namespace bc;
+using namespace bc::blockchain;
+
+// Distinct headers give distinct hashes, the body is irrelevant to the pool.
+static block_detail::ptr make_orphan(const hash_digest& parent,
+    uint32_t number, uint64_t bits=1)
+{
+    chain::block block;
+    block.header.version = chain::block_version_pow;
+    block.header.previous_block_hash = parent;
+    block.header.merkle = null_hash;
+    block.header.timestamp = number;
+    block.header.bits = bits;
+    block.header.number = number;
+    return std::make_shared<block_detail>(std::move(block));
+}
+
+static bool contains(const orphan_pool& pool, block_detail::ptr block)
+{
+    const auto message = std::make_shared<message::get_data>(
+        hash_list{ block->hash() }, message::inventory::type_id::block);
+    pool.filter(message);
+    return message->inventories.empty();
+}
+
+BOOST_AUTO_TEST_SUITE(orphan_pool_tests)
+
+BOOST_AUTO_TEST_CASE(orphan_pool__add__duplicate__false)
+{
+    orphan_pool pool(4);
+    const auto block = make_orphan(null_hash, 1);
+    BOOST_REQUIRE(pool.add(block));
+    BOOST_REQUIRE(!pool.add(block));
+
+    // A distinct instance of the same block is also a duplicate.
+    BOOST_REQUIRE(!pool.add(make_orphan(null_hash, 1)));
+    BOOST_REQUIRE_EQUAL(pool.unprocessed().size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(orphan_pool__add__at_capacity__evicts_oldest)
+{
+    orphan_pool pool(3);
+    const auto first = make_orphan(null_hash, 1);
+    const auto second = make_orphan(null_hash, 2);
+    const auto third = make_orphan(null_hash, 3);
+    const auto fourth = make_orphan(null_hash, 4);
+
+    BOOST_REQUIRE(pool.add(first));
+    BOOST_REQUIRE(pool.add(second));
+    BOOST_REQUIRE(pool.add(third));
+    BOOST_REQUIRE(pool.add(fourth));
+
+    BOOST_REQUIRE_EQUAL(pool.unprocessed().size(), 3u);
+    BOOST_REQUIRE(!contains(pool, first));
+    BOOST_REQUIRE(contains(pool, second));
+    BOOST_REQUIRE(contains(pool, third));
+    BOOST_REQUIRE(contains(pool, fourth));
+}
+
+BOOST_AUTO_TEST_CASE(orphan_pool__add__at_capacity__keeps_parents)
+{
+    orphan_pool pool(3);
+    const auto parent = make_orphan(null_hash, 1);
+    const auto child = make_orphan(parent->hash(), 2);
+    const auto other = make_orphan(null_hash, 3);
+
+    BOOST_REQUIRE(pool.add(parent));
+    BOOST_REQUIRE(pool.add(child));
+    BOOST_REQUIRE(pool.add(other));
+    BOOST_REQUIRE(pool.add(make_orphan(null_hash, 4)));
+
+    // The oldest block has a child, so the oldest leaf goes instead.
+    BOOST_REQUIRE(contains(pool, parent));
+    BOOST_REQUIRE(!contains(pool, child));
+    BOOST_REQUIRE(contains(pool, other));
+}
+
+BOOST_AUTO_TEST_CASE(orphan_pool__add__at_capacity__evicts_least_work_leaf)
+{
+    orphan_pool pool(3);
+    const auto first = make_orphan(null_hash, 1, 10);
+    const auto light = make_orphan(null_hash, 2, 5);
+    const auto third = make_orphan(null_hash, 3, 10);
+
+    BOOST_REQUIRE(pool.add(first));
+    BOOST_REQUIRE(pool.add(light));
+    BOOST_REQUIRE(pool.add(third));
+    BOOST_REQUIRE(pool.add(make_orphan(null_hash, 4, 10)));
+
+    BOOST_REQUIRE(contains(pool, first));
+    BOOST_REQUIRE(!contains(pool, light));
+    BOOST_REQUIRE(contains(pool, third));
+}
+
+BOOST_AUTO_TEST_CASE(orphan_pool__remove__other_instance__ignored)
+{
+    orphan_pool pool(4);
+    const auto block = make_orphan(null_hash, 1);
+    BOOST_REQUIRE(pool.add(block));
+
+    pool.remove(make_orphan(null_hash, 1));
+    BOOST_REQUIRE(contains(pool, block));
+
+    pool.remove(block);
+    BOOST_REQUIRE(!contains(pool, block));
+    BOOST_REQUIRE(pool.unprocessed().empty());
+}
+
+BOOST_AUTO_TEST_CASE(orphan_pool__trace__chain__ordered_from_root)
+{
+    orphan_pool pool(8);
+    const auto first = make_orphan(hash_literal(
+        "0000000000000000000000000000000000000000000000000000000000000001"), 1);
+    const auto second = make_orphan(first->hash(), 2);
+    const auto third = make_orphan(second->hash(), 3);
+    const auto fork = make_orphan(first->hash(), 4);
+
+    BOOST_REQUIRE(pool.add(third));
+    BOOST_REQUIRE(pool.add(fork));
+    BOOST_REQUIRE(pool.add(first));
+    BOOST_REQUIRE(pool.add(second));
+
+    const auto trace = pool.trace(third);
+    BOOST_REQUIRE_EQUAL(trace.size(), 3u);
+    BOOST_REQUIRE(trace[0] == first);
+    BOOST_REQUIRE(trace[1] == second);
+    BOOST_REQUIRE(trace[2] == third);
+
+    const auto fork_trace = pool.trace(fork);
+    BOOST_REQUIRE_EQUAL(fork_trace.size(), 2u);
+    BOOST_REQUIRE(fork_trace[0] == first);
+    BOOST_REQUIRE(fork_trace[1] == fork);
+}
+
+BOOST_AUTO_TEST_CASE(orphan_pool__trace__parent_not_pooled__end_only)
+{
+    orphan_pool pool(4);
+    const auto block = make_orphan(null_hash, 1);
+    BOOST_REQUIRE(pool.add(block));
+
+    const auto trace = pool.trace(block);
+    BOOST_REQUIRE_EQUAL(trace.size(), 1u);
+    BOOST_REQUIRE(trace[0] == block);
+}
+
+BOOST_AUTO_TEST_CASE(orphan_pool__unprocessed__newest_first_skips_processed)
+{
+    orphan_pool pool(4);
+    const auto first = make_orphan(null_hash, 1);
+    const auto second = make_orphan(null_hash, 2);
+    const auto third = make_orphan(null_hash, 3);
+
+    BOOST_REQUIRE(pool.add(first));
+    BOOST_REQUIRE(pool.add(second));
+    BOOST_REQUIRE(pool.add(third));
+    second->set_processed();
+
+    const auto unprocessed = pool.unprocessed();
+    BOOST_REQUIRE_EQUAL(unprocessed.size(), 2u);
+    BOOST_REQUIRE(unprocessed[0] == third);
+    BOOST_REQUIRE(unprocessed[1] == first);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,186 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <boost/filesystem.hpp>
+#include <metaverse/bitcoin.hpp>
+#include <metaverse/database/data_base.hpp>
+#include <metaverse/database/databases/stealth_database.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+using namespace bc::database;
+using namespace boost::filesystem;
+
+#define STEALTH_TEST_FILE "stealth_database_test_rows"
+
+// The transaction hash carries the height and a tag to identify rows.
+static stealth_compact make_row(uint32_t height, uint8_t tag)
+{
+    stealth_compact row;
+    row.ephemeral_public_key_hash = null_hash;
+    row.public_key_hash = null_short_hash;
+    row.transaction_hash = null_hash;
+    row.transaction_hash[0] = tag;
+    row.transaction_hash[1] = static_cast<uint8_t>(height);
+    return row;
+}
+
+static uint8_t tag_of(const stealth_compact& row)
+{
+    return row.transaction_hash[0];
+}
+
+static path create_rows_file()
+{
+    const path file(STEALTH_TEST_FILE);
+    remove(file);
+    BOOST_REQUIRE(data_base::touch_file(file));
+    return file;
+}
+
+// Rows across three partitions (0x12, 0x1f and 0xa5 leading bytes).
+static void store_rows(stealth_database& rows)
+{
+    rows.store(0x00000012, 1, make_row(1, 1));
+    rows.store(0x000000a5, 1, make_row(1, 2));
+    rows.store(0x00000012, 2, make_row(2, 3));
+    rows.store(0x0000001f, 2, make_row(2, 4));
+    rows.store(0x000000a5, 3, make_row(3, 5));
+    rows.store(0x00003412, 3, make_row(3, 6));
+}
+
+BOOST_AUTO_TEST_SUITE(stealth_database_tests)
+
+BOOST_AUTO_TEST_CASE(stealth_database__scan__empty_filter__all_rows_by_height)
+{
+    stealth_database rows(create_rows_file());
+    BOOST_REQUIRE(rows.create());
+    store_rows(rows);
+
+    const auto result = rows.scan(binary(), 0);
+    BOOST_REQUIRE_EQUAL(result.size(), 6u);
+    for (size_t index = 1; index < result.size(); ++index)
+        BOOST_REQUIRE_LE(result[index - 1].transaction_hash[1],
+            result[index].transaction_hash[1]);
+}
+
+BOOST_AUTO_TEST_CASE(stealth_database__scan__byte_prefix__one_partition)
+{
+    stealth_database rows(create_rows_file());
+    BOOST_REQUIRE(rows.create());
+    store_rows(rows);
+
+    const auto result = rows.scan(binary(8, data_chunk{ 0x12 }), 0);
+    BOOST_REQUIRE_EQUAL(result.size(), 3u);
+    BOOST_REQUIRE_EQUAL(tag_of(result[0]), 1u);
+    BOOST_REQUIRE_EQUAL(tag_of(result[1]), 3u);
+    BOOST_REQUIRE_EQUAL(tag_of(result[2]), 6u);
+
+    // Filter bits beyond the first byte are matched within the partition.
+    const auto longer = rows.scan(binary(16, data_chunk{ 0x12, 0x34 }), 0);
+    BOOST_REQUIRE_EQUAL(longer.size(), 1u);
+    BOOST_REQUIRE_EQUAL(tag_of(longer[0]), 6u);
+}
+
+BOOST_AUTO_TEST_CASE(stealth_database__scan__short_prefix__partition_range)
+{
+    stealth_database rows(create_rows_file());
+    BOOST_REQUIRE(rows.create());
+    store_rows(rows);
+
+    // Four bits (0001) span partitions 0x10 through 0x1f.
+    const auto result = rows.scan(binary(4, data_chunk{ 0x10 }), 0);
+    BOOST_REQUIRE_EQUAL(result.size(), 4u);
+    BOOST_REQUIRE_EQUAL(tag_of(result[0]), 1u);
+    BOOST_REQUIRE_EQUAL(tag_of(result[1]), 3u);
+    BOOST_REQUIRE_EQUAL(tag_of(result[2]), 4u);
+    BOOST_REQUIRE_EQUAL(tag_of(result[3]), 6u);
+
+    BOOST_REQUIRE(rows.scan(binary(8, data_chunk{ 0x77 }), 0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(stealth_database__scan__from_height__excludes_lower)
+{
+    stealth_database rows(create_rows_file());
+    BOOST_REQUIRE(rows.create());
+    store_rows(rows);
+
+    const auto result = rows.scan(binary(8, data_chunk{ 0xa5 }), 2);
+    BOOST_REQUIRE_EQUAL(result.size(), 1u);
+    BOOST_REQUIRE_EQUAL(tag_of(result[0]), 5u);
+    BOOST_REQUIRE(rows.scan(binary(), 4).empty());
+}
+
+BOOST_AUTO_TEST_CASE(stealth_database__unlink__block_pop__rows_and_index_truncated)
+{
+    stealth_database rows(create_rows_file());
+    BOOST_REQUIRE(rows.create());
+    store_rows(rows);
+
+    // Pop the blocks at heights 2 and 3.
+    rows.unlink(2);
+    const auto remaining = rows.scan(binary(), 0);
+    BOOST_REQUIRE_EQUAL(remaining.size(), 2u);
+    BOOST_REQUIRE_EQUAL(tag_of(remaining[0]), 1u);
+    BOOST_REQUIRE_EQUAL(tag_of(remaining[1]), 2u);
+
+    // Rows of the replacement block reuse the truncated storage.
+    rows.store(0x00000012, 2, make_row(2, 7));
+    const auto replaced = rows.scan(binary(8, data_chunk{ 0x12 }), 0);
+    BOOST_REQUIRE_EQUAL(replaced.size(), 2u);
+    BOOST_REQUIRE_EQUAL(tag_of(replaced[0]), 1u);
+    BOOST_REQUIRE_EQUAL(tag_of(replaced[1]), 7u);
+    BOOST_REQUIRE(rows.scan(binary(8, data_chunk{ 0x1f }), 0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(stealth_database__unlink__above_top__unchanged)
+{
+    stealth_database rows(create_rows_file());
+    BOOST_REQUIRE(rows.create());
+    store_rows(rows);
+
+    rows.unlink(4);
+    BOOST_REQUIRE_EQUAL(rows.scan(binary(), 0).size(), 6u);
+}
+
+BOOST_AUTO_TEST_CASE(stealth_database__start__existing_rows__index_rebuilt)
+{
+    const auto file = create_rows_file();
+
+    {
+        stealth_database rows(file);
+        BOOST_REQUIRE(rows.create());
+        store_rows(rows);
+        rows.sync();
+        BOOST_REQUIRE(rows.stop());
+    }
+
+    stealth_database rows(file);
+    BOOST_REQUIRE(rows.start());
+    const auto result = rows.scan(binary(8, data_chunk{ 0xa5 }), 0);
+    BOOST_REQUIRE_EQUAL(result.size(), 2u);
+    BOOST_REQUIRE_EQUAL(tag_of(result[0]), 2u);
+    BOOST_REQUIRE_EQUAL(tag_of(result[1]), 5u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
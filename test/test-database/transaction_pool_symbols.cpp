@@ -0,0 +1,223 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <string>
+#include <metaverse/bitcoin.hpp>
+#include <metaverse/blockchain/transaction_pool_symbols.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+using namespace bc::blockchain;
+
+static output issue_output(const std::string& symbol)
+{
+    asset_detail detail;
+    detail.set_symbol(symbol);
+
+    output out;
+    out.value = 0;
+    out.attach_data = attachment(ASSET_TYPE, ATTACH_INIT_VERSION,
+        asset(ASSET_DETAIL_TYPE, detail));
+    return out;
+}
+
+static output cert_output(const std::string& symbol, asset_cert_type type)
+{
+    output out;
+    out.value = 0;
+    out.attach_data = attachment(ASSET_CERT_TYPE, ATTACH_INIT_VERSION,
+        asset_cert(symbol, "owner", "address", type));
+    return out;
+}
+
+static output did_output(const std::string& symbol, const std::string& address)
+{
+    output out;
+    out.value = 0;
+    out.attach_data = attachment(DID_TYPE, ATTACH_INIT_VERSION,
+        did(DID_DETAIL_TYPE, did_detail(symbol, address)));
+    return out;
+}
+
+// An etp output sent from one did to another.
+static output attached_output(const std::string& from_did,
+    const std::string& to_did)
+{
+    output out;
+    out.value = 1;
+    out.attach_data = attachment(from_did, to_did);
+    out.attach_data.set_type(ETP_TYPE);
+    return out;
+}
+
+// The locktime keeps the hashes of transactions with equal outputs apart.
+static transaction make_tx(uint32_t seed, const output::list& outputs)
+{
+    transaction tx;
+    tx.version = 1;
+    tx.locktime = seed;
+    tx.outputs = outputs;
+    return tx;
+}
+
+BOOST_AUTO_TEST_SUITE(transaction_pool_symbols_tests)
+
+BOOST_AUTO_TEST_CASE(transaction_pool_symbols__check__empty__success)
+{
+    transaction_pool_symbols symbols;
+    const auto tx = make_tx(1, { issue_output("ALPHA"), did_output("alice", "a1") });
+    BOOST_REQUIRE_EQUAL(symbols.check(tx).value(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_pool_symbols__check__pooled_asset__asset_exist)
+{
+    transaction_pool_symbols symbols;
+    symbols.add(make_tx(1, { issue_output("ALPHA") }));
+
+    const auto repeat = make_tx(2, { issue_output("ALPHA") });
+    const auto other = make_tx(3, { issue_output("BETA") });
+    BOOST_REQUIRE_EQUAL(symbols.check(repeat).value(), error::asset_exist);
+    BOOST_REQUIRE_EQUAL(symbols.check(other).value(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_pool_symbols__check__repeat_within_tx__asset_exist)
+{
+    transaction_pool_symbols symbols;
+    const auto tx = make_tx(1, { issue_output("ALPHA"), issue_output("ALPHA") });
+    BOOST_REQUIRE_EQUAL(symbols.check(tx).value(), error::asset_exist);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_pool_symbols__check__pooled_cert__same_type_only)
+{
+    transaction_pool_symbols symbols;
+    symbols.add(make_tx(1, { cert_output("ALPHA", asset_cert_ns::issue) }));
+
+    const auto same = make_tx(2, { cert_output("ALPHA", asset_cert_ns::issue) });
+    const auto other = make_tx(3, { cert_output("ALPHA", asset_cert_ns::domain) });
+    BOOST_REQUIRE_EQUAL(symbols.check(same).value(), error::asset_cert_exist);
+    BOOST_REQUIRE_EQUAL(symbols.check(other).value(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_pool_symbols__check__pooled_did__conflicts)
+{
+    transaction_pool_symbols symbols;
+    symbols.add(make_tx(1, { did_output("alice", "a1") }));
+
+    const auto same_did = make_tx(2, { did_output("alice", "a2") });
+    const auto same_address = make_tx(3, { did_output("bob", "a1") });
+    const auto attached = make_tx(4, { attached_output("", "alice") });
+    BOOST_REQUIRE_EQUAL(symbols.check(same_did).value(), error::did_exist);
+    BOOST_REQUIRE_EQUAL(symbols.check(same_address).value(),
+        error::address_registered_did);
+    BOOST_REQUIRE_EQUAL(symbols.check(attached).value(), error::did_exist);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_pool_symbols__check__pooled_attachment__did_exist)
+{
+    transaction_pool_symbols symbols;
+    symbols.add(make_tx(1, { attached_output("carol", "dave") }));
+
+    // A did cannot be registered while a pooled transfer refers to it.
+    const auto register_to = make_tx(2, { did_output("dave", "d1") });
+    const auto register_other = make_tx(3, { did_output("erin", "e1") });
+    BOOST_REQUIRE_EQUAL(symbols.check(register_to).value(), error::did_exist);
+    BOOST_REQUIRE_EQUAL(symbols.check(register_other).value(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_pool_symbols__remove__expired__released)
+{
+    transaction_pool_symbols symbols;
+    const auto pooled = make_tx(1, { issue_output("ALPHA"),
+        did_output("alice", "a1"), attached_output("carol", "") });
+    symbols.add(pooled);
+
+    // The pool deindexes a transaction as it expires or is confirmed.
+    symbols.remove(pooled);
+    const auto tx = make_tx(2, { issue_output("ALPHA"),
+        did_output("alice", "a1"), did_output("carol", "c1") });
+    BOOST_REQUIRE_EQUAL(symbols.check(tx).value(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_pool_symbols__remove__other_tx_same_symbol__still_indexed)
+{
+    transaction_pool_symbols symbols;
+    const auto first = make_tx(1, { issue_output("ALPHA") });
+    const auto second = make_tx(2, { issue_output("ALPHA") });
+    symbols.add(first);
+    symbols.add(second);
+
+    symbols.remove(first);
+    BOOST_REQUIRE_EQUAL(symbols.check(make_tx(3, { issue_output("ALPHA") })).value(),
+        error::asset_exist);
+
+    // Removing a transaction that was never indexed changes nothing.
+    symbols.remove(make_tx(4, { issue_output("ALPHA") }));
+    BOOST_REQUIRE_EQUAL(symbols.check(make_tx(3, { issue_output("ALPHA") })).value(),
+        error::asset_exist);
+
+    symbols.remove(second);
+    BOOST_REQUIRE_EQUAL(symbols.check(make_tx(3, { issue_output("ALPHA") })).value(),
+        error::success);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_pool_symbols__clear__reorg__all_released)
+{
+    transaction_pool_symbols symbols;
+    symbols.add(make_tx(1, { issue_output("ALPHA") }));
+    symbols.add(make_tx(2, { cert_output("BETA", asset_cert_ns::issue) }));
+    symbols.add(make_tx(3, { did_output("alice", "a1") }));
+
+    // The pool is emptied on reorganization and the index with it.
+    symbols.clear();
+    const auto tx = make_tx(4, { issue_output("ALPHA"),
+        cert_output("BETA", asset_cert_ns::issue), did_output("alice", "a1") });
+    BOOST_REQUIRE_EQUAL(symbols.check(tx).value(), error::success);
+
+    // Transactions resubmitted after the reorganization are indexed again.
+    symbols.add(tx);
+    BOOST_REQUIRE_EQUAL(symbols.check(make_tx(5, { did_output("bob", "a1") })).value(),
+        error::address_registered_did);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_pool_symbols__overwrite_oldest__index_follows)
+{
+    transaction_pool_symbols symbols;
+    const auto oldest = make_tx(1, { issue_output("ALPHA") });
+    const auto newer = make_tx(2, { issue_output("BETA") });
+    symbols.add(oldest);
+    symbols.add(newer);
+
+    // A full pool replaces its oldest entry, as the buffer does on add.
+    const auto incoming = make_tx(3, { issue_output("GAMMA") });
+    symbols.remove(oldest);
+    symbols.add(incoming);
+
+    BOOST_REQUIRE_EQUAL(symbols.check(make_tx(4, { issue_output("ALPHA") })).value(),
+        error::success);
+    BOOST_REQUIRE_EQUAL(symbols.check(make_tx(5, { issue_output("BETA") })).value(),
+        error::asset_exist);
+    BOOST_REQUIRE_EQUAL(symbols.check(make_tx(6, { issue_output("GAMMA") })).value(),
+        error::asset_exist);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2016-2021 mvs developers
+ *
+ * This file is part of metaverse-explorer.
+ *
+ * metaverse-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <algorithm>
+#include <metaverse/explorer/extensions/coin_selection.hpp>
+
+using namespace bc::explorer::commands;
+
+// Candidate indexes are offset so they cannot be confused with positions.
+static coin_candidate::list make_candidates(
+    const std::vector<uint64_t>& amounts)
+{
+    coin_candidate::list candidates;
+    for (size_t position = 0; position < amounts.size(); ++position)
+        candidates.push_back({ amounts[position], position + 1, position + 100 });
+
+    return candidates;
+}
+
+static uint64_t total(const coin_candidate::list& candidates,
+    const coin_selector::indexes& selected)
+{
+    uint64_t sum = 0;
+    for (const auto index: selected)
+        sum += candidates[index - 100].amount;
+
+    return sum;
+}
+
+static coin_selector::indexes sorted(coin_selector::indexes selected)
+{
+    std::sort(selected.begin(), selected.end());
+    return selected;
+}
+
+BOOST_AUTO_TEST_SUITE(extensions)
+BOOST_AUTO_TEST_SUITE(extensions__coin_selector)
+
+BOOST_AUTO_TEST_CASE(coin_selector__branch_and_bound__exact_match__no_change)
+{
+    const auto candidates = make_candidates({ 50, 40, 30, 7, 3 });
+    const coin_selector selector(coin_selection::branch_and_bound);
+
+    // Largest first would take 50 + 40, the search finds 40 + 30.
+    const auto selected = selector.select(candidates, 70);
+    BOOST_REQUIRE_EQUAL(total(candidates, selected), 70u);
+    BOOST_REQUIRE(sorted(selected) == coin_selector::indexes({ 101, 102 }));
+}
+
+BOOST_AUTO_TEST_CASE(coin_selector__branch_and_bound__exact_match__fewest_inputs)
+{
+    const auto candidates = make_candidates({ 10, 6, 4, 3, 1 });
+    const coin_selector selector(coin_selection::branch_and_bound);
+
+    // Both 6 + 4 and 6 + 3 + 1 are exact, the shorter one wins.
+    const auto selected = selector.select(candidates, 10);
+    BOOST_REQUIRE(selected == coin_selector::indexes({ 100 }));
+}
+
+BOOST_AUTO_TEST_CASE(coin_selector__branch_and_bound__within_change_cost__accepted)
+{
+    const auto candidates = make_candidates({ 50, 33, 21 });
+    const coin_selector selector(coin_selection::branch_and_bound, 2);
+
+    const auto selected = selector.select(candidates, 52);
+    BOOST_REQUIRE_EQUAL(total(candidates, selected), 54u);
+    BOOST_REQUIRE(sorted(selected) == coin_selector::indexes({ 101, 102 }));
+}
+
+BOOST_AUTO_TEST_CASE(coin_selector__branch_and_bound__no_match__largest_first)
+{
+    const auto candidates = make_candidates({ 20, 50, 30 });
+    const coin_selector selector(coin_selection::branch_and_bound);
+    const coin_selector largest(coin_selection::largest_first);
+
+    // Every amount is a multiple of ten, so 45 cannot be matched exactly.
+    const auto selected = selector.select(candidates, 45);
+    BOOST_REQUIRE(selected == largest.select(candidates, 45));
+    BOOST_REQUIRE(selected == coin_selector::indexes({ 101 }));
+}
+
+BOOST_AUTO_TEST_CASE(coin_selector__branch_and_bound__duplicate_amounts__single_solution)
+{
+    const auto candidates = make_candidates({ 5, 5, 5, 5, 3 });
+    const coin_selector selector(coin_selection::branch_and_bound);
+
+    const auto pair = selector.select(candidates, 10);
+    BOOST_REQUIRE_EQUAL(pair.size(), 2u);
+    BOOST_REQUIRE_EQUAL(total(candidates, pair), 10u);
+
+    const auto mixed = selector.select(candidates, 13);
+    BOOST_REQUIRE_EQUAL(mixed.size(), 3u);
+    BOOST_REQUIRE_EQUAL(total(candidates, mixed), 13u);
+    BOOST_REQUIRE(std::find(mixed.begin(), mixed.end(), 104) != mixed.end());
+
+    // Selections never repeat a candidate.
+    const auto unique = sorted(mixed);
+    BOOST_REQUIRE(std::adjacent_find(unique.begin(), unique.end()) ==
+        unique.end());
+}
+
+BOOST_AUTO_TEST_CASE(coin_selector__branch_and_bound__try_limit__largest_first)
+{
+    // Forty distinct even amounts cannot match an odd target, the search
+    // space is far beyond the try limit and must give up.
+    std::vector<uint64_t> amounts;
+    for (uint64_t step = 0; step < 40; ++step)
+        amounts.push_back(1000000 + 2 * step * step);
+
+    const auto candidates = make_candidates(amounts);
+    const coin_selector selector(coin_selection::branch_and_bound);
+    const coin_selector largest(coin_selection::largest_first);
+
+    const uint64_t target = 20000001;
+    const auto selected = selector.select(candidates, target);
+    BOOST_REQUIRE(!selected.empty());
+    BOOST_REQUIRE(selected == largest.select(candidates, target));
+    BOOST_REQUIRE_GE(total(candidates, selected), target);
+}
+
+BOOST_AUTO_TEST_CASE(coin_selector__branch_and_bound__insufficient_balance__empty)
+{
+    const auto candidates = make_candidates({ 10, 20, 30 });
+    const coin_selector selector(coin_selection::branch_and_bound);
+
+    BOOST_REQUIRE(selector.select(candidates, 61).empty());
+    BOOST_REQUIRE(selector.select({}, 1).empty());
+}
+
+BOOST_AUTO_TEST_CASE(coin_selector__branch_and_bound__zero_amounts__ignored)
+{
+    const auto candidates = make_candidates({ 0, 7, 0, 3 });
+    const coin_selector selector(coin_selection::branch_and_bound);
+
+    const auto selected = selector.select(candidates, 10);
+    BOOST_REQUIRE(sorted(selected) == coin_selector::indexes({ 101, 103 }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,213 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <metaverse/bitcoin/utility/scheduler.hpp>
+
+using namespace bc;
+
+// Occupies the only thread of a scheduler until released.
+class blocker
+{
+public:
+    blocker(scheduler& pool)
+      : released_(release_.get_future().share())
+    {
+        auto started = std::make_shared<std::promise<void>>();
+        auto future = started->get_future();
+        auto released = released_;
+        pool.post([started, released]()
+        {
+            started->set_value();
+            released.wait();
+        });
+
+        future.wait();
+    }
+
+    void release()
+    {
+        release_.set_value();
+    }
+
+private:
+    std::promise<void> release_;
+    std::shared_future<void> released_;
+};
+
+BOOST_AUTO_TEST_SUITE(scheduler_tests)
+
+BOOST_AUTO_TEST_CASE(scheduler__post__stopped__false)
+{
+    scheduler pool(2);
+    pool.stop();
+
+    auto ran = false;
+    BOOST_REQUIRE(!pool.post([&ran]() { ran = true; }));
+    BOOST_REQUIRE(!ran);
+}
+
+BOOST_AUTO_TEST_CASE(scheduler__stop__queued_tasks__run)
+{
+    std::atomic<size_t> count(0);
+
+    {
+        scheduler pool(1);
+        blocker busy(pool);
+        for (size_t task = 0; task < 10; ++task)
+            BOOST_REQUIRE(pool.post([&count]() { ++count; }));
+
+        BOOST_REQUIRE_EQUAL(count.load(), 0u);
+        busy.release();
+        pool.stop();
+        BOOST_REQUIRE_EQUAL(pool.backlog(), 0u);
+    }
+
+    BOOST_REQUIRE_EQUAL(count.load(), 10u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(task_group_tests)
+
+BOOST_AUTO_TEST_CASE(task_group__wait__runs_only_own_tasks)
+{
+    scheduler pool(1);
+    blocker busy(pool);
+    const auto caller = std::this_thread::get_id();
+
+    // A task of another client of the scheduler, queued before the group.
+    std::atomic<bool> foreign(false);
+    pool.post([&foreign]() { foreign = true; });
+
+    std::mutex mutex;
+    std::vector<std::thread::id> runners;
+    task_group group(pool);
+    for (size_t task = 0; task < 4; ++task)
+        group.run([&mutex, &runners]()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            runners.push_back(std::this_thread::get_id());
+        });
+
+    // The only scheduler thread is busy, so the waiter runs the group.
+    group.wait();
+    BOOST_REQUIRE_EQUAL(runners.size(), 4u);
+    for (const auto& runner: runners)
+        BOOST_REQUIRE(runner == caller);
+
+    BOOST_REQUIRE(!foreign);
+    busy.release();
+    pool.stop();
+    BOOST_REQUIRE(foreign);
+}
+
+BOOST_AUTO_TEST_CASE(task_group__then__after_all_tasks)
+{
+    scheduler pool(4);
+    std::atomic<size_t> count(0);
+    std::promise<size_t> observed;
+
+    task_group group(pool);
+    for (size_t task = 0; task < 100; ++task)
+        group.run([&count]() { ++count; });
+
+    group.then([&count, &observed]() { observed.set_value(count.load()); });
+    BOOST_REQUIRE_EQUAL(observed.get_future().get(), 100u);
+    pool.stop();
+}
+
+BOOST_AUTO_TEST_CASE(task_group__then__no_tasks__posted_now)
+{
+    scheduler pool(1);
+    std::promise<void> followed;
+    task_group group(pool);
+    group.then([&followed]() { followed.set_value(); });
+    followed.get_future().wait();
+    pool.stop();
+}
+
+BOOST_AUTO_TEST_CASE(task_group__then__group_destroyed__still_posted)
+{
+    scheduler pool(1);
+    blocker busy(pool);
+    std::promise<void> followed;
+
+    {
+        task_group group(pool);
+        group.run([]() {});
+        group.then([&followed]() { followed.set_value(); });
+    }
+
+    busy.release();
+    followed.get_future().wait();
+    pool.stop();
+}
+
+BOOST_AUTO_TEST_CASE(task_group__wait__nested_group__completes)
+{
+    // With one thread the inner wait must run the inner tasks itself.
+    scheduler pool(1);
+    std::atomic<size_t> inner_count(0);
+    std::atomic<size_t> outer_count(0);
+
+    task_group outer(pool);
+    for (size_t task = 0; task < 3; ++task)
+        outer.run([&pool, &inner_count, &outer_count]()
+        {
+            task_group inner(pool);
+            for (size_t subtask = 0; subtask < 5; ++subtask)
+                inner.run([&inner_count]() { ++inner_count; });
+
+            inner.wait();
+            ++outer_count;
+        });
+
+    outer.wait();
+    BOOST_REQUIRE_EQUAL(outer_count.load(), 3u);
+    BOOST_REQUIRE_EQUAL(inner_count.load(), 15u);
+    pool.stop();
+}
+
+BOOST_AUTO_TEST_CASE(task_group__run__stopped__runs_on_caller)
+{
+    scheduler pool(2);
+    pool.stop();
+
+    const auto caller = std::this_thread::get_id();
+    std::thread::id runner;
+    task_group group(pool);
+    group.run([&runner]() { runner = std::this_thread::get_id(); });
+    BOOST_REQUIRE(runner == caller);
+
+    // Nothing remains, so wait returns and continuations run now.
+    group.wait();
+    auto followed = false;
+    group.then([&followed]() { followed = true; });
+    BOOST_REQUIRE(followed);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
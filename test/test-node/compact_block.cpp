@@ -0,0 +1,255 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <metaverse/bitcoin.hpp>
+#include <metaverse/node/utility/compact_block_builder.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+using namespace bc::message;
+using namespace bc::node;
+
+// The key of the siphash-2-4 reference vectors is the bytes 0x00..0x0f.
+static half_hash reference_key()
+{
+    half_hash key;
+    for (size_t index = 0; index < key.size(); ++index)
+        key[index] = static_cast<uint8_t>(index);
+
+    return key;
+}
+
+// The message of the vector of length n is the bytes 0x00..n-1.
+static data_chunk reference_message(size_t size)
+{
+    data_chunk message(size);
+    for (size_t index = 0; index < size; ++index)
+        message[index] = static_cast<uint8_t>(index);
+
+    return message;
+}
+
+static transaction make_transaction(uint32_t seed)
+{
+    transaction tx;
+    tx.version = 1;
+    tx.locktime = seed;
+
+    input in;
+    in.previous_output = point(bitcoin_hash(to_little_endian(seed)), seed);
+    in.sequence = max_input_sequence;
+    tx.inputs.push_back(in);
+
+    output out;
+    out.value = seed;
+    tx.outputs.push_back(out);
+    return tx;
+}
+
+// A proof of work block of a coinbase followed by count transactions.
+static block make_block(uint32_t count)
+{
+    transaction::list transactions;
+    transaction coinbase;
+    coinbase.version = 1;
+    coinbase.locktime = 0;
+
+    input in;
+    in.previous_output = point(null_hash, max_uint32);
+    in.sequence = max_input_sequence;
+    coinbase.inputs.push_back(in);
+
+    output out;
+    out.value = 300000000;
+    coinbase.outputs.push_back(out);
+    transactions.push_back(coinbase);
+
+    for (uint32_t seed = 1; seed <= count; ++seed)
+        transactions.push_back(make_transaction(seed));
+
+    header head;
+    head.version = block_version_pow;
+    head.previous_block_hash = null_hash;
+    head.merkle = block::generate_merkle_root(transactions);
+    head.timestamp = 1500000000;
+    head.number = 42;
+    head.transaction_count = transactions.size();
+    return block(head, transactions);
+}
+
+static compact_block_builder::transaction_ptr_list to_pool(
+    const block& full, size_t begin, size_t end)
+{
+    compact_block_builder::transaction_ptr_list pool;
+    for (auto index = begin; index < end; ++index)
+        pool.push_back(std::make_shared<transaction_message>(
+            full.transactions[index]));
+
+    return pool;
+}
+
+BOOST_AUTO_TEST_SUITE(siphash_tests)
+
+BOOST_AUTO_TEST_CASE(siphash__reference_vectors__expected)
+{
+    const auto key = reference_key();
+    BOOST_REQUIRE_EQUAL(siphash(key, reference_message(0)), 0x726fdb47dd0e0e31ull);
+    BOOST_REQUIRE_EQUAL(siphash(key, reference_message(1)), 0x74f839c593dc67fdull);
+    BOOST_REQUIRE_EQUAL(siphash(key, reference_message(7)), 0xab0200f58b01d137ull);
+    BOOST_REQUIRE_EQUAL(siphash(key, reference_message(8)), 0x93f5f5799a932462ull);
+    BOOST_REQUIRE_EQUAL(siphash(key, reference_message(15)), 0xa129ca6149be45e5ull);
+    BOOST_REQUIRE_EQUAL(siphash(key, reference_message(16)), 0x3f2acc7f57c29bdbull);
+    BOOST_REQUIRE_EQUAL(siphash(key, reference_message(63)), 0x958a324ceb064572ull);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(compact_block_tests)
+
+BOOST_AUTO_TEST_CASE(compact_block__to_short_id__vectors__expected)
+{
+    hash_digest tx_hash;
+    for (size_t index = 0; index < tx_hash.size(); ++index)
+        tx_hash[index] = static_cast<uint8_t>(index);
+
+    const auto forward = compact_block::to_short_id(reference_key(), tx_hash);
+    BOOST_REQUIRE_EQUAL(encode_base16(forward), "ce7cf2722f51");
+
+    half_hash reversed = reference_key();
+    std::reverse(reversed.begin(), reversed.end());
+    const auto backward = compact_block::to_short_id(reversed, tx_hash);
+    BOOST_REQUIRE_EQUAL(encode_base16(backward), "5e37c0ff9312");
+}
+
+BOOST_AUTO_TEST_CASE(compact_block__to_short_id__lower_six_bytes_of_siphash)
+{
+    const auto key = reference_key();
+    const auto tx_hash = bitcoin_hash(reference_message(32));
+    const auto id = compact_block::to_short_id(key, tx_hash);
+    const auto bytes = to_little_endian(siphash(key, tx_hash));
+    BOOST_REQUIRE(std::equal(id.begin(), id.end(), bytes.begin()));
+}
+
+BOOST_AUTO_TEST_CASE(compact_block__factory_from_block__prefills_coinbase)
+{
+    const auto full = make_block(3);
+    const auto compact = compact_block::factory_from_block(full, 7);
+    BOOST_REQUIRE_EQUAL(compact.transaction_count(), 4u);
+    BOOST_REQUIRE_EQUAL(compact.transactions.size(), 1u);
+    BOOST_REQUIRE_EQUAL(compact.transactions[0].index, 0u);
+    BOOST_REQUIRE_EQUAL(compact.short_ids.size(), 3u);
+
+    const auto key = compact.short_id_key();
+    for (size_t index = 0; index < compact.short_ids.size(); ++index)
+        BOOST_REQUIRE(compact.short_ids[index] == compact_block::to_short_id(
+            key, full.transactions[index + 1].hash()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(compact_block_builder_tests)
+
+BOOST_AUTO_TEST_CASE(compact_block_builder__populate__whole_pool__complete_block)
+{
+    const auto full = make_block(5);
+    compact_block_builder builder(compact_block::factory_from_block(full, 1));
+    BOOST_REQUIRE(builder.is_valid());
+    BOOST_REQUIRE(!builder.is_complete());
+    BOOST_REQUIRE_EQUAL(builder.missing().size(), 5u);
+
+    // The pool order is unrelated to the block order.
+    auto pool = to_pool(full, 1, full.transactions.size());
+    std::reverse(pool.begin(), pool.end());
+    pool.push_back(std::make_shared<transaction_message>(make_transaction(99)));
+    builder.populate(pool);
+    BOOST_REQUIRE(builder.is_complete());
+
+    const auto rebuilt = builder.to_block();
+    BOOST_REQUIRE(rebuilt);
+    BOOST_REQUIRE(rebuilt->header.hash() == full.header.hash());
+    BOOST_REQUIRE_EQUAL(rebuilt->transactions.size(), full.transactions.size());
+
+    for (size_t index = 0; index < full.transactions.size(); ++index)
+        BOOST_REQUIRE(rebuilt->transactions[index].hash() ==
+            full.transactions[index].hash());
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_builder__populate__partial_pool__requests_remainder)
+{
+    const auto full = make_block(5);
+    compact_block_builder builder(compact_block::factory_from_block(full, 2));
+    BOOST_REQUIRE(builder.is_valid());
+
+    // The pool holds transactions 1, 2 and 4 of the block.
+    auto pool = to_pool(full, 1, 3);
+    pool.push_back(std::make_shared<transaction_message>(full.transactions[4]));
+    builder.populate(pool);
+    BOOST_REQUIRE(!builder.is_complete());
+    BOOST_REQUIRE(!builder.to_block());
+
+    const auto missing = builder.missing();
+    BOOST_REQUIRE_EQUAL(missing.size(), 2u);
+    BOOST_REQUIRE_EQUAL(missing[0], 3u);
+    BOOST_REQUIRE_EQUAL(missing[1], 5u);
+
+    block_transactions response;
+    response.block_hash = builder.hash();
+    response.transactions.push_back(full.transactions[3]);
+    response.transactions.push_back(full.transactions[5]);
+    BOOST_REQUIRE(builder.populate(response));
+    BOOST_REQUIRE(builder.is_complete());
+
+    const auto rebuilt = builder.to_block();
+    BOOST_REQUIRE(rebuilt);
+    BOOST_REQUIRE(block::generate_merkle_root(rebuilt->transactions) ==
+        full.header.merkle);
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_builder__populate__response_count_mismatch__false)
+{
+    const auto full = make_block(2);
+    compact_block_builder builder(compact_block::factory_from_block(full, 3));
+
+    block_transactions response;
+    response.block_hash = builder.hash();
+    response.transactions.push_back(full.transactions[1]);
+    BOOST_REQUIRE(!builder.populate(response));
+    BOOST_REQUIRE_EQUAL(builder.missing().size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(compact_block_builder__to_block__wrong_transaction__nullptr)
+{
+    const auto full = make_block(2);
+    compact_block_builder builder(compact_block::factory_from_block(full, 4));
+
+    // A peer answering with other transactions fails the merkle check.
+    block_transactions response;
+    response.block_hash = builder.hash();
+    response.transactions.push_back(make_transaction(98));
+    response.transactions.push_back(make_transaction(99));
+    BOOST_REQUIRE(builder.populate(response));
+    BOOST_REQUIRE(builder.is_complete());
+    BOOST_REQUIRE(!builder.to_block());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
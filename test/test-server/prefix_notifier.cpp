@@ -0,0 +1,305 @@
+/**
+ * Copyright (c) 2011-2021 libbitcoin developers (see AUTHORS)
+ * Copyright (c) 2016-2021 metaverse core developers (see MVS-AUTHORS)
+ *
+ * This file is part of metaverse.
+ *
+ * metaverse is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <metaverse/bitcoin.hpp>
+#include <metaverse/server/messages/route.hpp>
+#include <metaverse/server/utility/prefix_notifier.hpp>
+
+using namespace bc;
+using namespace bc::server;
+
+typedef prefix_notifier<const code&, uint32_t> test_notifier;
+typedef std::vector<std::pair<code, uint32_t>> calls;
+
+static route make_route(uint8_t id)
+{
+    route reply_to;
+    reply_to.address1 = { id };
+    return reply_to;
+}
+
+// Record each notification, remaining subscribed unless told otherwise.
+static test_notifier::handler record(calls& out, bool remain=true)
+{
+    return [&out, remain](const code& ec, uint32_t value)
+    {
+        out.emplace_back(ec, value);
+        return remain;
+    };
+}
+
+static const auto long_time = asio::duration(std::chrono::hours(1));
+static const auto short_time = asio::duration(std::chrono::milliseconds(1));
+
+BOOST_AUTO_TEST_SUITE(prefix_notifier_tests)
+
+BOOST_AUTO_TEST_CASE(prefix_notifier__subscribe__stopped__invokes_stopped_args)
+{
+    threadpool pool(1);
+    calls result;
+    const auto subscriber = std::make_shared<test_notifier>(pool, 0, "test");
+
+    subscriber->subscribe(record(result), make_route(1), binary("1"),
+        long_time, error::service_stopped, 0);
+
+    BOOST_REQUIRE_EQUAL(result.size(), 1u);
+    BOOST_REQUIRE_EQUAL(result[0].first.value(), error::service_stopped);
+
+    // Nothing was retained to unsubscribe.
+    subscriber->start();
+    subscriber->unsubscribe(make_route(1), binary("1"), error::success, 0);
+    BOOST_REQUIRE_EQUAL(result.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(prefix_notifier__subscribe__limit_exceeded__invokes_stopped_args)
+{
+    threadpool pool(1);
+    calls first;
+    calls second;
+    const auto subscriber = std::make_shared<test_notifier>(pool, 1, "test");
+    subscriber->start();
+
+    subscriber->subscribe(record(first), make_route(1), binary("1"),
+        long_time, error::service_stopped, 0);
+    subscriber->subscribe(record(second), make_route(2), binary("1"),
+        long_time, error::service_stopped, 0);
+
+    BOOST_REQUIRE(first.empty());
+    BOOST_REQUIRE_EQUAL(second.size(), 1u);
+    BOOST_REQUIRE_EQUAL(second[0].first.value(), error::service_stopped);
+
+    subscriber->invoke(error::success, 0);
+    BOOST_REQUIRE_EQUAL(first.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(prefix_notifier__subscribe__existing_key__extends_expiration)
+{
+    threadpool pool(1);
+    calls first;
+    calls second;
+    const auto subscriber = std::make_shared<test_notifier>(pool, 1, "test");
+    subscriber->start();
+
+    // The second subscription is an extension, so is not over the limit.
+    subscriber->subscribe(record(first), make_route(1), binary("101"),
+        short_time, error::service_stopped, 0);
+    subscriber->subscribe(record(second), make_route(1), binary("101"),
+        long_time, error::service_stopped, 0);
+    BOOST_REQUIRE(second.empty());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    subscriber->purge(error::channel_timeout, 0);
+    BOOST_REQUIRE(first.empty());
+
+    // The original handler is retained.
+    subscriber->invoke(error::success, 0);
+    BOOST_REQUIRE_EQUAL(first.size(), 1u);
+    BOOST_REQUIRE(second.empty());
+}
+
+BOOST_AUTO_TEST_CASE(prefix_notifier__relay__prefixes__only_matching_invoked)
+{
+    threadpool pool(1);
+    calls short_match;
+    calls empty_match;
+    calls exact_match;
+    calls mismatch;
+    calls too_long;
+    calls other_route;
+    const auto subscriber = std::make_shared<test_notifier>(pool, 0, "test");
+    subscriber->start();
+
+    subscriber->subscribe(record(short_match), make_route(1), binary("101"),
+        long_time, error::service_stopped, 0);
+    subscriber->subscribe(record(empty_match), make_route(1), binary(""),
+        long_time, error::service_stopped, 0);
+    subscriber->subscribe(record(exact_match), make_route(1), binary("10110"),
+        long_time, error::service_stopped, 0);
+    subscriber->subscribe(record(mismatch), make_route(1), binary("11"),
+        long_time, error::service_stopped, 0);
+    subscriber->subscribe(record(too_long), make_route(1), binary("101101"),
+        long_time, error::service_stopped, 0);
+    subscriber->subscribe(record(other_route), make_route(2), binary("1"),
+        long_time, error::service_stopped, 0);
+
+    subscriber->relay(binary("10110"), error::success, 42);
+    pool.shutdown();
+    pool.join();
+
+    BOOST_REQUIRE_EQUAL(short_match.size(), 1u);
+    BOOST_REQUIRE_EQUAL(short_match[0].first.value(), error::success);
+    BOOST_REQUIRE_EQUAL(short_match[0].second, 42u);
+    BOOST_REQUIRE_EQUAL(empty_match.size(), 1u);
+    BOOST_REQUIRE_EQUAL(exact_match.size(), 1u);
+    BOOST_REQUIRE_EQUAL(other_route.size(), 1u);
+    BOOST_REQUIRE(mismatch.empty());
+    BOOST_REQUIRE(too_long.empty());
+
+    subscriber->invoke(error::success, 0);
+}
+
+BOOST_AUTO_TEST_CASE(prefix_notifier__relay__handler_returns_false__removed)
+{
+    threadpool pool(1);
+    calls once;
+    calls always;
+    const auto subscriber = std::make_shared<test_notifier>(pool, 0, "test");
+    subscriber->start();
+
+    subscriber->subscribe(record(once, false), make_route(1), binary("1"),
+        long_time, error::service_stopped, 0);
+    subscriber->subscribe(record(always), make_route(2), binary("1"),
+        long_time, error::service_stopped, 0);
+
+    subscriber->relay(binary("10"), error::success, 1);
+    subscriber->relay(binary("11"), error::success, 2);
+    pool.shutdown();
+    pool.join();
+
+    BOOST_REQUIRE_EQUAL(once.size(), 1u);
+    BOOST_REQUIRE_EQUAL(once[0].second, 1u);
+    BOOST_REQUIRE_EQUAL(always.size(), 2u);
+    BOOST_REQUIRE_EQUAL(always[1].second, 2u);
+
+    // The removed subscription is not notified of unsubscription.
+    subscriber->unsubscribe(make_route(1), binary("1"), error::success, 0);
+    BOOST_REQUIRE_EQUAL(once.size(), 1u);
+
+    subscriber->invoke(error::success, 0);
+}
+
+BOOST_AUTO_TEST_CASE(prefix_notifier__unsubscribe__subscribed__notified_and_removed)
+{
+    threadpool pool(1);
+    calls removed;
+    calls kept;
+    const auto subscriber = std::make_shared<test_notifier>(pool, 0, "test");
+    subscriber->start();
+
+    subscriber->subscribe(record(removed), make_route(1), binary("01"),
+        long_time, error::service_stopped, 0);
+    subscriber->subscribe(record(kept), make_route(1), binary("0"),
+        long_time, error::service_stopped, 0);
+
+    // Only the exact route and filter is removed.
+    subscriber->unsubscribe(make_route(1), binary("01"), error::channel_stopped, 7);
+    subscriber->unsubscribe(make_route(2), binary("0"), error::channel_stopped, 7);
+    BOOST_REQUIRE_EQUAL(removed.size(), 1u);
+    BOOST_REQUIRE_EQUAL(removed[0].first.value(), error::channel_stopped);
+    BOOST_REQUIRE_EQUAL(removed[0].second, 7u);
+    BOOST_REQUIRE(kept.empty());
+
+    subscriber->relay(binary("011"), error::success, 1);
+    pool.shutdown();
+    pool.join();
+
+    BOOST_REQUIRE_EQUAL(removed.size(), 1u);
+    BOOST_REQUIRE_EQUAL(kept.size(), 1u);
+
+    subscriber->invoke(error::success, 0);
+}
+
+BOOST_AUTO_TEST_CASE(prefix_notifier__unsubscribe__stopped__not_notified)
+{
+    threadpool pool(1);
+    calls result;
+    const auto subscriber = std::make_shared<test_notifier>(pool, 0, "test");
+    subscriber->start();
+
+    subscriber->subscribe(record(result), make_route(1), binary("1"),
+        long_time, error::service_stopped, 0);
+    subscriber->stop();
+    subscriber->unsubscribe(make_route(1), binary("1"), error::channel_stopped, 0);
+    BOOST_REQUIRE(result.empty());
+
+    subscriber->invoke(error::service_stopped, 0);
+    BOOST_REQUIRE_EQUAL(result.size(), 1u);
+    BOOST_REQUIRE_EQUAL(result[0].first.value(), error::service_stopped);
+}
+
+BOOST_AUTO_TEST_CASE(prefix_notifier__purge__expired__only_expired_notified)
+{
+    threadpool pool(1);
+    calls expired;
+    calls unexpired;
+    const auto subscriber = std::make_shared<test_notifier>(pool, 0, "test");
+    subscriber->start();
+
+    subscriber->subscribe(record(expired), make_route(1), binary("1"),
+        short_time, error::service_stopped, 0);
+    subscriber->subscribe(record(unexpired), make_route(2), binary("1"),
+        long_time, error::service_stopped, 0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    subscriber->purge(error::channel_timeout, 3);
+    BOOST_REQUIRE_EQUAL(expired.size(), 1u);
+    BOOST_REQUIRE_EQUAL(expired[0].first.value(), error::channel_timeout);
+    BOOST_REQUIRE_EQUAL(expired[0].second, 3u);
+    BOOST_REQUIRE(unexpired.empty());
+
+    // An expired subscription is purged once and no longer relayed.
+    subscriber->purge(error::channel_timeout, 3);
+    subscriber->relay(binary("1"), error::success, 1);
+    pool.shutdown();
+    pool.join();
+
+    BOOST_REQUIRE_EQUAL(expired.size(), 1u);
+    BOOST_REQUIRE_EQUAL(unexpired.size(), 1u);
+    BOOST_REQUIRE_EQUAL(unexpired[0].first.value(), error::success);
+
+    subscriber->invoke(error::success, 0);
+}
+
+BOOST_AUTO_TEST_CASE(prefix_notifier__invoke__subscribed__all_notified_and_removed)
+{
+    threadpool pool(1);
+    calls first;
+    calls second;
+    const auto subscriber = std::make_shared<test_notifier>(pool, 0, "test");
+    subscriber->start();
+
+    subscriber->subscribe(record(first), make_route(1), binary("0"),
+        long_time, error::service_stopped, 0);
+    subscriber->subscribe(record(second), make_route(2), binary("1"),
+        long_time, error::service_stopped, 0);
+
+    subscriber->invoke(error::service_stopped, 5);
+    BOOST_REQUIRE_EQUAL(first.size(), 1u);
+    BOOST_REQUIRE_EQUAL(second.size(), 1u);
+    BOOST_REQUIRE_EQUAL(second[0].second, 5u);
+
+    subscriber->relay(binary("0"), error::success, 1);
+    subscriber->relay(binary("1"), error::success, 1);
+    pool.shutdown();
+    pool.join();
+
+    BOOST_REQUIRE_EQUAL(first.size(), 1u);
+    BOOST_REQUIRE_EQUAL(second.size(), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()